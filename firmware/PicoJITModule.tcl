@@ -22,7 +22,7 @@ set LIST_LEN [llength $PR_NAME_LIST]
 for {set ii 0} {$ii < $LIST_LEN} {incr ii} \
 {
   set tmppr ACC_PR[lindex $PR_NAME_LIST $ii]
-  set prpath $path/$tmppr
+  set prpath $path/SLOT\[[expr [lindex $PR_NAME_LIST $ii] - 1]\].ACC_PR
   read_checkpoint -cell $prpath $ACC_NAME.dcp
 }
 
@@ -1,6 +1,11 @@
 set sysname [lindex $argv 0]
+set datawidth [lindex $argv 1]
 set tmpstr [exec pwd]
 open_project $tmpstr/$sysname/$sysname.xpr
+# 128 for the projects of m505lx325w128.fwproj, jit.v defaults to 32
+if {$datawidth ne ""} {
+  set_property verilog_define "JIT_DW=$datawidth" [current_fileset]
+}
 set proname [current_project]
 set vivado_archgen_path $tmpstr
 
@@ -70,11 +75,12 @@ set LIST_LEN [llength $PR_NAME_LIST]
 for {set ii 0} {$ii < $LIST_LEN} {incr ii} \
 {
   set tmppr ACC_PR[lindex $PR_NAME_LIST $ii]
-  set prpath $path/$tmppr
+  set prpath $path/SLOT\[[expr [lindex $PR_NAME_LIST $ii] - 1]\].ACC_PR
   set_property HD.RECONFIGURABLE 1 [get_cells $prpath]
 }
 
 # set offset {{0 0 0 0} {50 20 20 10} {200 80 80 40} {250 100 100 50} {300 120 120 60}}
+# pblocks of slots 1 - 8, a PR_NAME_LIST past 8 (jit.v NUM_ACCs up to 32) needs their offsets
 set offsetX {{50 2 2 2} {50  2  2  2} { 50  2  2  2} { 50   2   2  2} { 50   2   2  2} {80 3 3 3}  {80  3  3  3}  { 80  3  3  3}}
 set offsetY {{ 0 0 0 0} {50 20 20 10} {200 80 80 40} {250 100 100 50} {300 120 120 60} { 0 0 0 0}  {50 20 20 10}  {100 40 40 20}}
 set sW 27
@@ -89,7 +95,7 @@ set path UserWrapper/UserModule
 for {set ii 0} {$ii < $LIST_LEN} {incr ii} \
 {
   set tmppr ACC_PR[lindex $PR_NAME_LIST $ii]
-  set prpath $path/$tmppr
+  set prpath $path/SLOT\[[expr [lindex $PR_NAME_LIST $ii] - 1]\].ACC_PR
   set Stmpx   [expr 0 + [lindex $offsetX $ii 0]]
   set Stmpy   [expr 0 + [lindex $offsetY $ii 0]]
   set Dtmpx   [expr 0 + [lindex $offsetX $ii 1]]
@@ -144,7 +150,7 @@ set LIST_LEN [llength $PR_NAME_LIST]
 for {set ii 0} {$ii < $LIST_LEN} {incr ii} \
 {
   set tmppr ACC_PR[lindex $PR_NAME_LIST $ii]
-  set prpath $path/$tmppr
+  set prpath $path/SLOT\[[expr [lindex $PR_NAME_LIST $ii] - 1]\].ACC_PR
   update_design -cell $prpath -black_box
 }
 
@@ -1,13 +1,14 @@
 #!/bin/bash
 
 # Check arguments
-if [ $# -ne 1 ]
+if [ $# -lt 1 ]
 then
     echo "Correct Usage:"
-    echo " ./build-pico-pr-static.sh   <project name>"
+    echo " ./build-pico-pr-static.sh   <project name> [data width, 32 or 128]"
     exit
 fi
 
 proname=$1
-# time vivado -log gen.log -journal gen.jou -mode batch -source PicoJITStatic.tcl -tclargs $proname
-time vivado -mode batch -source PicoJITStatic.tcl -tclargs $proname
+datawidth=$2
+# time vivado -log gen.log -journal gen.jou -mode batch -source PicoJITStatic.tcl -tclargs $proname $datawidth
+time vivado -mode batch -source PicoJITStatic.tcl -tclargs $proname $datawidth
@@ -0,0 +1,185 @@
+`timescale 1 ns / 1 ps
+//==================================================================================================
+// Completion records and stream 50 out of jit.v.
+//
+// The ap_done of each slot (behind its prdoor) queues one 4-word record
+//   {0xBABE000n, tag, words, status}
+// n the slot (1 .. NUM_ACCs), tag the R4 of the slot (0xCn40tttt) when the job was started by its 0xB command,
+// words the words the region sent on C since then, status bit 0 when C went to the crossbar and
+// bit 1 when an older record of the slot was overwritten before it could be sent. A job queued
+// with bit 16 set (0xCn41tttt, 0xBn01xxxx) keeps its tag and routing aside until SWAP, when
+// jit_dispatch.v loads it.
+//
+// One record per slot is held, the slots sent round robin. The 16-word counter records of
+// jit_perf.v (sP) go out whole between two completion records.
+//==================================================================================================
+module jit_cq #
+(
+  parameter NUM_ACCs = 8
+)
+(
+  input   wire              CMD_VALID  ,
+  input   wire  [31 : 0]    CMD_DATA   ,
+  input   wire  [NUM_ACCs-1 : 0]  DONE ,
+  input   wire  [NUM_ACCs-1 : 0]  SWAP ,
+  input   wire  [NUM_ACCs-1 : 0]  CWORD,
+  //////////////////////////////////////
+  output  wire              sP_tready  ,
+  input   wire              sP_tvalid  ,
+  input   wire  [31 : 0]    sP_tdata   ,
+  input   wire              mO_tready  ,
+  output  wire              mO_tvalid  ,
+  output  wire  [31 : 0]    mO_tdata   ,
+  //////////////////////////////////////
+  input   wire              clk        ,
+  input   wire              rstn
+);
+
+  localparam  IDLE  = 2'd0,
+              PERF  = 2'd1,
+              COMP  = 2'd2;
+
+  reg   [15 : 0]    rtag    [0 : NUM_ACCs-1];  // R4
+  reg   [15 : 0]    rjtag   [0 : NUM_ACCs-1];  // R4 of the running job
+  reg               rxbar   [0 : NUM_ACCs-1];
+  reg   [15 : 0]    rstag   [0 : NUM_ACCs-1];  // R4 of the queued job
+  reg               rsxbar  [0 : NUM_ACCs-1];
+  reg   [31 : 0]    rwords  [0 : NUM_ACCs-1];
+  reg   [15 : 0]    rptag   [0 : NUM_ACCs-1];  // pending record
+  reg   [31 : 0]    rpwords [0 : NUM_ACCs-1];
+  reg   [ 1 : 0]    rpstat  [0 : NUM_ACCs-1];
+  reg   [NUM_ACCs-1 : 0]  rpend;
+
+  reg   [ 1 : 0]    state   ;
+  reg   [ 3 : 0]    ridx    ;
+  reg   [ 5 : 0]    rptr    ;
+  reg   [31 : 0]    rout    [0 : 3];
+
+  reg               wfound  ;
+  reg   [ 5 : 0]    wsel    ;
+
+  wire  [NUM_ACCs-1 : 0]  wdone  = DONE;
+  wire  [NUM_ACCs-1 : 0]  wcword = CWORD;
+  wire  [ 3 : 0]    wOP     = CMD_DATA[31:28];
+  wire  [ 5 : 0]    wACCn   = {CMD_DATA[18:17], CMD_DATA[27:24]};
+  wire  [ 3 : 0]    wREGn   = CMD_DATA[23:20];
+  wire              wSHD    = CMD_DATA[16];
+
+  assign sP_tready = (state == PERF) && mO_tready;
+  assign mO_tvalid = (state == PERF) ? sP_tvalid : (state == COMP);
+  assign mO_tdata  = (state == PERF) ? sP_tdata  : rout[ridx[1:0]];
+
+  // first pending slot from the round robin pointer
+  integer k;
+  always @(*) begin
+    wfound = 1'b0;
+    wsel   = 6'd0;
+    for (k = 0; k < NUM_ACCs; k = k + 1) begin
+      if (!wfound && rpend[(rptr + k) % NUM_ACCs]) begin
+        wfound = 1'b1;
+        wsel   = (rptr + k) % NUM_ACCs;
+      end
+    end
+  end
+
+  genvar j;
+  generate for (j = 0; j < NUM_ACCs; j = j + 1) begin : slot
+    always @(posedge clk) begin
+      if (!rstn) begin
+        rtag[j]    <= 16'd0;
+        rjtag[j]   <= 16'd0;
+        rxbar[j]   <= 1'b0;
+        rstag[j]   <= 16'd0;
+        rsxbar[j]  <= 1'b0;
+        rwords[j]  <= 32'd0;
+        rptag[j]   <= 16'd0;
+        rpwords[j] <= 32'd0;
+        rpstat[j]  <= 2'd0;
+      end
+      else begin
+        if (CMD_VALID && wACCn == j + 1 && wOP == 4'hC && wREGn == 4'd4 && !wSHD)
+          rtag[j]  <= CMD_DATA[15:0];
+        if (CMD_VALID && wACCn == j + 1 && wOP == 4'hC && wREGn == 4'd4 &&  wSHD)
+          rstag[j] <= CMD_DATA[15:0];
+
+        if (CMD_VALID && wACCn == j + 1 && wOP == 4'hB && wSHD)
+          rsxbar[j] <= CMD_DATA[11:9] == 3'b111;
+
+        if (CMD_VALID && wACCn == j + 1 && wOP == 4'hB && !wSHD) begin
+          rjtag[j]  <= rtag[j];
+          rxbar[j]  <= CMD_DATA[11:9] == 3'b111;
+          rwords[j] <= 32'd0;
+        end
+        else if (SWAP[j]) begin
+          rjtag[j]  <= rstag[j];
+          rxbar[j]  <= rsxbar[j];
+          rwords[j] <= 32'd0;
+        end
+        else if (wdone[j]) begin
+          rwords[j] <= 32'd0;
+        end
+        else if (wcword[j]) begin
+          rwords[j] <= rwords[j] + 32'd1;
+        end
+
+        if (wdone[j]) begin
+          rptag[j]   <= rjtag[j];
+          rpwords[j] <= rwords[j] + wcword[j];
+          rpstat[j]  <= {rpend[j] && !(state == IDLE && !sP_tvalid && wfound && wsel == j), rxbar[j]};
+        end
+      end
+    end
+  end
+  endgenerate
+
+  always @(posedge clk) begin
+    if (!rstn) begin
+      rpend   <= {NUM_ACCs{1'b0}};
+      state   <= IDLE;
+      ridx    <= 4'd0;
+      rptr    <= 6'd0;
+      rout[0] <= 32'd0;
+      rout[1] <= 32'd0;
+      rout[2] <= 32'd0;
+      rout[3] <= 32'd0;
+    end
+    else begin
+      case (state)
+        IDLE: begin
+          ridx <= 4'd0;
+          if (sP_tvalid) begin
+            state <= PERF;
+          end
+          else if (wfound) begin
+            rout[0] <= 32'hBABE0000 | (wsel + 6'd1);
+            rout[1] <= {16'd0, rptag[wsel]};
+            rout[2] <= rpwords[wsel];
+            rout[3] <= {30'd0, rpstat[wsel]};
+            rptr    <= (wsel + 6'd1) % NUM_ACCs;
+            state   <= COMP;
+          end
+        end
+
+        PERF: begin
+          if (sP_tvalid && mO_tready) begin
+            ridx <= ridx + 4'd1;
+            if (ridx == 4'd15) state <= IDLE;
+          end
+        end
+
+        COMP: begin
+          if (mO_tready) begin
+            ridx <= ridx + 4'd1;
+            if (ridx == 4'd3) state <= IDLE;
+          end
+        end
+
+        default: state <= IDLE;
+      endcase
+
+      // a done in the cycle its slot is taken stays pending
+      rpend <= (rpend & ~((state == IDLE && !sP_tvalid && wfound) ? ({{(NUM_ACCs-1){1'b0}}, 1'b1} << wsel) : {NUM_ACCs{1'b0}})) | wdone;
+    end
+  end
+
+endmodule
@@ -0,0 +1,481 @@
+`timescale 1 ns / 1 ps
+//==================================================================================================
+// DMA nodes between the crossbar and the on-board DRAM (AXI4 master m_axi_*).
+//
+// NUM_RDs readers then NUM_WRs writers sit behind the ACC slots: DMA node d (0 .. NUM_RDs+NUM_WRs-1)
+// is slot NUM_ACCs+1+d of the commands and of the crossbar. Reader r is a crossbar source (mR), writer
+// w a crossbar destination (sW, its A input). A node takes the registers of a slot,
+//   R1 / R2   words of the job, high / low 16 bits
+//   R3        weight, 1 .. 15 bursts in a row when the node shares the AXI master (0 counts as 1)
+//   R5 / R6   DRAM byte address, high / low 16 bits, DW/8 aligned
+// and starts on its 0xB command (bit 16 is not supported): a reader streams the words from DRAM to
+// the slots reading it, a writer stores the words its A source sends. A job moves whole beats of DW
+// bits, the last one padded as the width converters of the slots do. DONE pulses when the last beat
+// left the reader or the last write of the writer was answered, and goes to jit_cq.v with CWORD, the
+// beats moved, and to jit_dispatch.v.
+//
+// Bursts are up to 16 beats and never cross 4 KB. A reader asks for no more beats than its DEPTH
+// beat buffer can take, so R is always ready; a writer starts a burst once its buffer holds all of
+// it, AW and W together, one burst at a time. ARID / AWID are the reader / writer index.
+//
+// The readers share AR and the writers AW through a weighted round robin jit_mux (ARB 1): a node
+// with a burst to issue gets up to R3 of them before the next one with a burst waiting, so a high
+// priority job moves more of the DRAM bandwidth without stopping the others.
+//
+// 0xEn00000x on stream 50 for DMA node n snapshots its counters and sends the 16-word record
+//   {0xEn00000D, cycles, grants, waits, 0 .. 0, 0x1D000000, 0xBABEFACE}
+// on mP like jit_perf.v does for a slot: grants the bursts the node issued, waits the cycles it had
+// a burst waiting for AR / AW; bit 0 set clears them after the snapshot.
+//==================================================================================================
+module jit_dma #
+(
+  parameter integer NUM_ACCs = 2,
+  parameter integer NUM_RDs  = 2,
+  parameter integer NUM_WRs  = 2,
+  parameter integer DW       = 32,
+  parameter integer PW       = 6     // log2 of the buffer beats of a node
+)
+(
+  input   wire                        CMD_VALID     ,
+  input   wire  [31 : 0]              CMD_DATA      ,
+  //////////////////////////////////////
+  input   wire  [NUM_RDs   -1 : 0]    mR_tready     ,
+  output  reg   [NUM_RDs   -1 : 0]    mR_tvalid     ,
+  output  reg   [NUM_RDs*DW-1 : 0]    mR_tdata      ,
+  output  reg   [NUM_WRs   -1 : 0]    sW_tready     ,
+  input   wire  [NUM_WRs   -1 : 0]    sW_tvalid     ,
+  input   wire  [NUM_WRs*DW-1 : 0]    sW_tdata      ,
+  output  wire  [NUM_RDs+NUM_WRs-1 : 0]  DONE       ,
+  output  wire  [NUM_RDs+NUM_WRs-1 : 0]  CWORD      ,
+  input   wire                        mP_tready     ,
+  output  wire                        mP_tvalid     ,
+  output  wire  [31 : 0]              mP_tdata      ,
+  //////////////////////////////////////
+  output  reg   [ 3 : 0]              m_axi_awid    ,
+  output  reg   [31 : 0]              m_axi_awaddr  ,
+  output  reg   [ 7 : 0]              m_axi_awlen   ,
+  output  wire  [ 2 : 0]              m_axi_awsize  ,
+  output  wire  [ 1 : 0]              m_axi_awburst ,
+  output  reg                         m_axi_awvalid ,
+  input   wire                        m_axi_awready ,
+  output  reg   [DW-1 : 0]            m_axi_wdata   ,
+  output  wire  [DW/8-1 : 0]          m_axi_wstrb   ,
+  output  wire                        m_axi_wlast   ,
+  output  wire                        m_axi_wvalid  ,
+  input   wire                        m_axi_wready  ,
+  input   wire  [ 3 : 0]              m_axi_bid     ,
+  input   wire  [ 1 : 0]              m_axi_bresp   ,
+  input   wire                        m_axi_bvalid  ,
+  output  wire                        m_axi_bready  ,
+  output  reg   [ 3 : 0]              m_axi_arid    ,
+  output  reg   [31 : 0]              m_axi_araddr  ,
+  output  reg   [ 7 : 0]              m_axi_arlen   ,
+  output  wire  [ 2 : 0]              m_axi_arsize  ,
+  output  wire  [ 1 : 0]              m_axi_arburst ,
+  output  reg                         m_axi_arvalid ,
+  input   wire                        m_axi_arready ,
+  input   wire  [ 3 : 0]              m_axi_rid     ,
+  input   wire  [DW-1 : 0]            m_axi_rdata   ,
+  input   wire  [ 1 : 0]              m_axi_rresp   ,
+  input   wire                        m_axi_rlast   ,
+  input   wire                        m_axi_rvalid  ,
+  output  wire                        m_axi_rready  ,
+  //////////////////////////////////////
+  input   wire                        clk           ,
+  input   wire                        rstn
+);
+
+  localparam ND    = NUM_RDs + NUM_WRs;
+  localparam DEPTH = 1 << PW;
+  localparam SZ    = (DW == 128) ? 4 : (DW == 64) ? 3 : 2;   // log2 of the bytes of a beat
+  localparam LB    = SZ - 2;                                   // log2 of the words of a beat
+
+  wire  [ 3 : 0]    wOP     = CMD_DATA[31:28];
+  wire  [ 5 : 0]    wACCn   = {CMD_DATA[18:17], CMD_DATA[27:24]};
+  wire  [ 3 : 0]    wREGn   = CMD_DATA[23:20];
+  wire              wSHD    = CMD_DATA[16];
+
+  // registers of the nodes
+  reg   [31 : 0]    rwords  [0 : ND-1];
+  reg   [31 : 0]    raddr   [0 : ND-1];
+  reg   [ 3 : 0]    rweight [0 : ND-1];
+  wire  [ND-1 : 0]  wstart  ;
+  wire  [ND*4-1 : 0]  wweight;
+
+  genvar d;
+  generate for (d = 0; d < ND; d = d + 1) begin : NODE
+    assign wstart[d] = CMD_VALID && wOP == 4'hB && wACCn == NUM_ACCs + 1 + d && !wSHD;
+    assign wweight[d*4 +: 4] = rweight[d];
+
+    always @(posedge clk) begin
+      if (!rstn) begin
+        rwords[d] <= 32'd0;
+        raddr[d]  <= 32'd0;
+        rweight[d] <= 4'd1;
+      end
+      else if (CMD_VALID && wOP == 4'hC && wACCn == NUM_ACCs + 1 + d && !wSHD) begin
+        if (wREGn == 4'd1) rwords[d][31:16] <= CMD_DATA[15:0];
+        if (wREGn == 4'd2) rwords[d][15: 0] <= CMD_DATA[15:0];
+        if (wREGn == 4'd3) rweight[d]       <= CMD_DATA[3:0];
+        if (wREGn == 4'd5) raddr[d][31:16]  <= CMD_DATA[15:0];
+        if (wREGn == 4'd6) raddr[d][15: 0]  <= CMD_DATA[15:0];
+      end
+    end
+  end
+  endgenerate
+
+  reg   [NUM_RDs-1 : 0]  rrd_done;
+  reg   [NUM_WRs-1 : 0]  rwr_done;
+  assign DONE = {rwr_done, rrd_done};
+
+  assign m_axi_awsize  = SZ;
+  assign m_axi_awburst = 2'b01;
+  assign m_axi_arsize  = SZ;
+  assign m_axi_arburst = 2'b01;
+  assign m_axi_wstrb   = {(DW/8){1'b1}};
+  assign m_axi_bready  = 1'b1;
+  assign m_axi_rready  = 1'b1;
+
+  // beats of a burst from addr, beats left and the 4 KB boundary
+  function [4:0] blen;
+    input [31:0] addr;
+    input [31:0] left;
+    reg   [12:0] to4k;
+    begin
+      to4k = (13'h1000 - {1'b0, addr[11:0]}) >> SZ;
+      blen = (left < 32'd16) ? left[4:0] : 5'd16;
+      if (to4k < blen) blen = to4k[4:0];
+    end
+  endfunction
+//==================================================================================================
+// Readers
+//==================================================================================================
+  reg   [DW-1 : 0]  rrmem   [0 : NUM_RDs*DEPTH-1];
+  reg   [NUM_RDs-1 : 0]  ract;
+  reg   [31 : 0]    rar_addr  [0 : NUM_RDs-1];   // next AR address
+  reg   [31 : 0]    rar_left  [0 : NUM_RDs-1];   // beats not asked for yet
+  reg   [31 : 0]    rout_left [0 : NUM_RDs-1];   // beats not sent to the crossbar yet
+  reg   [PW : 0]    rlevel    [0 : NUM_RDs-1];   // beats in the buffer
+  reg   [PW : 0]    rcredit   [0 : NUM_RDs-1];   // beats in the buffer or asked for
+  reg   [PW-1 : 0]  rwp       [0 : NUM_RDs-1];
+  reg   [PW-1 : 0]  rrp       [0 : NUM_RDs-1];
+
+  reg   [NUM_RDs   -1 : 0]  war_valid;
+  reg   [NUM_RDs*16-1 : 0]  war_data ;            // {len, reader} of the next burst of each reader
+  wire              war_found;
+  wire  [ 3 : 0]    war_sel  ;
+  wire  [ 4 : 0]    war_len  ;
+  wire  [15 : 0]    war_pick ;
+  wire  [NUM_RDs*32-1 : 0]  war_grants;
+  wire  [NUM_RDs*32-1 : 0]  war_waits ;
+  reg   [ 4 : 0]    war_k    ;
+  integer m, a, r;
+
+  always @(*) begin
+    mR_tvalid = {NUM_RDs{1'b0}};
+    mR_tdata  = {(NUM_RDs*DW){1'b0}};
+    for (m = 0; m < NUM_RDs; m = m + 1) begin
+      mR_tvalid[m]           = ract[m] && rlevel[m] != 0;
+      mR_tdata[m*DW +: DW]   = rrmem[m*DEPTH + rrp[m]];
+    end
+  end
+
+  assign CWORD[NUM_RDs-1 : 0] = mR_tvalid & mR_tready;
+
+  // readers with beats to ask for and room for their burst, AR to the one the mux picks
+  always @(*) begin
+    war_valid = {NUM_RDs{1'b0}};
+    war_data  = {(NUM_RDs*16){1'b0}};
+    for (a = 0; a < NUM_RDs; a = a + 1) begin
+      war_k                = blen(rar_addr[a], rar_left[a]);
+      war_valid[a]         = ract[a] && rar_left[a] != 0 && rcredit[a] + war_k <= DEPTH;
+      war_data[a*16 +: 16] = {7'd0, war_k, a[3:0]};
+    end
+  end
+
+  jit_mux #(NUM_RDs, 16, 2, 1) u_ar_arb (
+    .sI_tready  (                             ),
+    .sI_tvalid  (war_valid                    ),
+    .sI_tdata   (war_data                     ),
+    .sI_tlast   ({NUM_RDs{1'b1}}              ),
+    .mO_tready  (!m_axi_arvalid || m_axi_arready),
+    .mO_tvalid  (war_found                    ),
+    .mO_tdata   (war_pick                     ),
+    .CONF       (2'b01                        ),
+    .WEIGHT     (wweight[NUM_RDs*4-1 : 0]     ),
+    .GRANTS     (war_grants                   ),
+    .WAITS      (war_waits                    ),
+    .ACLK       (clk                          ),
+    .ARESETN    (rstn                         )
+  );
+
+  assign war_sel = war_pick[3:0];
+  assign war_len = war_pick[8:4];
+
+  always @(posedge clk) begin
+    if (!rstn) begin
+      ract          <= {NUM_RDs{1'b0}};
+      m_axi_arvalid <= 1'b0;
+      m_axi_arid    <= 4'd0;
+      m_axi_araddr  <= 32'd0;
+      m_axi_arlen   <= 8'd0;
+      for (r = 0; r < NUM_RDs; r = r + 1) begin
+        rar_addr[r]  <= 32'd0;
+        rar_left[r]  <= 32'd0;
+        rout_left[r] <= 32'd0;
+        rlevel[r]    <= 0;
+        rcredit[r]   <= 0;
+        rwp[r]       <= 0;
+        rrp[r]       <= 0;
+      end
+      rrd_done <= {NUM_RDs{1'b0}};
+    end
+    else begin
+      if (m_axi_arvalid && m_axi_arready)
+        m_axi_arvalid <= 1'b0;
+
+      for (r = 0; r < NUM_RDs; r = r + 1) begin
+        rrd_done[r]  <= 1'b0;
+        rlevel[r] <= rlevel[r] + (m_axi_rvalid && m_axi_rid == r) - (mR_tvalid[r] && mR_tready[r]);
+        rcredit[r] <= rcredit[r] + (((!m_axi_arvalid || m_axi_arready) && war_found && war_sel == r) ? war_len : 0)
+                                 - (mR_tvalid[r] && mR_tready[r]);
+        if (m_axi_rvalid && m_axi_rid == r) begin
+          rrmem[r*DEPTH + rwp[r]] <= m_axi_rdata;
+          rwp[r] <= rwp[r] + 1'b1;
+        end
+        if (mR_tvalid[r] && mR_tready[r]) begin
+          rrp[r]       <= rrp[r] + 1'b1;
+          rout_left[r] <= rout_left[r] - 1;
+        end
+        if (ract[r] && rout_left[r] == 0) begin
+          ract[r]  <= 1'b0;
+          rrd_done[r] <= 1'b1;
+        end
+        if (wstart[r]) begin
+          ract[r]      <= 1'b1;
+          rar_addr[r]  <= raddr[r];
+          rar_left[r]  <= (rwords[r] + (1 << LB) - 1) >> LB;
+          rout_left[r] <= (rwords[r] + (1 << LB) - 1) >> LB;
+        end
+      end
+
+      if ((!m_axi_arvalid || m_axi_arready) && war_found) begin
+        m_axi_arvalid          <= 1'b1;
+        m_axi_arid             <= war_sel;
+        m_axi_araddr           <= rar_addr[war_sel];
+        m_axi_arlen            <= war_len - 1;
+        rar_addr[war_sel]      <= rar_addr[war_sel] + (war_len << SZ);
+        rar_left[war_sel]      <= rar_left[war_sel] - war_len;
+      end
+    end
+  end
+//==================================================================================================
+// Writers
+//==================================================================================================
+  localparam  WIDLE  = 1'b0,
+              WBURST = 1'b1;
+
+  reg   [DW-1 : 0]  rwmem   [0 : NUM_WRs*DEPTH-1];
+  reg   [NUM_WRs-1 : 0]  wact;
+  reg   [31 : 0]    win_left  [0 : NUM_WRs-1];   // beats not taken from the crossbar yet
+  reg   [31 : 0]    waw_addr  [0 : NUM_WRs-1];   // next AW address
+  reg   [31 : 0]    waw_left  [0 : NUM_WRs-1];   // beats not in a burst yet
+  reg   [ 7 : 0]    wbout     [0 : NUM_WRs-1];   // bursts waiting on B
+  reg   [PW : 0]    wlevel    [0 : NUM_WRs-1];
+  reg   [PW-1 : 0]  wwp       [0 : NUM_WRs-1];
+  reg   [PW-1 : 0]  wrp       [0 : NUM_WRs-1];
+  reg               wstate  ;
+  reg   [ 3 : 0]    wown    ;                    // writer of the burst on W
+  reg   [ 4 : 0]    wbeats  ;                    // its beats left on W
+
+  reg   [NUM_WRs   -1 : 0]  waw_valid;
+  reg   [NUM_WRs*16-1 : 0]  waw_data ;            // {len, writer} of the next burst of each writer
+  wire              waw_found;
+  wire  [ 3 : 0]    waw_sel  ;
+  wire  [ 4 : 0]    waw_len  ;
+  wire  [15 : 0]    waw_pick ;
+  wire  [NUM_WRs*32-1 : 0]  waw_grants;
+  wire  [NUM_WRs*32-1 : 0]  waw_waits ;
+  reg   [ 4 : 0]    waw_k    ;
+  integer n, b, w;
+
+  wire              wpop     = m_axi_wvalid && m_axi_wready;
+
+  assign m_axi_wvalid = (wstate == WBURST) && wbeats != 0;
+  assign m_axi_wlast  = (wbeats == 5'd1);
+
+  always @(*) begin
+    sW_tready   = {NUM_WRs{1'b0}};
+    m_axi_wdata = rwmem[wown*DEPTH + wrp[wown]];
+    for (n = 0; n < NUM_WRs; n = n + 1)
+      sW_tready[n] = wact[n] && win_left[n] != 0 && wlevel[n] < DEPTH;
+  end
+
+  assign CWORD[ND-1 : NUM_RDs] = sW_tvalid & sW_tready;
+
+  // writers holding a whole burst, AW to the one the mux picks
+  always @(*) begin
+    waw_valid = {NUM_WRs{1'b0}};
+    waw_data  = {(NUM_WRs*16){1'b0}};
+    for (b = 0; b < NUM_WRs; b = b + 1) begin
+      waw_k                = blen(waw_addr[b], waw_left[b]);
+      waw_valid[b]         = wact[b] && waw_left[b] != 0 && wlevel[b] >= waw_k;
+      waw_data[b*16 +: 16] = {7'd0, waw_k, b[3:0]};
+    end
+  end
+
+  jit_mux #(NUM_WRs, 16, 2, 1) u_aw_arb (
+    .sI_tready  (                             ),
+    .sI_tvalid  (waw_valid                    ),
+    .sI_tdata   (waw_data                     ),
+    .sI_tlast   ({NUM_WRs{1'b1}}              ),
+    .mO_tready  (wstate == WIDLE              ),
+    .mO_tvalid  (waw_found                    ),
+    .mO_tdata   (waw_pick                     ),
+    .CONF       (2'b01                        ),
+    .WEIGHT     (wweight[ND*4-1 : NUM_RDs*4]  ),
+    .GRANTS     (waw_grants                   ),
+    .WAITS      (waw_waits                    ),
+    .ACLK       (clk                          ),
+    .ARESETN    (rstn                         )
+  );
+
+  assign waw_sel = waw_pick[3:0];
+  assign waw_len = waw_pick[8:4];
+
+  always @(posedge clk) begin
+    if (!rstn) begin
+      wact          <= {NUM_WRs{1'b0}};
+      wstate        <= WIDLE;
+      wown          <= 4'd0;
+      wbeats        <= 5'd0;
+      m_axi_awvalid <= 1'b0;
+      m_axi_awid    <= 4'd0;
+      m_axi_awaddr  <= 32'd0;
+      m_axi_awlen   <= 8'd0;
+      for (w = 0; w < NUM_WRs; w = w + 1) begin
+        win_left[w] <= 32'd0;
+        waw_addr[w] <= 32'd0;
+        waw_left[w] <= 32'd0;
+        wbout[w]    <= 8'd0;
+        wlevel[w]   <= 0;
+        wwp[w]      <= 0;
+        wrp[w]      <= 0;
+      end
+      rwr_done <= {NUM_WRs{1'b0}};
+    end
+    else begin
+      if (m_axi_awvalid && m_axi_awready)
+        m_axi_awvalid <= 1'b0;
+
+      for (w = 0; w < NUM_WRs; w = w + 1) begin
+        rwr_done[w] <= 1'b0;
+        wlevel[w] <= wlevel[w] + (sW_tvalid[w] && sW_tready[w]) - (wpop && wown == w);
+        wbout[w]  <= wbout[w] + ((wstate == WIDLE && waw_found && waw_sel == w) ? 1 : 0)
+                              - ((m_axi_bvalid && m_axi_bid == w) ? 1 : 0);
+        if (sW_tvalid[w] && sW_tready[w]) begin
+          rwmem[w*DEPTH + wwp[w]] <= sW_tdata[w*DW +: DW];
+          wwp[w]      <= wwp[w] + 1'b1;
+          win_left[w] <= win_left[w] - 1;
+        end
+        if (wpop && wown == w)
+          wrp[w] <= wrp[w] + 1'b1;
+        if (wact[w] && waw_left[w] == 0 && wbout[w] == 0 && !(wstate == WBURST && wown == w)) begin
+          wact[w]            <= 1'b0;
+          rwr_done[w] <= 1'b1;
+        end
+        if (wstart[NUM_RDs + w]) begin
+          wact[w]     <= 1'b1;
+          waw_addr[w] <= raddr[NUM_RDs + w];
+          waw_left[w] <= (rwords[NUM_RDs + w] + (1 << LB) - 1) >> LB;
+          win_left[w] <= (rwords[NUM_RDs + w] + (1 << LB) - 1) >> LB;
+        end
+      end
+
+      case (wstate)
+        WIDLE : begin
+          if (waw_found) begin
+            wstate            <= WBURST;
+            wown              <= waw_sel;
+            wbeats            <= waw_len;
+            m_axi_awvalid     <= 1'b1;
+            m_axi_awid        <= waw_sel;
+            m_axi_awaddr      <= waw_addr[waw_sel];
+            m_axi_awlen       <= waw_len - 1;
+            waw_addr[waw_sel] <= waw_addr[waw_sel] + (waw_len << SZ);
+            waw_left[waw_sel] <= waw_left[waw_sel] - waw_len;
+          end
+        end
+        WBURST : begin
+          if (wpop)
+            wbeats <= wbeats - 1'b1;
+          if ((wbeats == 0 || (wpop && wbeats == 1)) && (!m_axi_awvalid || m_axi_awready))
+            wstate <= WIDLE;
+        end
+      endcase
+    end
+  end
+//==================================================================================================
+// Counter records
+//==================================================================================================
+  wire  [ND*32-1 : 0]  wgrants = {waw_grants, war_grants};
+  wire  [ND*32-1 : 0]  wwaits  = {waw_waits,  war_waits };
+
+  reg   [31 : 0]    rcycles ;
+  reg   [31 : 0]    rbase   [0 : ND*3-1];         // cycles, grants, waits of node d at its last clear
+  reg   [31 : 0]    rsnap   [0 : 2];
+  reg   [ 5 : 0]    rpid    ;                     // slot of the record
+  reg               rsend   ;
+  reg   [ 3 : 0]    ridx    ;
+  reg               wperf   ;
+  reg   [ 3 : 0]    wpn     ;
+  integer e;
+
+  always @(*) begin
+    wperf = 1'b0;
+    wpn   = 4'd0;
+    for (e = 0; e < ND; e = e + 1)
+      if (CMD_VALID && wOP == 4'hE && wACCn == NUM_ACCs + 1 + e && wREGn == 4'd0) begin
+        wperf = 1'b1;
+        wpn   = e;
+      end
+  end
+
+  assign mP_tvalid = rsend;
+  assign mP_tdata  = (ridx == 4'd0)  ? {4'hE, rpid[3:0], 5'd0, rpid[5:4], 13'd0, 4'hD} :
+                     (ridx <= 4'd3)  ? rsnap[ridx - 1]  :
+                     (ridx == 4'd14) ? 32'h1D000000     :
+                     (ridx == 4'd15) ? 32'hBABEFACE     : 32'd0;
+
+  always @(posedge clk) begin
+    if (!rstn) begin
+      rcycles <= 32'd0;
+      for (e = 0; e < ND*3; e = e + 1) rbase[e] <= 32'd0;
+      for (e = 0; e < 3; e = e + 1)    rsnap[e] <= 32'd0;
+      rpid    <= 6'd0;
+      rsend   <= 1'b0;
+      ridx    <= 4'd0;
+    end
+    else begin
+      rcycles <= rcycles + 32'd1;
+      if (wperf && !rsend) begin
+        rsnap[0] <= rcycles                 - rbase[wpn*3    ];
+        rsnap[1] <= wgrants[wpn*32 +: 32]   - rbase[wpn*3 + 1];
+        rsnap[2] <= wwaits[wpn*32 +: 32]    - rbase[wpn*3 + 2];
+        rpid     <= NUM_ACCs + 1 + wpn;
+        rsend    <= 1'b1;
+        ridx     <= 4'd0;
+        if (CMD_DATA[0]) begin
+          rbase[wpn*3    ] <= rcycles;
+          rbase[wpn*3 + 1] <= wgrants[wpn*32 +: 32];
+          rbase[wpn*3 + 2] <= wwaits[wpn*32 +: 32];
+        end
+      end
+      else if (rsend && mP_tready) begin
+        ridx <= ridx + 4'd1;
+        if (ridx == 4'd15) rsend <= 1'b0;
+      end
+    end
+  end
+
+endmodule
@@ -0,0 +1,41 @@
+`timescale 1 ns / 1 ps
+//==================================================================================================
+// Ready side of one crossbar source, one output per consumer port.
+//
+// EN selects the consumer ports reading the source (their CONF points at it). A word is offered
+// to all of them at once; a port that takes it is masked off until the last one has, and only
+// then the source sees ready, so a slow consumer holds the word for all of them but no consumer
+// sees it twice. With one port in EN this is the plain point-to-point handshake.
+//==================================================================================================
+module jit_fork #
+(
+  parameter N = 2
+)
+(
+  input   wire  [N-1 : 0]  EN         ,
+
+  output  wire             sI_tready  ,
+  input   wire             sI_tvalid  ,
+
+  input   wire  [N-1 : 0]  mO_tready  ,
+  output  wire  [N-1 : 0]  mO_tvalid  ,
+
+  input   wire             ACLK       ,
+  input   wire             ARESETN
+);
+
+  reg   [N-1 : 0]   rdone;    // ports that took the current word
+
+  assign mO_tvalid = {N{sI_tvalid}} & EN & ~rdone;
+  assign sI_tready = (|EN) && (&(~EN | rdone | mO_tready));
+
+  always @(posedge ACLK) begin
+    if (!ARESETN)
+      rdone <= {N{1'b0}};
+    else if (sI_tvalid && sI_tready)
+      rdone <= {N{1'b0}};
+    else
+      rdone <= rdone | (mO_tvalid & mO_tready);
+  end
+
+endmodule
@@ -1,871 +1,152 @@
 `timescale 1 ns / 1 ps
-
+//==================================================================================================
+// NUM_PORTs to 1 stream mux.
+//
+// ARB 0: CONF k (1 .. NUM_PORTs) connects input port k-1 of the packed sI_* arrays to mO, any other
+// value leaves mO idle and no input ready. Port k-1 of sI_tdata is sI_tdata[(k-1)*DW +: DW].
+//
+// ARB 1: the valid inputs share mO round robin, CONF[1:0] the mode:
+//   bit 0   weighted, port k keeps mO for WEIGHT[k*4 +: 4] packets in a row (0 counts as 1), else 1
+//   bit 1   packet lock, a packet is the words up to sI_tlast and none of another port comes in
+//           between, else every word is a packet
+// A port picked stays picked until its word is taken, so mO does not change under a valid word.
+// GRANTS[k*32 +: 32] counts the packets of port k, WAITS[k*32 +: 32] the cycles it was valid and
+// not taken, both from reset; with ARB 0 they stay 0.
+//==================================================================================================
 module jit_mux #
 (
-  parameter NUM_PORTs = 2
+  parameter NUM_PORTs = 2,
+  parameter DW        = 32,
+  parameter CW        = 6,
+  parameter ARB       = 0
 )
 (
-
-  output  reg              s1_tready  ,
-  input   wire             s1_tvalid  ,
-  input   wire  [31 : 0]   s1_tdata   ,
-
-  output  reg              s2_tready  ,
-  input   wire             s2_tvalid  ,
-  input   wire  [31 : 0]   s2_tdata   ,
-
-  output  reg              s3_tready  ,
-  input   wire             s3_tvalid  ,
-  input   wire  [31 : 0]   s3_tdata   ,
-
-  output  reg              s4_tready  ,
-  input   wire             s4_tvalid  ,
-  input   wire  [31 : 0]   s4_tdata   ,
-
-  output  reg              s5_tready  ,
-  input   wire             s5_tvalid  ,
-  input   wire  [31 : 0]   s5_tdata   ,
-
-  output  reg              s6_tready  ,
-  input   wire             s6_tvalid  ,
-  input   wire  [31 : 0]   s6_tdata   ,
-
-  output  reg              s7_tready  ,
-  input   wire             s7_tvalid  ,
-  input   wire  [31 : 0]   s7_tdata   ,
-
-  output  reg              s8_tready  ,
-  input   wire             s8_tvalid  ,
-  input   wire  [31 : 0]   s8_tdata   ,
-
-  input   wire             mO_tready  ,
-  output  reg              mO_tvalid  ,
-  output  reg   [31 : 0]   mO_tdata   ,
-
-  input   wire  [ 3 : 0]   CONF       ,
-
-  input   wire             ACLK       ,
-  input   wire             ARESETN
+  output  reg   [NUM_PORTs   -1 : 0]  sI_tready  ,
+  input   wire  [NUM_PORTs   -1 : 0]  sI_tvalid  ,
+  input   wire  [NUM_PORTs*DW-1 : 0]  sI_tdata   ,
+  input   wire  [NUM_PORTs   -1 : 0]  sI_tlast   ,
+
+  input   wire                        mO_tready  ,
+  output  reg                         mO_tvalid  ,
+  output  reg   [DW-1 : 0]            mO_tdata   ,
+
+  input   wire  [CW-1 : 0]            CONF       ,
+  input   wire  [NUM_PORTs*4 -1 : 0]  WEIGHT     ,
+  output  wire  [NUM_PORTs*32-1 : 0]  GRANTS     ,
+  output  wire  [NUM_PORTs*32-1 : 0]  WAITS      ,
+
+  input   wire                        ACLK       ,
+  input   wire                        ARESETN
 );
 
-//    ____   ___  ____ _____          ____
-//   |  _ \ / _ \|  _ \_   _|__   _  |___ \
-//   | |_) | | | | |_) || |/ __| (_)   __) |
-//   |  __/| |_| |  _ < | |\__ \  _   / __/
-//   |_|    \___/|_| \_\|_||___/ (_) |_____|
-//
-generate if (NUM_PORTs == 2) begin
-  always @(*) begin
-    if (!ARESETN) begin
-      mO_tvalid =  1'b0     ;
-      mO_tdata  = 32'd0     ;
-      s1_tready =  1'b0     ;
-      s2_tready =  1'b0     ;
-      s3_tready =  1'b0     ;
-      s4_tready =  1'b0     ;
-      s5_tready =  1'b0     ;
-      s6_tready =  1'b0     ;
-      s7_tready =  1'b0     ;
-      s8_tready =  1'b0     ;
-    end
-    else begin
-      case (CONF)
-        4'd0: begin
-          mO_tvalid =  1'b0     ;
-          mO_tdata  = 32'd0     ;
-          s1_tready =  1'b0     ;
-          s2_tready =  1'b0     ;
-          s3_tready =  1'b0     ;
-          s4_tready =  1'b0     ;
-          s5_tready =  1'b0     ;
-          s6_tready =  1'b0     ;
-          s7_tready =  1'b0     ;
-          s8_tready =  1'b0     ;
-        end
-
-        4'd1: begin
-          mO_tvalid = s1_tvalid ;
-          mO_tdata  = s1_tdata  ;
-          s1_tready = mO_tready ;
-          s2_tready = 1'b0      ;
-          s3_tready = 1'b0      ;
-          s4_tready = 1'b0      ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd2: begin
-          mO_tvalid = s2_tvalid ;
-          mO_tdata  = s2_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = mO_tready ;
-          s3_tready = 1'b0      ;
-          s4_tready = 1'b0      ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        default: begin
-          mO_tvalid =  1'b0     ;
-          mO_tdata  = 32'd0     ;
-          s1_tready =  1'b0     ;
-          s2_tready =  1'b0     ;
-          s3_tready =  1'b0     ;
-          s4_tready =  1'b0     ;
-          s5_tready =  1'b0     ;
-          s6_tready =  1'b0     ;
-          s7_tready =  1'b0     ;
-          s8_tready =  1'b0     ;
-        end
-      endcase
+  integer k;
+
+  generate if (ARB == 0) begin : SEL
+    assign GRANTS = {(NUM_PORTs*32){1'b0}};
+    assign WAITS  = {(NUM_PORTs*32){1'b0}};
+
+    always @(*) begin
+      mO_tvalid = 1'b0;
+      mO_tdata  = {DW{1'b0}};
+      sI_tready = {NUM_PORTs{1'b0}};
+      if (ARESETN) begin
+        for (k = 0; k < NUM_PORTs; k = k + 1) begin
+          if (CONF == k + 1) begin
+            mO_tvalid    = sI_tvalid[k];
+            mO_tdata     = sI_tdata[k*DW +: DW];
+            sI_tready[k] = mO_tready;
+          end
+        end
+      end
     end
   end
-end
-endgenerate
-//    ____   ___  ____ _____          _____
-//   |  _ \ / _ \|  _ \_   _|__   _  |___ /
-//   | |_) | | | | |_) || |/ __| (_)   |_ \
-//   |  __/| |_| |  _ < | |\__ \  _   ___) |
-//   |_|    \___/|_| \_\|_||___/ (_) |____/
-//
-generate if (NUM_PORTs == 3) begin
-  always @(*) begin
-    if (!ARESETN) begin
-      mO_tvalid =  1'b0     ;
-      mO_tdata  = 32'd0     ;
-      s1_tready =  1'b0     ;
-      s2_tready =  1'b0     ;
-      s3_tready =  1'b0     ;
-      s4_tready =  1'b0     ;
-      s5_tready =  1'b0     ;
-      s6_tready =  1'b0     ;
-      s7_tready =  1'b0     ;
-      s8_tready =  1'b0     ;
+  else begin : RR
+    reg   [ 5 : 0]    rgnt  ;   // port of the last word
+    reg   [ 4 : 0]    rleft ;   // packets left of its turn
+    reg               rlock ;   // inside a packet of rgnt
+    reg               rhold ;   // a picked word not taken yet
+    reg   [ 5 : 0]    rhsel ;
+    reg               rhnew ;
+    reg   [31 : 0]    rgrants [0 : NUM_PORTs-1];
+    reg   [31 : 0]    rwaits  [0 : NUM_PORTs-1];
+    integer           q;
+
+    reg               wfound;
+    reg   [ 5 : 0]    wsel  ;
+    reg               wnew  ;   // wsel starts a new turn
+    reg   [ 5 : 0]    wp    ;
+    reg   [ 4 : 0]    wweight;
+    wire              wlast = !CONF[1] || sI_tlast[wsel];
+    wire              wtake = mO_tvalid && mO_tready;
+
+    genvar g;
+    for (g = 0; g < NUM_PORTs; g = g + 1) begin : CNT
+      assign GRANTS[g*32 +: 32] = rgrants[g];
+      assign WAITS[g*32 +: 32]  = rwaits[g];
     end
-    else begin
-      case (CONF)
-        4'd0: begin
-          mO_tvalid =  1'b0     ;
-          mO_tdata  = 32'd0     ;
-          s1_tready =  1'b0     ;
-          s2_tready =  1'b0     ;
-          s3_tready =  1'b0     ;
-          s4_tready =  1'b0     ;
-          s5_tready =  1'b0     ;
-          s6_tready =  1'b0     ;
-          s7_tready =  1'b0     ;
-          s8_tready =  1'b0     ;
-        end
-
-        4'd1: begin
-          mO_tvalid = s1_tvalid ;
-          mO_tdata  = s1_tdata  ;
-          s1_tready = mO_tready ;
-          s2_tready = 1'b0      ;
-          s3_tready = 1'b0      ;
-          s4_tready = 1'b0      ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd2: begin
-          mO_tvalid = s2_tvalid ;
-          mO_tdata  = s2_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = mO_tready ;
-          s3_tready = 1'b0      ;
-          s4_tready = 1'b0      ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd3: begin
-          mO_tvalid = s3_tvalid ;
-          mO_tdata  = s3_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = 1'b0      ;
-          s3_tready = mO_tready ;
-          s4_tready = 1'b0      ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
 
-        default: begin
-          mO_tvalid =  1'b0     ;
-          mO_tdata  = 32'd0     ;
-          s1_tready =  1'b0     ;
-          s2_tready =  1'b0     ;
-          s3_tready =  1'b0     ;
-          s4_tready =  1'b0     ;
-          s5_tready =  1'b0     ;
-          s6_tready =  1'b0     ;
-          s7_tready =  1'b0     ;
-          s8_tready =  1'b0     ;
-        end
-      endcase
+    always @(*) begin
+      wfound = 1'b0;
+      wsel   = rgnt;
+      wnew   = 1'b0;
+      if (rhold) begin
+        wfound = sI_tvalid[rhsel];
+        wsel   = rhsel;
+        wnew   = rhnew;
+      end
+      else if (rlock) begin
+        wfound = sI_tvalid[rgnt];
+      end
+      else if (rleft != 5'd0 && sI_tvalid[rgnt]) begin
+        wfound = 1'b1;
+      end
+      else begin
+        for (k = 1; k <= NUM_PORTs; k = k + 1) begin
+          wp = (rgnt + k) % NUM_PORTs;
+          if (!wfound && sI_tvalid[wp]) begin
+            wfound = 1'b1;
+            wsel   = wp;
+            wnew   = 1'b1;
+          end
+        end
+      end
+      wweight = (!CONF[0] || WEIGHT[wsel*4 +: 4] == 4'd0) ? 5'd1 : {1'b0, WEIGHT[wsel*4 +: 4]};
+
+      mO_tvalid = ARESETN && wfound;
+      mO_tdata  = sI_tdata[wsel*DW +: DW];
+      sI_tready = {NUM_PORTs{1'b0}};
+      sI_tready[wsel] = ARESETN && wfound && mO_tready;
     end
-  end
-end
-endgenerate
-//    ____   ___  ____ _____          _  _
-//   |  _ \ / _ \|  _ \_   _|__   _  | || |
-//   | |_) | | | | |_) || |/ __| (_) | || |_
-//   |  __/| |_| |  _ < | |\__ \  _  |__   _|
-//   |_|    \___/|_| \_\|_||___/ (_)    |_|
-//
-generate if (NUM_PORTs == 4) begin
-  always @(*) begin
-    if (!ARESETN) begin
-      mO_tvalid =  1'b0     ;
-      mO_tdata  = 32'd0     ;
-      s1_tready =  1'b0     ;
-      s2_tready =  1'b0     ;
-      s3_tready =  1'b0     ;
-      s4_tready =  1'b0     ;
-      s5_tready =  1'b0     ;
-      s6_tready =  1'b0     ;
-      s7_tready =  1'b0     ;
-      s8_tready =  1'b0     ;
-    end
-    else begin
-      case (CONF)
-        4'd0: begin
-          mO_tvalid =  1'b0     ;
-          mO_tdata  = 32'd0     ;
-          s1_tready =  1'b0     ;
-          s2_tready =  1'b0     ;
-          s3_tready =  1'b0     ;
-          s4_tready =  1'b0     ;
-          s5_tready =  1'b0     ;
-          s6_tready =  1'b0     ;
-          s7_tready =  1'b0     ;
-          s8_tready =  1'b0     ;
-        end
-
-        4'd1: begin
-          mO_tvalid = s1_tvalid ;
-          mO_tdata  = s1_tdata  ;
-          s1_tready = mO_tready ;
-          s2_tready = 1'b0      ;
-          s3_tready = 1'b0      ;
-          s4_tready = 1'b0      ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd2: begin
-          mO_tvalid = s2_tvalid ;
-          mO_tdata  = s2_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = mO_tready ;
-          s3_tready = 1'b0      ;
-          s4_tready = 1'b0      ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
 
-        4'd3: begin
-          mO_tvalid = s3_tvalid ;
-          mO_tdata  = s3_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = 1'b0      ;
-          s3_tready = mO_tready ;
-          s4_tready = 1'b0      ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd4: begin
-          mO_tvalid = s4_tvalid ;
-          mO_tdata  = s4_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = 1'b0      ;
-          s3_tready = 1'b0      ;
-          s4_tready = mO_tready ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        default: begin
-          mO_tvalid =  1'b0     ;
-          mO_tdata  = 32'd0     ;
-          s1_tready =  1'b0     ;
-          s2_tready =  1'b0     ;
-          s3_tready =  1'b0     ;
-          s4_tready =  1'b0     ;
-          s5_tready =  1'b0     ;
-          s6_tready =  1'b0     ;
-          s7_tready =  1'b0     ;
-          s8_tready =  1'b0     ;
-        end
-      endcase
-    end
-  end
-end
-endgenerate
-//    ____   ___  ____ _____          ____
-//   |  _ \ / _ \|  _ \_   _|__   _  | ___|
-//   | |_) | | | | |_) || |/ __| (_) |___ \
-//   |  __/| |_| |  _ < | |\__ \  _   ___) |
-//   |_|    \___/|_| \_\|_||___/ (_) |____/
-//
-generate if (NUM_PORTs == 5) begin
-  always @(*) begin
-    if (!ARESETN) begin
-      mO_tvalid =  1'b0     ;
-      mO_tdata  = 32'd0     ;
-      s1_tready =  1'b0     ;
-      s2_tready =  1'b0     ;
-      s3_tready =  1'b0     ;
-      s4_tready =  1'b0     ;
-      s5_tready =  1'b0     ;
-      s6_tready =  1'b0     ;
-      s7_tready =  1'b0     ;
-      s8_tready =  1'b0     ;
-    end
-    else begin
-      case (CONF)
-        4'd0: begin
-          mO_tvalid =  1'b0     ;
-          mO_tdata  = 32'd0     ;
-          s1_tready =  1'b0     ;
-          s2_tready =  1'b0     ;
-          s3_tready =  1'b0     ;
-          s4_tready =  1'b0     ;
-          s5_tready =  1'b0     ;
-          s6_tready =  1'b0     ;
-          s7_tready =  1'b0     ;
-          s8_tready =  1'b0     ;
-        end
-
-        4'd1: begin
-          mO_tvalid = s1_tvalid ;
-          mO_tdata  = s1_tdata  ;
-          s1_tready = mO_tready ;
-          s2_tready = 1'b0      ;
-          s3_tready = 1'b0      ;
-          s4_tready = 1'b0      ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd2: begin
-          mO_tvalid = s2_tvalid ;
-          mO_tdata  = s2_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = mO_tready ;
-          s3_tready = 1'b0      ;
-          s4_tready = 1'b0      ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd3: begin
-          mO_tvalid = s3_tvalid ;
-          mO_tdata  = s3_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = 1'b0      ;
-          s3_tready = mO_tready ;
-          s4_tready = 1'b0      ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd4: begin
-          mO_tvalid = s4_tvalid ;
-          mO_tdata  = s4_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = 1'b0      ;
-          s3_tready = 1'b0      ;
-          s4_tready = mO_tready ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd5: begin
-          mO_tvalid = s5_tvalid ;
-          mO_tdata  = s5_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = 1'b0      ;
-          s3_tready = 1'b0      ;
-          s4_tready = 1'b0      ;
-          s5_tready = mO_tready ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        default: begin
-          mO_tvalid =  1'b0     ;
-          mO_tdata  = 32'd0     ;
-          s1_tready =  1'b0     ;
-          s2_tready =  1'b0     ;
-          s3_tready =  1'b0     ;
-          s4_tready =  1'b0     ;
-          s5_tready =  1'b0     ;
-          s6_tready =  1'b0     ;
-          s7_tready =  1'b0     ;
-          s8_tready =  1'b0     ;
-        end
-      endcase
-    end
-  end
-end
-endgenerate
-//    ____   ___  ____ _____           __
-//   |  _ \ / _ \|  _ \_   _|__   _   / /_
-//   | |_) | | | | |_) || |/ __| (_) | '_ \
-//   |  __/| |_| |  _ < | |\__ \  _  | (_) |
-//   |_|    \___/|_| \_\|_||___/ (_)  \___/
-//
-generate if (NUM_PORTs == 6) begin
-  always @(*) begin
-    if (!ARESETN) begin
-      mO_tvalid =  1'b0     ;
-      mO_tdata  = 32'd0     ;
-      s1_tready =  1'b0     ;
-      s2_tready =  1'b0     ;
-      s3_tready =  1'b0     ;
-      s4_tready =  1'b0     ;
-      s5_tready =  1'b0     ;
-      s6_tready =  1'b0     ;
-      s7_tready =  1'b0     ;
-      s8_tready =  1'b0     ;
-    end
-    else begin
-      case (CONF)
-        4'd0: begin
-          mO_tvalid =  1'b0     ;
-          mO_tdata  = 32'd0     ;
-          s1_tready =  1'b0     ;
-          s2_tready =  1'b0     ;
-          s3_tready =  1'b0     ;
-          s4_tready =  1'b0     ;
-          s5_tready =  1'b0     ;
-          s6_tready =  1'b0     ;
-          s7_tready =  1'b0     ;
-          s8_tready =  1'b0     ;
-        end
-
-        4'd1: begin
-          mO_tvalid = s1_tvalid ;
-          mO_tdata  = s1_tdata  ;
-          s1_tready = mO_tready ;
-          s2_tready = 1'b0      ;
-          s3_tready = 1'b0      ;
-          s4_tready = 1'b0      ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd2: begin
-          mO_tvalid = s2_tvalid ;
-          mO_tdata  = s2_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = mO_tready ;
-          s3_tready = 1'b0      ;
-          s4_tready = 1'b0      ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd3: begin
-          mO_tvalid = s3_tvalid ;
-          mO_tdata  = s3_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = 1'b0      ;
-          s3_tready = mO_tready ;
-          s4_tready = 1'b0      ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd4: begin
-          mO_tvalid = s4_tvalid ;
-          mO_tdata  = s4_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = 1'b0      ;
-          s3_tready = 1'b0      ;
-          s4_tready = mO_tready ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd5: begin
-          mO_tvalid = s5_tvalid ;
-          mO_tdata  = s5_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = 1'b0      ;
-          s3_tready = 1'b0      ;
-          s4_tready = 1'b0      ;
-          s5_tready = mO_tready ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd6: begin
-          mO_tvalid = s6_tvalid ;
-          mO_tdata  = s6_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = 1'b0      ;
-          s3_tready = 1'b0      ;
-          s4_tready = 1'b0      ;
-          s5_tready = 1'b0      ;
-          s6_tready = mO_tready ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        default: begin
-          mO_tvalid =  1'b0     ;
-          mO_tdata  = 32'd0     ;
-          s1_tready =  1'b0     ;
-          s2_tready =  1'b0     ;
-          s3_tready =  1'b0     ;
-          s4_tready =  1'b0     ;
-          s5_tready =  1'b0     ;
-          s6_tready =  1'b0     ;
-          s7_tready =  1'b0     ;
-          s8_tready =  1'b0     ;
-        end
-      endcase
-    end
-  end
-end
-endgenerate
-//    ____   ___  ____ _____          _____
-//   |  _ \ / _ \|  _ \_   _|__   _  |___  |
-//   | |_) | | | | |_) || |/ __| (_)    / /
-//   |  __/| |_| |  _ < | |\__ \  _    / /
-//   |_|    \___/|_| \_\|_||___/ (_)  /_/
-//
-generate if (NUM_PORTs == 7) begin
-  always @(*) begin
-    if (!ARESETN) begin
-      mO_tvalid =  1'b0     ;
-      mO_tdata  = 32'd0     ;
-      s1_tready =  1'b0     ;
-      s2_tready =  1'b0     ;
-      s3_tready =  1'b0     ;
-      s4_tready =  1'b0     ;
-      s5_tready =  1'b0     ;
-      s6_tready =  1'b0     ;
-      s7_tready =  1'b0     ;
-      s8_tready =  1'b0     ;
-    end
-    else begin
-      case (CONF)
-        4'd0: begin
-          mO_tvalid =  1'b0     ;
-          mO_tdata  = 32'd0     ;
-          s1_tready =  1'b0     ;
-          s2_tready =  1'b0     ;
-          s3_tready =  1'b0     ;
-          s4_tready =  1'b0     ;
-          s5_tready =  1'b0     ;
-          s6_tready =  1'b0     ;
-          s7_tready =  1'b0     ;
-          s8_tready =  1'b0     ;
-        end
-
-        4'd1: begin
-          mO_tvalid = s1_tvalid ;
-          mO_tdata  = s1_tdata  ;
-          s1_tready = mO_tready ;
-          s2_tready = 1'b0      ;
-          s3_tready = 1'b0      ;
-          s4_tready = 1'b0      ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd2: begin
-          mO_tvalid = s2_tvalid ;
-          mO_tdata  = s2_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = mO_tready ;
-          s3_tready = 1'b0      ;
-          s4_tready = 1'b0      ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd3: begin
-          mO_tvalid = s3_tvalid ;
-          mO_tdata  = s3_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = 1'b0      ;
-          s3_tready = mO_tready ;
-          s4_tready = 1'b0      ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd4: begin
-          mO_tvalid = s4_tvalid ;
-          mO_tdata  = s4_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = 1'b0      ;
-          s3_tready = 1'b0      ;
-          s4_tready = mO_tready ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd5: begin
-          mO_tvalid = s5_tvalid ;
-          mO_tdata  = s5_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = 1'b0      ;
-          s3_tready = 1'b0      ;
-          s4_tready = 1'b0      ;
-          s5_tready = mO_tready ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd6: begin
-          mO_tvalid = s6_tvalid ;
-          mO_tdata  = s6_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = 1'b0      ;
-          s3_tready = 1'b0      ;
-          s4_tready = 1'b0      ;
-          s5_tready = 1'b0      ;
-          s6_tready = mO_tready ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd7: begin
-          mO_tvalid = s7_tvalid ;
-          mO_tdata  = s7_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = 1'b0      ;
-          s3_tready = 1'b0      ;
-          s4_tready = 1'b0      ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = mO_tready ;
-          s8_tready = 1'b0      ;
-        end
-
-        default: begin
-          mO_tvalid =  1'b0     ;
-          mO_tdata  = 32'd0     ;
-          s1_tready =  1'b0     ;
-          s2_tready =  1'b0     ;
-          s3_tready =  1'b0     ;
-          s4_tready =  1'b0     ;
-          s5_tready =  1'b0     ;
-          s6_tready =  1'b0     ;
-          s7_tready =  1'b0     ;
-          s8_tready =  1'b0     ;
-        end
-      endcase
-    end
-  end
-end
-endgenerate
-//    ____   ___  ____ _____           ___
-//   |  _ \ / _ \|  _ \_   _|__   _   ( _ )
-//   | |_) | | | | |_) || |/ __| (_)  / _ \
-//   |  __/| |_| |  _ < | |\__ \  _  | (_) |
-//   |_|    \___/|_| \_\|_||___/ (_)  \___/
-//
-generate if (NUM_PORTs == 8) begin
-  always @(*) begin
-    if (!ARESETN) begin
-      mO_tvalid =  1'b0     ;
-      mO_tdata  = 32'd0     ;
-      s1_tready =  1'b0     ;
-      s2_tready =  1'b0     ;
-      s3_tready =  1'b0     ;
-      s4_tready =  1'b0     ;
-      s5_tready =  1'b0     ;
-      s6_tready =  1'b0     ;
-      s7_tready =  1'b0     ;
-      s8_tready =  1'b0     ;
-    end
-    else begin
-      case (CONF)
-        4'd0: begin
-          mO_tvalid =  1'b0     ;
-          mO_tdata  = 32'd0     ;
-          s1_tready =  1'b0     ;
-          s2_tready =  1'b0     ;
-          s3_tready =  1'b0     ;
-          s4_tready =  1'b0     ;
-          s5_tready =  1'b0     ;
-          s6_tready =  1'b0     ;
-          s7_tready =  1'b0     ;
-          s8_tready =  1'b0     ;
-        end
-
-        4'd1: begin
-          mO_tvalid = s1_tvalid ;
-          mO_tdata  = s1_tdata  ;
-          s1_tready = mO_tready ;
-          s2_tready = 1'b0      ;
-          s3_tready = 1'b0      ;
-          s4_tready = 1'b0      ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd2: begin
-          mO_tvalid = s2_tvalid ;
-          mO_tdata  = s2_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = mO_tready ;
-          s3_tready = 1'b0      ;
-          s4_tready = 1'b0      ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd3: begin
-          mO_tvalid = s3_tvalid ;
-          mO_tdata  = s3_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = 1'b0      ;
-          s3_tready = mO_tready ;
-          s4_tready = 1'b0      ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd4: begin
-          mO_tvalid = s4_tvalid ;
-          mO_tdata  = s4_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = 1'b0      ;
-          s3_tready = 1'b0      ;
-          s4_tready = mO_tready ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd5: begin
-          mO_tvalid = s5_tvalid ;
-          mO_tdata  = s5_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = 1'b0      ;
-          s3_tready = 1'b0      ;
-          s4_tready = 1'b0      ;
-          s5_tready = mO_tready ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd6: begin
-          mO_tvalid = s6_tvalid ;
-          mO_tdata  = s6_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = 1'b0      ;
-          s3_tready = 1'b0      ;
-          s4_tready = 1'b0      ;
-          s5_tready = 1'b0      ;
-          s6_tready = mO_tready ;
-          s7_tready = 1'b0      ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd7: begin
-          mO_tvalid = s7_tvalid ;
-          mO_tdata  = s7_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = 1'b0      ;
-          s3_tready = 1'b0      ;
-          s4_tready = 1'b0      ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = mO_tready ;
-          s8_tready = 1'b0      ;
-        end
-
-        4'd8: begin
-          mO_tvalid = s8_tvalid ;
-          mO_tdata  = s8_tdata  ;
-          s1_tready = 1'b0      ;
-          s2_tready = 1'b0      ;
-          s3_tready = 1'b0      ;
-          s4_tready = 1'b0      ;
-          s5_tready = 1'b0      ;
-          s6_tready = 1'b0      ;
-          s7_tready = 1'b0      ;
-          s8_tready = mO_tready ;
-        end
-
-        default: begin
-          mO_tvalid =  1'b0     ;
-          mO_tdata  = 32'd0     ;
-          s1_tready =  1'b0     ;
-          s2_tready =  1'b0     ;
-          s3_tready =  1'b0     ;
-          s4_tready =  1'b0     ;
-          s5_tready =  1'b0     ;
-          s6_tready =  1'b0     ;
-          s7_tready =  1'b0     ;
-          s8_tready =  1'b0     ;
-        end
-      endcase
+    always @(posedge ACLK) begin
+      if (!ARESETN) begin
+        rgnt  <= 6'd0;
+        rleft <= 5'd0;
+        rlock <= 1'b0;
+        rhold <= 1'b0;
+        rhsel <= 6'd0;
+        rhnew <= 1'b0;
+        for (q = 0; q < NUM_PORTs; q = q + 1) begin
+          rgrants[q] <= 32'd0;
+          rwaits[q]  <= 32'd0;
+        end
+      end
+      else begin
+        rhold <= mO_tvalid && !mO_tready;
+        rhsel <= wsel;
+        rhnew <= wnew;
+        if (wtake) begin
+          rgnt  <= wsel;
+          rlock <= !wlast;
+          if (wlast) rleft <= (wnew ? wweight : rleft) - 5'd1;
+          else       rleft <=  wnew ? wweight : rleft;
+          if (wlast) rgrants[wsel] <= rgrants[wsel] + 32'd1;
+        end
+        for (q = 0; q < NUM_PORTs; q = q + 1)
+          if (sI_tvalid[q] && !(wtake && wsel == q)) rwaits[q] <= rwaits[q] + 32'd1;
+      end
     end
   end
-end
-endgenerate
+  endgenerate
 
 endmodule
@@ -0,0 +1,163 @@
+`timescale 1 ns / 1 ps
+//==================================================================================================
+// Performance counters of one ACC slot, next to its prctrl in jit.v.
+//
+// Counts at the 32-bit boundary of the PR region, behind the prdoor gates, each cycle in one class:
+//   active   a word crossed A, B or C
+//   blockC   C valid, not ready (output backpressure)
+//   stallA   A ready, not valid (waiting on input A)
+//   stallB   B ready, not valid
+// the rest is idle. Also words on A/B/C, the part of them that went through the crossbar (routing
+// snooped from the 0xB commands, a queued one taking effect at SWAP) and the high-water marks of the A/B/C fifos, in beats.
+//
+// 0xEn00000x on stream 50 snapshots the counters of slot n and sends the 16-word record
+//   {0xEn00000D, cycles, active, stallA, stallB, blockC, wordsA, wordsB, wordsC, xbarIn, xbarOut,
+//    hwA, hwB, hwC, {0x1D00, prid}, 0xBABEFACE}
+// on stream 50 out; bit 0 set clears the counters after the snapshot.
+//
+// prid is the operator in the PR region as the host last wrote it with 0xEn10kkkk after a load, 0
+// from the BEEF word of a PR of the slot on and after a static bitstream load, so a new host process
+// reads back what the regions hold instead of loading them all again.
+// Slots above 15 carry n[5:4] in bits 18:17 of the command and the header, as in jit_dispatch.v.
+//==================================================================================================
+module jit_perf
+(
+  input   wire  [ 5 : 0]    ID         ,
+  input   wire              CMD_VALID  ,
+  input   wire  [31 : 0]    CMD_DATA   ,
+  input   wire              SWAP       ,
+  //////////////////////////////////////
+  input   wire              A_VALID    ,
+  input   wire              A_READY    ,
+  input   wire              B_VALID    ,
+  input   wire              B_READY    ,
+  input   wire              C_VALID    ,
+  input   wire              C_READY    ,
+  input   wire              FA_PUSH    ,
+  input   wire              FA_POP     ,
+  input   wire              FB_PUSH    ,
+  input   wire              FB_POP     ,
+  input   wire              FC_PUSH    ,
+  input   wire              FC_POP     ,
+  //////////////////////////////////////
+  input   wire              mO_tready  ,
+  output  wire              mO_tvalid  ,
+  output  wire  [31 : 0]    mO_tdata   ,
+  //////////////////////////////////////
+  input   wire              clk        ,
+  input   wire              rstn
+);
+
+  localparam NUM_CNTs = 13;
+
+  reg   [31 : 0]    rcnt  [0 : NUM_CNTs - 1];
+  reg   [31 : 0]    rsnap [0 : NUM_CNTs - 1];
+  reg   [15 : 0]    roccA ;
+  reg   [15 : 0]    roccB ;
+  reg   [15 : 0]    roccC ;
+  reg               rxA   ;
+  reg               rxB   ;
+  reg               rxC   ;
+  reg               rsA   ;  // routing of the queued job
+  reg               rsB   ;
+  reg               rsC   ;
+  reg               rsend ;
+  reg   [ 3 : 0]    ridx  ;
+  reg   [15 : 0]    rprid ;
+
+  wire              wA    = A_VALID & A_READY;
+  wire              wB    = B_VALID & B_READY;
+  wire              wC    = C_VALID & C_READY;
+  wire              wPerf = CMD_VALID && CMD_DATA[31:28] == 4'hE && {CMD_DATA[18:17], CMD_DATA[27:24]} == ID && CMD_DATA[23:20] == 4'd0;
+  wire              wPrid = CMD_VALID && CMD_DATA[31:28] == 4'hE && {CMD_DATA[18:17], CMD_DATA[27:24]} == ID && CMD_DATA[23:20] == 4'd1;
+  wire              wBeef = CMD_VALID && CMD_DATA == {4'hD, ID[3:0], 5'h0, ID[5:4], 1'b0, 16'hBEEF};
+  wire              wTie  = CMD_VALID && CMD_DATA[31:28] == 4'hB && {CMD_DATA[18:17], CMD_DATA[27:24]} == ID && !CMD_DATA[16];
+  wire              wQue  = CMD_VALID && CMD_DATA[31:28] == 4'hB && {CMD_DATA[18:17], CMD_DATA[27:24]} == ID &&  CMD_DATA[16];
+  wire  [15 : 0]    wOccA = roccA + FA_PUSH - FA_POP;
+  wire  [15 : 0]    wOccB = roccB + FB_PUSH - FB_POP;
+  wire  [15 : 0]    wOccC = roccC + FC_PUSH - FC_POP;
+
+  assign mO_tvalid = rsend;
+  assign mO_tdata  = (ridx == 4'd0)      ? {4'hE, ID[3:0], 5'd0, ID[5:4], 13'd0, 4'hD} :
+                     (ridx <= NUM_CNTs)  ? rsnap[ridx - 1]         :
+                     (ridx == 4'd14)     ? {16'h1D00, rprid}       : 32'hBABEFACE;
+
+  integer i;
+  always @(posedge clk) begin
+    if (!rstn) begin
+      for (i = 0; i < NUM_CNTs; i = i + 1) begin
+        rcnt[i]  <= 32'd0;
+        rsnap[i] <= 32'd0;
+      end
+      roccA <= 16'd0;
+      roccB <= 16'd0;
+      roccC <= 16'd0;
+      rxA   <= 1'b0;
+      rxB   <= 1'b0;
+      rxC   <= 1'b0;
+      rsA   <= 1'b0;
+      rsB   <= 1'b0;
+      rsC   <= 1'b0;
+      rsend <= 1'b0;
+      ridx  <= 4'd0;
+      rprid <= 16'd0;
+    end
+    else begin
+      if      (wBeef) rprid <= 16'd0;
+      else if (wPrid) rprid <= CMD_DATA[15:0];
+
+      roccA <= wOccA;
+      roccB <= wOccB;
+      roccC <= wOccC;
+
+      if (wTie) begin
+        rxA <= {CMD_DATA[13:12], CMD_DATA[ 3: 0]} != 6'd0;
+        rxB <= {CMD_DATA[15:14], CMD_DATA[ 7: 4]} != 6'd0;
+        rxC <= CMD_DATA[11: 9] == 3'b111;       // F, or E to the host as well
+      end
+      if (wQue) begin
+        rsA <= {CMD_DATA[13:12], CMD_DATA[ 3: 0]} != 6'd0;
+        rsB <= {CMD_DATA[15:14], CMD_DATA[ 7: 4]} != 6'd0;
+        rsC <= CMD_DATA[11: 9] == 3'b111;
+      end
+      if (SWAP) begin
+        rxA <= rsA;
+        rxB <= rsB;
+        rxC <= rsC;
+      end
+
+      if (wPerf && !rsend) begin
+        for (i = 0; i < NUM_CNTs; i = i + 1) rsnap[i] <= rcnt[i];
+        rsend <= 1'b1;
+        ridx  <= 4'd0;
+      end
+      else if (rsend && mO_tready) begin
+        ridx  <= ridx + 4'd1;
+        if (ridx == 4'd15) rsend <= 1'b0;
+      end
+
+      if (wPerf && !rsend && CMD_DATA[0]) begin
+        for (i = 0; i < 10; i = i + 1) rcnt[i] <= 32'd0;
+        rcnt[10] <= {16'd0, wOccA};
+        rcnt[11] <= {16'd0, wOccB};
+        rcnt[12] <= {16'd0, wOccC};
+      end
+      else begin
+        rcnt[0] <= rcnt[0] + 32'd1;
+        if      (wA || wB || wC)      rcnt[1] <= rcnt[1] + 32'd1;
+        else if (C_VALID && !C_READY) rcnt[4] <= rcnt[4] + 32'd1;
+        else if (A_READY && !A_VALID) rcnt[2] <= rcnt[2] + 32'd1;
+        else if (B_READY && !B_VALID) rcnt[3] <= rcnt[3] + 32'd1;
+        rcnt[5] <= rcnt[5] + wA;
+        rcnt[6] <= rcnt[6] + wB;
+        rcnt[7] <= rcnt[7] + wC;
+        rcnt[8] <= rcnt[8] + (wA & rxA) + (wB & rxB);
+        rcnt[9] <= rcnt[9] + (wC & rxC);
+        if (wOccA > rcnt[10]) rcnt[10] <= {16'd0, wOccA};
+        if (wOccB > rcnt[11]) rcnt[11] <= {16'd0, wOccB};
+        if (wOccC > rcnt[12]) rcnt[12] <= {16'd0, wOccC};
+      end
+    end
+  end
+
+endmodule
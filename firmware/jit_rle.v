@@ -0,0 +1,107 @@
+`timescale 1 ns / 1 ps
+//==================================================================================================
+// Run-length decoder in front of the ICAP, for the compressed partial bitstreams of pr.c.
+//
+// JIT_RLE_MAGIC as the first word of an image, after reset or after RESTART (the 0xDn00BEEF PR start
+// of a slot on stream 50), starts a compressed image: a sequence of packets, each a header word
+// {op[31:28], count[27:0]},
+//   0x0   count words follow, passed through
+//   0x1   count words 0x00000000
+//   0x2   count words 0xFFFFFFFF
+//   0x3   the next word, count times
+//   0xF   end of the image, back to pass-through
+// Any other first word, and every word after it up to the next RESTART, passes through unchanged,
+// MAGIC included, so an uncompressed bitstream holding that word is not decoded. RESTART also
+// drops a compressed image cut short by the host. A count of 0 is a no-op. One word leaves per
+// cycle inside a packet, a header or the word of a 0x3 packet costs a cycle, so a bitstream goes to
+// the ICAP at about its rate while the host sends a fraction of it.
+//==================================================================================================
+module jit_rle #
+(
+  parameter [31:0] MAGIC = 32'h524C4531   // "RLE1"
+)
+(
+  output  wire             sI_tready  ,
+  input   wire             sI_tvalid  ,
+  input   wire  [31 : 0]   sI_tdata   ,
+
+  input   wire             mO_tready  ,
+  output  wire             mO_tvalid  ,
+  output  wire  [31 : 0]   mO_tdata   ,
+
+  input   wire             RESTART    ,   // one cycle: the next word is the first of an image
+
+  input   wire             ACLK       ,
+  input   wire             ARESETN
+);
+
+  localparam [2:0]  RAW  = 0,   // pass-through
+                    HDR  = 1,   // next packet header
+                    LIT  = 2,   // rcnt words passed through
+                    REPV = 3,   // word of a 0x3 packet
+                    RUN  = 4,   // rval rcnt times
+                    FRST = 5;   // first word of an image: MAGIC or pass-through
+  reg   [ 2 : 0]   state;
+  reg   [27 : 0]   rcnt ;
+  reg   [31 : 0]   rval ;
+
+  wire  [ 3 : 0]   wop  = sI_tdata[31:28];
+  wire  [27 : 0]   wcnt = sI_tdata[27: 0];
+
+  assign sI_tready = (state == FRST && sI_tdata == MAGIC) ? 1'b1      :
+                     (state == RAW || state == FRST || state == LIT) ? mO_tready :
+                     (state == HDR || state == REPV);
+  assign mO_tvalid = (state == FRST && sI_tvalid && sI_tdata != MAGIC) ||
+                     (state == RAW  && sI_tvalid) ||
+                     (state == LIT  && sI_tvalid) || (state == RUN);
+  assign mO_tdata  = (state == RUN) ? rval : sI_tdata;
+
+  always @(posedge ACLK) begin
+    if (!ARESETN) begin
+      state <= FRST;
+      rcnt  <= 28'd0;
+      rval  <= 32'd0;
+    end
+    else if (RESTART) begin
+      state <= FRST;
+    end
+    else begin
+      case (state)
+        FRST : if (sI_tvalid && sI_tdata == MAGIC) state <= HDR;
+               else if (sI_tvalid && mO_tready) state <= RAW;
+
+        RAW  : state <= RAW;    // until RESTART
+
+        HDR  : if (sI_tvalid) begin
+          rcnt <= wcnt;
+          case (wop)
+            4'h0    : state <= (wcnt == 28'd0) ? HDR : LIT;
+            4'h1    : begin rval <= 32'h00000000; state <= (wcnt == 28'd0) ? HDR : RUN; end
+            4'h2    : begin rval <= 32'hFFFFFFFF; state <= (wcnt == 28'd0) ? HDR : RUN; end
+            4'h3    : state <= REPV;
+            4'hF    : state <= RAW;
+            default : state <= HDR;
+          endcase
+        end
+
+        LIT  : if (sI_tvalid && mO_tready) begin
+          rcnt <= rcnt - 28'd1;
+          if (rcnt == 28'd1) state <= HDR;
+        end
+
+        REPV : if (sI_tvalid) begin
+          rval  <= sI_tdata;
+          state <= (rcnt == 28'd0) ? HDR : RUN;
+        end
+
+        RUN  : if (mO_tready) begin
+          rcnt <= rcnt - 28'd1;
+          if (rcnt == 28'd1) state <= HDR;
+        end
+
+        default : state <= RAW;
+      endcase
+    end
+  end
+
+endmodule
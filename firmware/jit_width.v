@@ -0,0 +1,206 @@
+`timescale 1 ns / 1 ps
+//==================================================================================================
+// Stream width blocks of the DW-bit datapath (jit.v parameter DW, 32 or 128).
+//
+//   jit_fifo_w   DW-bit fifo made of DW/32 jit_fifo lanes moving together, no new IP needed
+//   jit_dw_down  DW -> 32 in front of the PR region, lane 0 first. CLR (the ap_done of the
+//                region) drops what is left of a beat the job did not use: the host pads every
+//                transfer to whole beats, the padding never reaches the next job
+//   jit_dw_up    32 -> DW behind the PR region. FLUSH (the same ap_done) sends a partial last beat,
+//                the unused lanes zero
+//
+// With DW = 32 the three blocks are wires, a jit_fifo and wires.
+//==================================================================================================
+// jit_fifo_w
+//==================================================================================================
+module jit_fifo_w #
+(
+  parameter DW = 32
+)
+(
+  output  wire                s_axis_tready  ,
+  input   wire                s_axis_tvalid  ,
+  input   wire  [DW-1 : 0]    s_axis_tdata   ,
+  input   wire                m_axis_tready  ,
+  output  wire                m_axis_tvalid  ,
+  output  wire  [DW-1 : 0]    m_axis_tdata   ,
+
+  input   wire                s_aclk         ,
+  input   wire                m_aclk         ,
+  input   wire                s_aresetn
+);
+
+  localparam L = DW / 32;
+
+  wire  [L-1 : 0]   wlane_rdy   ;
+  wire  [L-1 : 0]   wlane_valid ;
+
+  assign s_axis_tready = &wlane_rdy  ;
+  assign m_axis_tvalid = &wlane_valid;
+
+  genvar i;
+  generate for (i = 0; i < L; i = i + 1) begin : lane
+    jit_fifo     u_fifo (
+      .s_axis_tready  (wlane_rdy[i]                    ),
+      .s_axis_tvalid  (s_axis_tvalid & s_axis_tready   ),
+      .s_axis_tdata   (s_axis_tdata[32 * i + 31 : 32 * i]),
+      .m_axis_tready  (m_axis_tready & m_axis_tvalid   ),
+      .m_axis_tvalid  (wlane_valid[i]                  ),
+      .m_axis_tdata   (m_axis_tdata[32 * i + 31 : 32 * i]),
+      //--------------(--------------------------------),
+      .s_aclk         (s_aclk                          ),
+      .m_aclk         (m_aclk                          ),
+      .s_aresetn      (s_aresetn                       )
+    );
+  end
+  endgenerate
+
+endmodule
+//==================================================================================================
+// jit_dw_down
+//==================================================================================================
+module jit_dw_down #
+(
+  parameter DW = 32
+)
+(
+  output  wire                sI_tready  ,
+  input   wire                sI_tvalid  ,
+  input   wire  [DW-1 : 0]    sI_tdata   ,
+  input   wire                mO_tready  ,
+  output  wire                mO_tvalid  ,
+  output  wire  [31 : 0]      mO_tdata   ,
+
+  input   wire                CLR        ,
+
+  input   wire                ACLK       ,
+  input   wire                ARESETN
+);
+
+  localparam L = DW / 32;
+
+generate if (L == 1) begin : pass
+  assign sI_tready = mO_tready;
+  assign mO_tvalid = sI_tvalid;
+  assign mO_tdata  = sI_tdata ;
+end
+else begin : conv
+  reg   [DW-1 : 0]    rbeat ;
+  reg                 rfull ;
+  reg   [ 2 : 0]      ridx  ;
+
+  // the next beat is taken while the last lane of this one leaves
+  assign sI_tready = !rfull || (mO_tready && ridx == L - 1);
+  assign mO_tvalid = rfull;
+  assign mO_tdata  = rbeat[31 : 0];
+
+  always @(posedge ACLK) begin
+    if (!ARESETN) begin
+      rbeat <= {DW{1'b0}};
+      rfull <= 1'b0;
+      ridx  <= 3'd0;
+    end
+    else if (CLR && ridx != 3'd0) begin
+      rfull <= 1'b0;
+      ridx  <= 3'd0;
+    end
+    else begin
+      if (rfull && mO_tready) begin
+        if (ridx == L - 1) begin
+          rfull <= 1'b0;
+          ridx  <= 3'd0;
+        end
+        else begin
+          rbeat <= rbeat >> 32;
+          ridx  <= ridx + 3'd1;
+        end
+      end
+      if (sI_tvalid && sI_tready) begin
+        rbeat <= sI_tdata;
+        rfull <= 1'b1;
+        ridx  <= 3'd0;
+      end
+    end
+  end
+end
+endgenerate
+
+endmodule
+//==================================================================================================
+// jit_dw_up
+//==================================================================================================
+module jit_dw_up #
+(
+  parameter DW = 32
+)
+(
+  output  wire                sI_tready  ,
+  input   wire                sI_tvalid  ,
+  input   wire  [31 : 0]      sI_tdata   ,
+  input   wire                mO_tready  ,
+  output  wire                mO_tvalid  ,
+  output  wire  [DW-1 : 0]    mO_tdata   ,
+
+  input   wire                FLUSH      ,
+
+  input   wire                ACLK       ,
+  input   wire                ARESETN
+);
+
+  localparam L = DW / 32;
+
+generate if (L == 1) begin : pass
+  assign sI_tready = mO_tready;
+  assign mO_tvalid = sI_tvalid;
+  assign mO_tdata  = sI_tdata ;
+end
+else begin : conv
+  reg   [DW-1 : 0]    rbeat  ;
+  reg                 rfull  ;
+  reg                 rflush ;
+  reg   [ 2 : 0]      rcnt   ;
+
+  assign sI_tready = !rfull || mO_tready;
+  assign mO_tvalid = rfull;
+  assign mO_tdata  = rbeat;
+
+  always @(posedge ACLK) begin
+    if (!ARESETN) begin
+      rbeat  <= {DW{1'b0}};
+      rfull  <= 1'b0;
+      rflush <= 1'b0;
+      rcnt   <= 3'd0;
+    end
+    else begin
+      if (rfull && mO_tready) begin
+        rbeat <= {DW{1'b0}};
+        rfull <= 1'b0;
+      end
+      // the region is done and its last word is in: send what is there
+      if (!sI_tvalid && (rflush || FLUSH)) begin
+        rflush <= 1'b0;
+        if (rcnt != 3'd0) begin
+          rfull <= 1'b1;
+          rcnt  <= 3'd0;
+        end
+      end
+      else if (FLUSH) begin
+        rflush <= 1'b1;
+      end
+      if (sI_tvalid && sI_tready) begin
+        rbeat[rcnt * 32 +: 32] <= sI_tdata;
+        if (rcnt == L - 1) begin
+          rfull  <= 1'b1;
+          rflush <= 1'b0;
+          rcnt   <= 3'd0;
+        end
+        else begin
+          rcnt   <= rcnt + 3'd1;
+        end
+      end
+    end
+  end
+end
+endgenerate
+
+endmodule
@@ -32,6 +32,12 @@ typedef struct
 
 XHwIcap_Bit_Header XHwIcap_ReadHeader(u8 *Data, u32 Size);
 
+// Run-length packets of jit_rle.v: header {op[31:28], count[27:0]}, 0x0 count literal words follow,
+// 0x1 / 0x2 count words 0x00000000 / 0xFFFFFFFF, 0x3 the next word count times, 0xF end
+#define RLE_MAGIC 0x524C4531
+#define RLE_MAX   0x0FFFFFFF
+int rle_pack(u32 *in, int n, u32 *out);
+
 #define xil_printf printf
 
 int main()
@@ -102,6 +108,15 @@ int main()
   //   pr_buffer[i+2] = tmp;
   // }
 
+  // compressed for jit_rle.v, padded again to 16 words: pass-through words after the end packet
+  u32 *rle_buffer = (u32 *)malloc(sizeof(u32) * (2 * new_len + 32));
+  int rle_len = rle_pack(pr_buffer, new_len, rle_buffer);
+  printf("Compressed:       %d -> %d words\r\n", new_len, rle_len);
+  while (rle_len & 0xf) rle_buffer[rle_len++] = 0xffffffff;
+  free(pr_buffer);
+  pr_buffer = rle_buffer;
+  new_len   = rle_len;
+
   fprintf(file, "%s %d;\r\n", len, new_len);
   fprintf(file, "%s\r\n", str_tmp);
 
@@ -122,6 +137,38 @@ int main()
   return 0;
 }
 
+// Returns the words written to out, at most 2 * n + 3
+int rle_pack(u32 *in, int n, u32 *out)
+{
+  int i = 0, o = 0, r, lit;
+
+  out[o++] = RLE_MAGIC;
+  while (i < n) {
+    for (r = 1; i + r < n && r < RLE_MAX && in[i + r] == in[i]; r++);
+    if (r >= 2 && (in[i] == 0x00000000 || in[i] == 0xffffffff)) {
+      out[o++] = (in[i] == 0 ? 0x10000000 : 0x20000000) | r;
+      i += r;
+      continue;
+    }
+    if (r >= 3) {
+      out[o++] = 0x30000000 | r;
+      out[o++] = in[i];
+      i += r;
+      continue;
+    }
+    // literal words up to the next run worth a packet
+    lit = o++;
+    for (r = 0; i < n && r < RLE_MAX; r++) {
+      if (i + 1 < n && in[i + 1] == in[i] && (in[i] == 0x00000000 || in[i] == 0xffffffff)) break;
+      if (i + 2 < n && in[i + 1] == in[i] && in[i + 2] == in[i]) break;
+      out[o++] = in[i++];
+    }
+    out[lit] = 0x00000000 | r;
+  }
+  out[o++] = 0xF0000000;
+  return o;
+}
+
 XHwIcap_Bit_Header XHwIcap_ReadHeader(u8 *Data, u32 Size)
 {
     u32 I;
@@ -2,7 +2,7 @@ module prctrl #(
   parameter DWIDTH = 32
 )
 (
-  input   wire  [         3 : 0]    ID                     ,
+  input   wire  [         5 : 0]    ID                     ,
   input   wire                      PR_VALID               ,
   input   wire  [DWIDTH - 1 : 0]    PR_DATA                ,
   //////////////////////////////////////////////////////////
@@ -32,8 +32,8 @@ wire       End_Condition;
 // assign     Start_Condition = (wType == 4'hD && wAccn == ID && wCmd == 16'hBEEF && PR_VALID == 1'b1);
 // assign       End_Condition = (wType == 4'hD && wAccn == ID && wCmd == 16'hDEAD && PR_VALID == 1'b1);
 
-assign  Start_Condition = ((PR_DATA == {4'hD, ID[3:0], 8'h0, 16'hBEEF} && PR_VALID == 1'b1) ? 1'b1 : 1'b0);
-assign    End_Condition = ((PR_DATA == {4'hD, ID[3:0], 8'h0, 16'hDEAD} && PR_VALID == 1'b1) ? 1'b1 : 1'b0);
+assign  Start_Condition = ((PR_DATA == {4'hD, ID[3:0], 5'h0, ID[5:4], 1'b0, 16'hBEEF} && PR_VALID == 1'b1) ? 1'b1 : 1'b0);
+assign    End_Condition = ((PR_DATA == {4'hD, ID[3:0], 5'h0, ID[5:4], 1'b0, 16'hDEAD} && PR_VALID == 1'b1) ? 1'b1 : 1'b0);
 
 // assign Start_Condition = (PR_DATA  == {124'hBABEFACEDEADBEEFDEADBEEF0000000, ID[3:0]} ? 1'b1: 1'b0);
 // assign End_Condition   = (PR_DATA  == {128'hBABEFACEDEADBEEFDEADBEEF0000001, ID[3:0]} ? 1'b1: 1'b0);
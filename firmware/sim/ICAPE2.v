@@ -0,0 +1,16 @@
+`timescale 1 ns / 1 ps
+// Lint stand-in for the 7-series ICAP primitive.
+module ICAPE2 #(
+  parameter ICAP_WIDTH = "X32"
+)
+(
+  input   wire            CLK    ,
+  output  wire            O      ,
+  input   wire            CSIB   ,
+  input   wire            RDWRB  ,
+  input   wire  [31 : 0]  I
+);
+
+assign O = 1'b0;
+
+endmodule
@@ -0,0 +1,17 @@
+`timescale 1 ns / 1 ps
+// Lint stand-in for the jit_clk clocking wizard, the output clock is the input clock.
+module jit_clk (
+  input   wire  clk_in1   ,
+  output  wire  clk_out1  ,
+  input   wire  reset     ,
+  output  reg   locked
+);
+
+assign clk_out1 = clk_in1;
+
+always @(posedge clk_in1)
+begin
+  locked <= !reset;
+end
+
+endmodule
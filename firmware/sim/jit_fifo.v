@@ -0,0 +1,53 @@
+`timescale 1 ns / 1 ps
+// Lint stand-in for the jit_fifo IP (jit_fifo.xci: AXIS, 1024 x 32 bit), a single clock FIFO on
+// s_aclk.
+module jit_fifo #(
+  parameter DWIDTH  = 32,
+  parameter DEPTH   = 1024,
+  parameter AWIDTH  = 10
+)
+(
+  output  wire                    s_axis_tready  ,
+  input   wire                    s_axis_tvalid  ,
+  input   wire  [DWIDTH - 1 : 0]  s_axis_tdata   ,
+  input   wire                    m_axis_tready  ,
+  output  wire                    m_axis_tvalid  ,
+  output  wire  [DWIDTH - 1 : 0]  m_axis_tdata   ,
+  //////////////////////////////////////////////
+  input   wire                    s_aclk         ,
+  input   wire                    m_aclk         ,
+  input   wire                    s_aresetn
+);
+
+reg  [DWIDTH - 1 : 0]  mem [0 : DEPTH - 1];
+reg  [AWIDTH     : 0]  wptr;
+reg  [AWIDTH     : 0]  rptr;
+wire [AWIDTH     : 0]  level;
+wire                   push;
+wire                   pop;
+
+assign level         = wptr - rptr;
+assign s_axis_tready = (level != DEPTH) && s_aresetn;
+assign m_axis_tvalid = (level != 0);
+assign m_axis_tdata  = mem[rptr[AWIDTH - 1 : 0]];
+assign push          = s_axis_tvalid && s_axis_tready;
+assign pop           = m_axis_tvalid && m_axis_tready;
+
+always @(posedge s_aclk)
+begin
+  if (!s_aresetn) begin
+    wptr <= 0;
+    rptr <= 0;
+  end
+  else begin
+    if (push) begin
+      mem[wptr[AWIDTH - 1 : 0]] <= s_axis_tdata;
+      wptr <= wptr + 1'b1;
+    end
+    if (pop) begin
+      rptr <= rptr + 1'b1;
+    end
+  end
+end
+
+endmodule
@@ -0,0 +1,17 @@
+`timescale 1 ns / 1 ps
+// Lint stand-in for the jit_reset processor system reset IP.
+module jit_reset (
+  input   wire  slowest_sync_clk   ,
+  input   wire  ext_reset_in       ,
+  input   wire  aux_reset_in       ,
+  input   wire  mb_debug_sys_rst   ,
+  input   wire  dcm_locked         ,
+  output  reg   peripheral_aresetn
+);
+
+always @(posedge slowest_sync_clk)
+begin
+  peripheral_aresetn <= !ext_reset_in && !aux_reset_in && !mb_debug_sys_rst && dcm_locked;
+end
+
+endmodule
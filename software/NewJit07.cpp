@@ -0,0 +1,211 @@
+#include <iostream>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <stdio.h>
+#include <picodrv.h>
+#include <pico_errors.h>
+#include <sys/time.h>
+#include <pthread.h>
+#include <cmath>
+#include <locale.h>
+#include <algorithm>
+
+using namespace std;
+
+//#define VERBOSE
+//#define VERBOSE_THREAD
+#include "jit_isa.h"
+#include "jit_sort.h"
+#include "jit_xsort.h"
+
+// Sort benchmark: std::sort and the MergeSort of NewJit05 against vsort of jit_sort.h
+// #define SIZE 32
+// #define SIZE 0x10000
+#define SIZE    (1024 * 1024 * 16)
+
+void Merge(int *A,int *L,int leftCount,int *R,int rightCount) {
+  int i,j,k;
+  i = 0; j = 0; k =0;
+
+  while(i<leftCount && j< rightCount) {
+    if(L[i]  < R[j]) A[k++] = L[i++];
+    else A[k++] = R[j++];
+  }
+  while(i < leftCount) A[k++] = L[i++];
+  while(j < rightCount) A[k++] = R[j++];
+}
+
+void MergeSort(int *A, int n) {
+  int mid,i, *L, *R;
+  if(n < 2) return;
+
+  mid = n/2;
+  L = (int*)malloc(mid*sizeof(int));
+  R = (int*)malloc((n- mid)*sizeof(int));
+
+  for(i = 0;i<mid;i++) L[i] = A[i];
+  for(i = mid;i<n;i++) R[i-mid] = A[i];
+
+  MergeSort(L,mid);
+  MergeSort(R,n-mid);
+  Merge(A,L,mid,R,n-mid);
+  free(L);
+  free(R);
+}
+
+int check(int *A, int *Ref, const char *name)
+{
+  int i;
+  for (i = 0; i < SIZE; i++) {
+    if (A[i] != Ref[i]) {
+      printf("%s: Error at %d, 0x%08x != 0x%08x\r\n", name, i, A[i], Ref[i]);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+int main(int argc, char* argv[])
+{
+  printf("Begin...\r\n");
+  setlocale(LC_NUMERIC, ""); // for thounds seperator
+  printf("%'d\r\n", SIZE);
+
+  struct timeval start, end;
+  int timeuse;
+  int i;
+  int errors = 0;
+
+  int *Src = new int[SIZE];
+  int *Ref = new int[SIZE];
+  int *A   = new int[SIZE];
+
+  srand(1);
+  for (i = 0; i < SIZE; i++) {
+    Src[i] = (rand() << 1) ^ rand();
+    if (Src[i] == (int)0xDEADBEEF) Src[i] = 0;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  memcpy(Ref, Src, SIZE * 4);
+  gettimeofday(&start, NULL);
+  sort(Ref, Ref + SIZE);
+  gettimeofday(&end, NULL);
+  timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+  printf("std::sort          :\t%'12d us\t%8.1f MKeys/s\r\n", timeuse, (double)SIZE / timeuse);
+
+  memcpy(A, Src, SIZE * 4);
+  gettimeofday(&start, NULL);
+  MergeSort(A, SIZE);
+  gettimeofday(&end, NULL);
+  timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+  printf("MergeSort          :\t%'12d us\t%8.1f MKeys/s\r\n", timeuse, (double)SIZE / timeuse);
+  errors += check(A, Ref, "MergeSort");
+
+  memcpy(A, Src, SIZE * 4);
+  gettimeofday(&start, NULL);
+  vcpu_run(INSERTION, A, NULL, A, SIZE, 0, vcpu_threads());
+  gettimeofday(&end, NULL);
+  timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+  printf("CPU %'4d threads   :\t%'12d us\t%8.1f MKeys/s\r\n", vcpu_threads(), timeuse, (double)SIZE / timeuse);
+  errors += check(A, Ref, "vcpu");
+  //////////////////////////////////////////////////////////////////////////////
+  vam_vm_t VM;
+  VM.VAM_TABLE = NULL;
+  VM.BITSTREAM_TABLE = NULL;
+  VAM_VM_INIT(&VM, argc, argv);
+
+  memcpy(A, Src, SIZE * 4);
+  gettimeofday(&start, NULL);
+  vsort(&VM, A, SIZE, VSORT_HOST);
+  gettimeofday(&end, NULL);
+  timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+  printf("vsort host merge   :\t%'12d us\t%8.1f MKeys/s\r\n", timeuse, (double)SIZE / timeuse);
+  errors += check(A, Ref, "vsort host merge");
+
+  memcpy(A, Src, SIZE * 4);
+  gettimeofday(&start, NULL);
+  vsort(&VM, A, SIZE, VSORT_CARD);
+  gettimeofday(&end, NULL);
+  timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+  printf("vsort card merge   :\t%'12d us\t%8.1f MKeys/s\r\n", timeuse, (double)SIZE / timeuse);
+  errors += check(A, Ref, "vsort card merge");
+
+  // VCPU_PADDING is a legal key: it must sort by its value, not end up at the tail
+  int Pad[5]    = {3, (int)0xDEADBEEF, -1000000000, 7, 0};
+  int PadRef[5] = {3, (int)0xDEADBEEF, -1000000000, 7, 0};
+  sort(PadRef, PadRef + 5);
+  vsort(&VM, Pad, 5, VSORT_HOST);
+  for (i = 0; i < 5; i++) {
+    if (Pad[i] != PadRef[i]) {
+      printf("vsort padding small: Error at %d, 0x%08x != 0x%08x\r\n", i, Pad[i], PadRef[i]);
+      errors++;
+      break;
+    }
+  }
+
+  for (i = 0; i < SIZE; i += 4099) Src[i] = (int)0xDEADBEEF;
+  memcpy(Ref, Src, SIZE * 4);
+  sort(Ref, Ref + SIZE);
+  memcpy(A, Src, SIZE * 4);
+  gettimeofday(&start, NULL);
+  vsort(&VM, A, SIZE, VSORT_HOST);
+  gettimeofday(&end, NULL);
+  timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+  printf("vsort with padding :\t%'12d us\t%8.1f MKeys/s\r\n", timeuse, (double)SIZE / timeuse);
+  errors += check(A, Ref, "vsort with padding");
+
+  // vxsort sorts its runs with vsort: 1M words holding -559038737 through a 1 MB budget, 12 runs
+  int   XN = 1024 * 1024;
+  Src[1] = -559038737;                      // 0xDEADBEEF as the signed key
+  FILE *fp = fopen("/tmp/NewJit07_xsort.in", "wb");
+  if (fp != NULL) {
+    fwrite(Src, 4, XN, fp);
+    fclose(fp);
+  }
+  memcpy(Ref, Src, XN * 4);
+  sort(Ref, Ref + XN);
+  gettimeofday(&start, NULL);
+  int err = vxsort(&VM, "/tmp/NewJit07_xsort.in", "/tmp/NewJit07_xsort.out", 1 << 20);
+  gettimeofday(&end, NULL);
+  timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+  printf("vxsort with padding:\t%'12d us\t%8.1f MKeys/s\r\n", timeuse, (double)XN / timeuse);
+  fp = fopen("/tmp/NewJit07_xsort.out", "rb");
+  if (err != 0 || fp == NULL || (int)fread(A, 4, XN, fp) != XN) {
+    printf("vxsort with padding: Error, err:%d\r\n", err);
+    errors++;
+  } else {
+    for (i = 0; i < XN; i++) {
+      if (A[i] != Ref[i]) {
+        printf("vxsort with padding: Error at %d, 0x%08x != 0x%08x\r\n", i, A[i], Ref[i]);
+        errors++;
+        break;
+      }
+    }
+  }
+  if (fp != NULL) fclose(fp);
+
+  // errors come back as -1: a file cut inside a word, and a single run written to a full disk
+  if (truncate("/tmp/NewJit07_xsort.in", 4 * 1000 + 2) == 0 &&
+      vxsort(&VM, "/tmp/NewJit07_xsort.in", "/tmp/NewJit07_xsort.out", 1 << 20) != -1) {
+    printf("vxsort partial word: Error, not rejected\r\n");
+    errors++;
+  }
+  if (truncate("/tmp/NewJit07_xsort.in", 4 * 1000) == 0 &&
+      vxsort(&VM, "/tmp/NewJit07_xsort.in", "/dev/full", 1 << 20) != -1) {
+    printf("vxsort to /dev/full: Error, write failure not returned\r\n");
+    errors++;
+  }
+  remove("/tmp/NewJit07_xsort.in");
+  remove("/tmp/NewJit07_xsort.out");
+
+  VAM_VM_CLEAN(&VM);
+  delete[] Src;
+  delete[] Ref;
+  delete[] A;
+
+  if (errors == 0) printf("Passed\r\n");
+  else             printf("Failed\r\n");
+  return 0;
+}
@@ -0,0 +1,117 @@
+#include <iostream>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <stdio.h>
+#include <picodrv.h>
+#include <pico_errors.h>
+#include <sys/time.h>
+#include <pthread.h>
+#include <cmath>
+#include <locale.h>
+#include <algorithm>
+
+using namespace std;
+
+//#define VERBOSE
+//#define VERBOSE_THREAD
+#include "jit_isa.h"
+#include "jit_sql.h"
+
+// Column scan benchmark: SELECT A WHERE A < K and SELECT AVG(A) WHERE A > K, scalar loop and the
+// SIMD scan of jit_cpu.h against SQLLESS/SQLLARGE/SQLAVG of jit_sql.h
+// #define SIZE 32
+// #define SIZE 0x10000
+#define SIZE    (1024 * 1024 * 16)
+#define K       100
+#define TAIL_NODES 2
+
+int elapsed(struct timeval *start)
+{
+  struct timeval end;
+  gettimeofday(&end, NULL);
+  return 1000000 * (end.tv_sec - start->tv_sec) + end.tv_usec - start->tv_usec;
+}
+
+int main(int argc, char* argv[])
+{
+  printf("Begin...\r\n");
+  setlocale(LC_NUMERIC, ""); // for thounds seperator
+  printf("%'d\r\n", SIZE);
+
+  struct timeval start;
+  int timeuse;
+  int i, n, err, ref_n = 0;
+  int errors = 0;
+  int64_t ref_sum = 0, ref_count = 0;
+  vsql_agg_t agg;
+
+  int *A   = new int[SIZE];
+  int *Ref = new int[SIZE];
+  int *C   = new int[SIZE];
+  int *Sel = new int[SIZE];
+
+  srand(1);
+  for (i = 0; i < SIZE; i++) A[i] = rand() % 2001 - 1000;
+
+  //////////////////////////////////////////////////////////////////////////////
+  gettimeofday(&start, NULL);
+  for (i = 0; i < SIZE; i++)
+    if (A[i] < K) Ref[ref_n++] = A[i];
+  timeuse = elapsed(&start);
+  printf("scalar filter      :\t%'12d us\t%8.1f MRows/s\t%'d rows\r\n", timeuse, (double)SIZE / timeuse, ref_n);
+
+  gettimeofday(&start, NULL);
+  for (i = 0; i < SIZE; i++)
+    if (A[i] > K) { ref_sum += A[i]; ref_count++; }
+  timeuse = elapsed(&start);
+  printf("scalar avg         :\t%'12d us\t%8.1f MRows/s\tavg %d\r\n", timeuse, (double)SIZE / timeuse, (int)(ref_sum / ref_count));
+  //////////////////////////////////////////////////////////////////////////////
+  vam_vm_t VM;
+  VM.VAM_TABLE = NULL;
+  VM.BITSTREAM_TABLE = NULL;
+  VAM_VM_INIT(&VM, argc, argv);
+
+  for (int nodes = 0; nodes <= NUM_ACCs; nodes += NUM_ACCs) {
+    const char *name = (nodes == 0) ? "CPU" : "card";
+
+    gettimeofday(&start, NULL);
+    vsql_filter(&VM, SQLLESS, A, SIZE, K, C, NULL, &n, nodes);
+    timeuse = elapsed(&start);
+    printf("%-4s filter        :\t%'12d us\t%8.1f MRows/s\t%'d rows\r\n", name, timeuse, (double)SIZE / timeuse, n);
+    if (n != ref_n || memcmp(C, Ref, n * 4) != 0) { printf("%s filter: Error\r\n", name); errors++; }
+
+    gettimeofday(&start, NULL);
+    vsql_filter(&VM, SQLLESS, A, SIZE, K, NULL, Sel, &n, nodes);
+    timeuse = elapsed(&start);
+    printf("%-4s selection     :\t%'12d us\t%8.1f MRows/s\r\n", name, timeuse, (double)SIZE / timeuse);
+    for (i = 0; i < n && i < ref_n; i++)
+      if (A[Sel[i]] != Ref[i]) break;
+    if (n != ref_n || i != n) { printf("%s selection: Error\r\n", name); errors++; }
+
+    gettimeofday(&start, NULL);
+    vsql_aggregate(&VM, SQLLARGE, A, SIZE, K, &agg, nodes);
+    timeuse = elapsed(&start);
+    printf("%-4s filter->avg   :\t%'12d us\t%8.1f MRows/s\tavg %d\r\n", name, timeuse, (double)SIZE / timeuse, agg.avg);
+    if (agg.sum != ref_sum || agg.count != ref_count) { printf("%s filter->avg: Error\r\n", name); errors++; }
+  }
+
+  // two waves of TAIL_NODES chunks and a tail too short to give every node a slice
+  int tail = 2 * TAIL_NODES * VSQL_CHUNK + 20, tail_n = 0;
+  for (i = 0; i < tail; i++) tail_n += (A[i] < K);
+  gettimeofday(&start, NULL);
+  err = vsql_filter(&VM, SQLLESS, A, tail, K, C, NULL, &n, TAIL_NODES);
+  timeuse = elapsed(&start);
+  printf("card short tail    :\t%'12d us\t%'d rows of %'d\r\n", timeuse, n, tail);
+  if (err != 0 || n != tail_n || memcmp(C, Ref, n * 4) != 0) { printf("short tail: Error\r\n"); errors++; }
+
+  VAM_VM_CLEAN(&VM);
+  delete[] A;
+  delete[] Ref;
+  delete[] C;
+  delete[] Sel;
+
+  if (errors == 0) printf("Passed\r\n");
+  else             printf("Failed\r\n");
+  return 0;
+}
@@ -0,0 +1,89 @@
+#include <iostream>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <stdio.h>
+#include <picodrv.h>
+#include <pico_errors.h>
+#include <sys/time.h>
+#include <pthread.h>
+#include <cmath>
+#include <locale.h>
+#include <algorithm>
+
+using namespace std;
+
+//#define VERBOSE
+//#define VERBOSE_THREAD
+#include "jit_isa.h"
+#include "jit_gemm.h"
+
+// GEMM benchmark: naive loops and the blocked CPU GEMM against vgemm of jit_gemm.h on ACCMM/ACCMMM
+// #define DIM 64
+#define DIM     512
+
+int main(int argc, char* argv[])
+{
+  printf("Begin...\r\n");
+  setlocale(LC_NUMERIC, ""); // for thounds seperator
+  printf("%'d x %'d x %'d\r\n", DIM, DIM, DIM);
+
+  struct timeval start, end;
+  int timeuse;
+  int i, j, k;
+  int errors = 0;
+  double ops = 2.0 * DIM * DIM * DIM;
+  vgemm_stat_t st;
+
+  int *A   = new int[DIM * DIM];
+  int *B   = new int[DIM * DIM];
+  int *Ref = new int[DIM * DIM];
+  int *C   = new int[DIM * DIM];
+
+  srand(1);
+  for (i = 0; i < DIM * DIM; i++) {
+    A[i] = rand() % 256 - 128;
+    B[i] = rand() % 256 - 128;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  gettimeofday(&start, NULL);
+  for (i = 0; i < DIM; i++)
+    for (j = 0; j < DIM; j++) {
+      int s = 0;
+      for (k = 0; k < DIM; k++) s += A[i * DIM + k] * B[k * DIM + j];
+      Ref[i * DIM + j] = s;
+    }
+  gettimeofday(&end, NULL);
+  timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+  printf("naive              :\t%'12d us\t%8.2f GFLOP/s\r\n", timeuse, ops / timeuse / 1000.0);
+
+  gettimeofday(&start, NULL);
+  vgemm_cpu(A, B, C, DIM, DIM, DIM, vcpu_threads());
+  gettimeofday(&end, NULL);
+  timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+  printf("CPU %'4d threads   :\t%'12d us\t%8.2f GFLOP/s\r\n", vcpu_threads(), timeuse, ops / timeuse / 1000.0);
+  if (memcmp(C, Ref, DIM * DIM * 4) != 0) { printf("vgemm_cpu: Error\r\n"); errors++; }
+  //////////////////////////////////////////////////////////////////////////////
+  vam_vm_t VM;
+  VM.VAM_TABLE = NULL;
+  VM.BITSTREAM_TABLE = NULL;
+  VAM_VM_INIT(&VM, argc, argv);
+
+  for (i = 1; i <= NUM_ACCs; i *= 2) {
+    memset(C, 0, DIM * DIM * 4);
+    vgemm(&VM, A, B, C, DIM, DIM, DIM, i, &st);
+    printf("vgemm %d nodes      :\t%'12d us\t%8.2f GFLOP/s\t%d lanes x %d legs\r\n", i, (int)st.us, st.gflops, st.lanes, st.legs);
+    if (memcmp(C, Ref, DIM * DIM * 4) != 0) { printf("vgemm %d nodes: Error\r\n", i); errors++; }
+  }
+
+  VAM_VM_CLEAN(&VM);
+  delete[] A;
+  delete[] B;
+  delete[] Ref;
+  delete[] C;
+
+  if (errors == 0) printf("Passed\r\n");
+  else             printf("Failed\r\n");
+  return 0;
+}
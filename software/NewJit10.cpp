@@ -0,0 +1,95 @@
+#include <iostream>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <picodrv.h>
+#include <pico_errors.h>
+#include <sys/time.h>
+#include <pthread.h>
+#include <cmath>
+#include <locale.h>
+#include <algorithm>
+
+using namespace std;
+
+//#define VERBOSE
+//#define VERBOSE_THREAD
+#include "jit_isa.h"
+#include "jit_pack.h"
+
+// Packed streams: VADD over the same number of elements as int32, 2 x int16 and 4 x int8 per word
+// #define SIZE 1024 * 64
+#define SIZE    1024 * 1024 * 4
+#define NODES   8
+
+int main(int argc, char* argv[])
+{
+  printf("Begin...\r\n");
+  setlocale(LC_NUMERIC, ""); // for thounds seperator
+  printf("%'d elements, %d nodes\r\n", SIZE, NODES);
+
+  struct timeval start, end;
+  int timeuse;
+  int i, t;
+  int errors = 0;
+  int types[3] = {VPACK_I32, VPACK_I16, VPACK_I8};
+
+  int     *A32 = new int[SIZE],     *B32 = new int[SIZE],     *C32 = new int[SIZE];
+  int16_t *A16 = new int16_t[SIZE], *B16 = new int16_t[SIZE], *C16 = new int16_t[SIZE];
+  int8_t  *A8  = new int8_t[SIZE],  *B8  = new int8_t[SIZE],  *C8  = new int8_t[SIZE];
+
+  srand(1);
+  for (i = 0; i < SIZE; i++) {
+    A32[i] = A16[i] = A8[i] = rand() % 256 - 128;
+    B32[i] = B16[i] = B8[i] = rand() % 256 - 128;
+  }
+  //////////////////////////////////////////////////////////////////////////////
+  vam_vm_t VM;
+  VM.VAM_TABLE = NULL;
+  VM.BITSTREAM_TABLE = NULL;
+  VAM_VM_INIT(&VM, argc, argv);
+
+  for (t = 0; t < 3; t++) {
+    void *A = (t == 0) ? (void *)A32 : (t == 1) ? (void *)A16 : (void *)A8;
+    void *B = (t == 0) ? (void *)B32 : (t == 1) ? (void *)B16 : (void *)B8;
+    void *C = (t == 0) ? (void *)C32 : (t == 1) ? (void *)C16 : (void *)C8;
+    memset(C, 0, (size_t)SIZE * 4 / types[t]);
+
+    gettimeofday(&start, NULL);
+    vpack_run(&VM, VADD, types[t], A, B, C, SIZE, NODES);
+    gettimeofday(&end, NULL);
+    timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+    printf("VADD %2d lanes/word :\t%'12d us\t%'12d words\t%8.1f Melem/s%s\r\n", types[t], timeuse, vwords(types[t], SIZE),
+           (double)SIZE / timeuse, vhaspack(&VM, VADD, types[t]) ? "" : "\t(CPU)");
+
+    for (i = 0; i < SIZE; i++) {
+      int ref = A32[i] + B32[i];
+      int got = (t == 0) ? C32[i] : (t == 1) ? C16[i] : C8[i];
+      if ((t == 0 && got != ref) || (t == 1 && got != (int16_t)ref) || (t == 2 && got != (int8_t)ref)) {
+        printf("VADD %d lanes: Error at %d\r\n", types[t], i);
+        errors++;
+        break;
+      }
+    }
+  }
+
+  // int32 data through 2 x int16 lanes, packed and unpacked on the host
+  gettimeofday(&start, NULL);
+  vpack_run32(&VM, VMUL, VPACK_I16, A32, B32, C32, SIZE, NODES);
+  gettimeofday(&end, NULL);
+  timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+  printf("VMUL int32 as I16  :\t%'12d us\t%'12d words\t%8.1f Melem/s\r\n", timeuse, vwords(VPACK_I16, SIZE), (double)SIZE / timeuse);
+  for (i = 0; i < SIZE; i++)
+    if (C32[i] != A32[i] * B32[i]) { printf("VMUL int32 as I16: Error at %d\r\n", i); errors++; break; }
+
+  VAM_VM_CLEAN(&VM);
+  delete[] A32; delete[] B32; delete[] C32;
+  delete[] A16; delete[] B16; delete[] C16;
+  delete[] A8;  delete[] B8;  delete[] C8;
+
+  if (errors == 0) printf("Passed\r\n");
+  else             printf("Failed\r\n");
+  return 0;
+}
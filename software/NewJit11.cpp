@@ -0,0 +1,77 @@
+#include <iostream>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <picodrv.h>
+#include <pico_errors.h>
+#include <sys/time.h>
+#include <pthread.h>
+#include <locale.h>
+#include <algorithm>
+
+using namespace std;
+
+//#define VERBOSE
+//#define VERBOSE_THREAD
+#include "jit_isa.h"
+#include "jit_perf.h"
+
+// Counters of a VADD -> VMUL chain: (A + B) * B, the sum through the crossbar
+// #define SIZE 1024 * 64
+#define SIZE    1024 * 1024 * 4
+
+int main(int argc, char* argv[])
+{
+  printf("Begin...\r\n");
+  setlocale(LC_NUMERIC, ""); // for thounds seperator
+  printf("%'d elements\r\n", SIZE);
+
+  struct timeval start, end;
+  int timeuse;
+  int i, err;
+  int errors = 0;
+
+  int *A = new int[SIZE], *B = new int[SIZE], *C = new int[SIZE];
+  srand(1);
+  for (i = 0; i < SIZE; i++) {
+    A[i] = rand() % 256 - 128;
+    B[i] = rand() % 256 - 128;
+    C[i] = 0;
+  }
+  //////////////////////////////////////////////////////////////////////////////
+  vam_vm_t VM;
+  VM.VAM_TABLE = NULL;
+  VM.BITSTREAM_TABLE = NULL;
+  VAM_VM_INIT(&VM, argc, argv);
+
+  vector<int>     nPR(2);
+  vector<vperf_t> perf;
+
+  err =   vnew(&VM, &nPR);                                                                          errCheck(err, FUN_VNEW);
+  err =   vlpr(&VM, nPR[0], VADD);                                                                  errCheck(err, FUN_VLPR);
+  err =   vlpr(&VM, nPR[1], VMUL);                                                                  errCheck(err, FUN_VLPR);
+  err = vperf_clear(&VM, &nPR);
+  if (err < 0) printf("No counters on this overlay\r\n");
+
+  gettimeofday(&start, NULL);
+  err = vtieio(&VM, nPR[0], A, SIZE, B, SIZE, nPR[1], SIZE);                                        errCheck(err, FUN_VTIEIO);
+  err = vtieio(&VM, nPR[1], nPR[0], SIZE, B, SIZE, C, SIZE);                                        errCheck(err, FUN_VTIEIO);
+  err = vstart(&VM, &nPR);                                                                          errCheck(err, FUN_VSTART);
+  gettimeofday(&end, NULL);
+  timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+  printf("VADD -> VMUL :\t%'12d us\t%8.1f Melem/s\r\n", timeuse, (double)SIZE / timeuse);
+
+  if (vperf_read(&VM, &nPR, &perf) == 0) vperf_show(&perf);
+  err =   vdel(&VM, &nPR);                                                                          errCheck(err, FUN_VDEL);
+
+  for (i = 0; i < SIZE; i++)
+    if (C[i] != (A[i] + B[i]) * B[i]) { printf("Error at %d\r\n", i); errors++; break; }
+
+  VAM_VM_CLEAN(&VM);
+  delete[] A; delete[] B; delete[] C;
+
+  if (errors == 0) printf("Passed\r\n");
+  else             printf("Failed\r\n");
+  return 0;
+}
@@ -0,0 +1,118 @@
+#include <iostream>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <picodrv.h>
+#include <pico_errors.h>
+#include <sys/time.h>
+#include <pthread.h>
+#include <locale.h>
+#include <algorithm>
+
+using namespace std;
+
+//#define VERBOSE
+//#define VERBOSE_THREAD
+#include "jit_isa.h"
+#include "jit_cq.h"
+
+// Async launch: VADD on SIZE elements and VMUL on SIZE / 4 on two nodes, started together by one
+// vlaunch while the host computes the reference, their completion records waited for by tag
+// #define SIZE 1024 * 64
+#define SIZE    1024 * 1024 * 4
+
+int main(int argc, char* argv[])
+{
+  printf("Begin...\r\n");
+  setlocale(LC_NUMERIC, ""); // for thounds seperator
+  printf("%'d elements\r\n", SIZE);
+
+  int i, err;
+  int errors = 0;
+  int small  = SIZE / 4;
+
+  int *A  = new int[SIZE], *B  = new int[SIZE];
+  int *C0 = new int[SIZE], *C1 = new int[SIZE], *R = new int[SIZE];
+  srand(1);
+  for (i = 0; i < SIZE; i++) {
+    A[i]  = rand() % 256 - 128;
+    B[i]  = rand() % 256 - 128;
+    C0[i] = C1[i] = 0;
+  }
+  //////////////////////////////////////////////////////////////////////////////
+  vam_vm_t VM;
+  VM.VAM_TABLE = NULL;
+  VM.BITSTREAM_TABLE = NULL;
+  VAM_VM_INIT(&VM, argc, argv);
+  err = VCQ_INIT(&VM);                                                                              errCheck(err, FUN_VSTART);
+
+  vector<int> nPR(2);
+  vlaunch_t   L;
+  vcq_entry_t e0, e1;
+
+  err =    vnew(&VM, &nPR);                                                                         errCheck(err, FUN_VNEW);
+  err =    vlpr(&VM, nPR[0], VADD);                                                                 errCheck(err, FUN_VLPR);
+  err =    vlpr(&VM, nPR[1], VMUL);                                                                 errCheck(err, FUN_VLPR);
+  err = vsettag(&VM, nPR[0], 100);                                                                  errCheck(err, FUN_VTIEIO);
+  err =  vtieio(&VM, nPR[0], A, SIZE,  B, SIZE,  C0, SIZE);                                         errCheck(err, FUN_VTIEIO);
+  err = vsettag(&VM, nPR[1], 101);                                                                  errCheck(err, FUN_VTIEIO);
+  err =  vtieio(&VM, nPR[1], A, small, B, small, C1, small);                                        errCheck(err, FUN_VTIEIO);
+  err = vlaunch(&VM, &nPR, &L);                                                                     errCheck(err, FUN_VSTART);
+
+  // the host is free while the nodes run
+  double host = vcq_us();
+  for (i = 0; i < SIZE; i++) R[i] = A[i] + B[i];
+  host = vcq_us() - host;
+
+  err = vcq_wait(&VM, nPR[1], 101, &e1, 10000);                                                     errCheck(err, FUN_VEND);
+  err = vcq_wait(&VM, nPR[0], 100, &e0, 10000);                                                     errCheck(err, FUN_VEND);
+  err =   vjoin(&L);                                                                                errCheck(err, FUN_VSTART);
+  printf("host reference     :\t%'12.0f us\r\n", host);
+  printf("node 0x%02x tag %3u :\t%'12.0f us\t%'12u words\tstatus 0x%x\r\n", e1.nPR, e1.tag, e1.us - L.us, e1.words, e1.status);
+  printf("node 0x%02x tag %3u :\t%'12.0f us\t%'12u words\tstatus 0x%x\r\n", e0.nPR, e0.tag, e0.us - L.us, e0.words, e0.status);
+  if (e0.words != (uint32_t)SIZE || e1.words != (uint32_t)small) { printf("Completion word count mismatch\r\n"); errors++; }
+
+  for (i = 0; i < SIZE; i++)
+    if (C0[i] != R[i]) { printf("VADD: Error at %d\r\n", i); errors++; break; }
+  for (i = 0; i < small; i++)
+    if (C1[i] != A[i] * B[i]) { printf("VMUL: Error at %d\r\n", i); errors++; break; }
+
+  #ifdef JIT_EMU_H
+    // nobody reading stream 50: its fifo takes EMU_CQ_WORDS / 4 records, then jit_cq.v holds one
+    // per node and the next job of the node overwrites it, with VCQ_LOST set
+    uint32_t    rec[VCQ_WORDS];
+    vector<int> one(1, nPR[0]);
+    int         flood = EMU_CQ_WORDS / VCQ_WORDS + 3, cmd_stream;
+    VCQ_CLEAN(&VM);
+    for (i = 0; i < flood; i++) {
+      err = vsettag(&VM, nPR[0], 1000 + i);                                                         errCheck(err, FUN_VTIEIO);
+      err =  vtieio(&VM, nPR[0], A, 16, B, 16, C0, 16);                                             errCheck(err, FUN_VTIEIO);
+      err =  vstart(&VM, &one);                                                                     errCheck(err, FUN_VSTART);
+    }
+    cmd_stream = VM.pico[0]->CreateStream(50);
+    for (i = 0; i < flood - 2; i++) {
+      err = VM.pico[0]->ReadStream(cmd_stream, rec, VCQ_WORDS * 4);                                 errCheck(err, FUN_VEND);
+      if (i < flood - 3 && (rec[1] != (uint32_t)(1000 + i) || (rec[3] & VCQ_LOST))) break;
+      if (i == flood - 3 && (rec[1] < (uint32_t)(1000 + flood - 2) || !(rec[3] & VCQ_LOST))) break;
+    }
+    if (i < flood - 2) { printf("Record %d: tag %u status 0x%x\r\n", i, rec[1], rec[3]); errors++; }
+    // the last job is done after the first read made room: its record was not lost
+    else if (rec[1] == (uint32_t)(1000 + flood - 2)) {
+      err = VM.pico[0]->ReadStream(cmd_stream, rec, VCQ_WORDS * 4);                                 errCheck(err, FUN_VEND);
+      if (rec[1] != (uint32_t)(1000 + flood - 1) || (rec[3] & VCQ_LOST)) { printf("Last record: tag %u status 0x%x\r\n", rec[1], rec[3]); errors++; }
+    }
+    VM.pico[0]->CloseStream(cmd_stream);
+    printf("%d jobs unread    :\t%'12d records before the node lost one\r\n", flood, flood - 3);
+  #endif
+
+  err =    vdel(&VM, &nPR);                                                                         errCheck(err, FUN_VDEL);
+
+  VCQ_CLEAN(&VM);
+  VAM_VM_CLEAN(&VM);
+  delete[] A; delete[] B; delete[] C0; delete[] C1; delete[] R;
+
+  if (errors == 0) printf("Passed\r\n");
+  else             printf("Failed\r\n");
+  return 0;
+}
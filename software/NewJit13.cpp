@@ -0,0 +1,133 @@
+#include <iostream>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <picodrv.h>
+#include <pico_errors.h>
+#include <sys/time.h>
+#include <pthread.h>
+#include <locale.h>
+#include <algorithm>
+
+using namespace std;
+
+//#define VERBOSE
+//#define VERBOSE_THREAD
+#include "jit_isa.h"
+#include "jit_cq.h"
+#include "jit_perf.h"
+
+// Back-to-back jobs on one node: VADD on JOBS chunks of CHUNK elements, once with vtieio + vstart
+// per chunk and once with each chunk queued in the shadow set while the one before it streams.
+// Queuing takes the commands of a job off the gap between two jobs; the streams of a queued job
+// still start when the vstart before it returns. The counters of the node show both parts: idle
+// cycles, no job loaded, are the commands in the gap, which the SWAP at DONE removes; stallA is
+// the job loaded and its first words not there yet. The emulator applies a command JIT_EMU_CMD_US
+// after it was sent, 20 us unless set, and runs the nodes on the host cores, so its times depend
+// on the cores free for the stream threads; the counters do not.
+// #define CHUNK 1024 * 16
+#define CHUNK   1024 * 256
+#define JOBS    16
+#define TAG     100     // tag of the first queued job
+
+int main(int argc, char* argv[])
+{
+  printf("Begin...\r\n");
+  setlocale(LC_NUMERIC, ""); // for thounds seperator
+  setenv("JIT_EMU_CMD_US", "20", 0);
+  printf("%d jobs of %'d elements\r\n", JOBS, CHUNK);
+
+  struct timeval start, end;
+  int timeuse;
+  int i, j, err;
+  int errors = 0;
+
+  int *A  = new int[CHUNK * JOBS], *B = new int[CHUNK * JOBS];
+  int *C0 = new int[CHUNK * JOBS], *C1 = new int[CHUNK * JOBS];
+  srand(1);
+  for (i = 0; i < CHUNK * JOBS; i++) {
+    A[i]  = rand() % 256 - 128;
+    B[i]  = rand() % 256 - 128;
+    C0[i] = C1[i] = 0;
+  }
+  //////////////////////////////////////////////////////////////////////////////
+  vam_vm_t VM;
+  VM.VAM_TABLE = NULL;
+  VM.BITSTREAM_TABLE = NULL;
+  VAM_VM_INIT(&VM, argc, argv);
+  err = VCQ_INIT(&VM);                                                                              errCheck(err, FUN_VSTART);
+
+  vector<int>     nPR(1);
+  vlaunch_t       L[JOBS];
+  vcq_entry_t     e;
+  vector<vperf_t> P0, P1;
+
+  err =    vnew(&VM, &nPR);                                                                         errCheck(err, FUN_VNEW);
+  err =    vlpr(&VM, nPR[0], VADD);                                                                 errCheck(err, FUN_VLPR);
+
+  err = vperf_clear(&VM, &nPR);                                                                     errCheck(err, FUN_VEND);
+  gettimeofday(&start, NULL);
+  for (j = 0; j < JOBS; j++) {
+    err =  vtieio(&VM, nPR[0], A + j * CHUNK, CHUNK, B + j * CHUNK, CHUNK, C0 + j * CHUNK, CHUNK);  errCheck(err, FUN_VTIEIO);
+    err =  vstart(&VM, &nPR);                                                                       errCheck(err, FUN_VSTART);
+  }
+  gettimeofday(&end, NULL);
+  err = vperf_read(&VM, &nPR, &P0);                                                                 errCheck(err, FUN_VEND);
+  timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+  printf("vtieio + vstart :\t%'12d us\r\n", timeuse);
+
+  err = vperf_clear(&VM, &nPR);                                                                     errCheck(err, FUN_VEND);
+  gettimeofday(&start, NULL);
+  err = vsettag(&VM, nPR[0], TAG);                                                                  errCheck(err, FUN_VTIEIO);
+  err =  vtieio(&VM, nPR[0], A, CHUNK, B, CHUNK, C1, CHUNK);                                        errCheck(err, FUN_VTIEIO);
+  err = vlaunch(&VM, &nPR, &L[0]);                                                                  errCheck(err, FUN_VSTART);
+  for (j = 1; j < JOBS; j++) {
+    // the next chunk is configured while the one before it streams
+    err = (j > 1) ? vcq_wait(&VM, nPR[0], TAG + j - 2, &e, 10000) : 0;                                  errCheck(err, FUN_VEND);
+    err = vshadow_begin(&VM);                                                                       errCheck(err, FUN_VTIEIO);
+    err = vsettag(&VM, nPR[0], TAG + j);                                                            errCheck(err, FUN_VTIEIO);
+    err =  vtieio(&VM, nPR[0], A + j * CHUNK, CHUNK, B + j * CHUNK, CHUNK, C1 + j * CHUNK, CHUNK);  errCheck(err, FUN_VTIEIO);
+    err = vshadow_end(&VM);                                                                         errCheck(err, FUN_VTIEIO);
+    err =  vqueue(&VM, &nPR, &L[j - 1], &L[j]);                                                     errCheck(err, FUN_VSTART);
+  }
+  err =   vjoin(&L[JOBS - 1]);                                                                      errCheck(err, FUN_VSTART);
+  gettimeofday(&end, NULL);
+  err = vperf_read(&VM, &nPR, &P1);                                                                 errCheck(err, FUN_VEND);
+  timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+  printf("queued          :\t%'12d us\r\n", timeuse);
+
+  // idle: the cycles of the run not active, stalled or blocked, the node had no job loaded
+  uint32_t idle[2], stall[2];
+  for (j = 0; j < 2; j++) {
+    vperf_t *p = (j == 0) ? &P0[0] : &P1[0];
+    int64_t  used = (int64_t)p->cnt[VPERF_ACTIVE] + p->cnt[VPERF_STALLA] + p->cnt[VPERF_STALLB] + p->cnt[VPERF_BLOCKC];
+    idle[j]  = (uint32_t)std::max((int64_t)p->cnt[VPERF_CYCLES] - used, (int64_t)0);
+    stall[j] = p->cnt[VPERF_STALLA];
+    printf("%-16s:\t%'12u idle cycles\t%'12u stallA cycles\t%'10u per job\r\n", (j == 0) ? "vtieio + vstart" : "queued",
+           idle[j], stall[j], (idle[j] + stall[j]) / JOBS);
+  }
+  #ifdef JIT_EMU_H
+    // the first job waits for its commands on both paths, the SWAP takes them off the JOBS - 1 gaps
+    if (idle[1] * 2 > idle[0]) { printf("queued: %u idle cycles, not below half of %u\r\n", idle[1], idle[0]); errors++; }
+  #endif
+
+  for (j = JOBS - 2; j < JOBS; j++) {
+    err = vcq_wait(&VM, nPR[0], TAG + j, &e, 10000);                                                errCheck(err, FUN_VEND);
+    if (e.words != (uint32_t)CHUNK) { printf("Job %d: %u words\r\n", j, e.words); errors++; }
+  }
+  err =    vdel(&VM, &nPR);                                                                         errCheck(err, FUN_VDEL);
+
+  for (i = 0; i < CHUNK * JOBS; i++)
+    if (C0[i] != A[i] + B[i]) { printf("vstart: Error at %d\r\n", i); errors++; break; }
+  for (i = 0; i < CHUNK * JOBS; i++)
+    if (C1[i] != A[i] + B[i]) { printf("queued: Error at %d\r\n", i); errors++; break; }
+
+  VCQ_CLEAN(&VM);
+  VAM_VM_CLEAN(&VM);
+  delete[] A; delete[] B; delete[] C0; delete[] C1;
+
+  if (errors == 0) printf("Passed\r\n");
+  else             printf("Failed\r\n");
+  return 0;
+}
@@ -0,0 +1,105 @@
+#include <iostream>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <picodrv.h>
+#include <pico_errors.h>
+#include <sys/time.h>
+#include <pthread.h>
+#include <locale.h>
+#include <algorithm>
+
+using namespace std;
+
+//#define VERBOSE
+//#define VERBOSE_THREAD
+#include "jit_isa.h"
+
+// Fan-out: X = A + B feeding D1 = X * C and D2 = X + C. Once through a host buffer (X out, then
+// read back twice), once multicast by the crossbar to both nodes, and once with X to the host and
+// to the VMUL node at the same time (vsetcast)
+// #define SIZE 1024 * 64
+#define SIZE    1024 * 1024 * 4
+
+int main(int argc, char* argv[])
+{
+  printf("Begin...\r\n");
+  setlocale(LC_NUMERIC, ""); // for thounds seperator
+  printf("%'d elements\r\n", SIZE);
+
+  struct timeval start, end;
+  int timeuse;
+  int i, err;
+  int errors = 0;
+
+  int *A  = new int[SIZE], *B  = new int[SIZE], *C = new int[SIZE], *X = new int[SIZE];
+  int *D1 = new int[SIZE], *D2 = new int[SIZE];
+  srand(1);
+  for (i = 0; i < SIZE; i++) {
+    A[i]  = rand() % 256 - 128;
+    B[i]  = rand() % 256 - 128;
+    C[i]  = rand() % 256 - 128;
+  }
+  //////////////////////////////////////////////////////////////////////////////
+  vam_vm_t VM;
+  VM.VAM_TABLE = NULL;
+  VM.BITSTREAM_TABLE = NULL;
+  VAM_VM_INIT(&VM, argc, argv);
+
+  vector<int> nPR(3);
+  vector<int> first(1), rest(2), pair(2);
+
+  err =    vnew(&VM, &nPR);                                                                         errCheck(err, FUN_VNEW);
+  err =    vlpr(&VM, nPR[0], VADD);                                                                 errCheck(err, FUN_VLPR);
+  err =    vlpr(&VM, nPR[1], VMUL);                                                                 errCheck(err, FUN_VLPR);
+  err =    vlpr(&VM, nPR[2], VADD);                                                                 errCheck(err, FUN_VLPR);
+  first[0] = nPR[0];
+  rest[0]  = nPR[1]; rest[1] = nPR[2];
+  pair[0]  = nPR[0]; pair[1] = nPR[1];
+
+  memset(D1, 0, SIZE * 4); memset(D2, 0, SIZE * 4);
+  gettimeofday(&start, NULL);
+  err =  vtieio(&VM, nPR[0], A, SIZE, B, SIZE, X,  SIZE);                                           errCheck(err, FUN_VTIEIO);
+  err =  vstart(&VM, &first);                                                                       errCheck(err, FUN_VSTART);
+  err =  vtieio(&VM, nPR[1], X, SIZE, C, SIZE, D1, SIZE);                                           errCheck(err, FUN_VTIEIO);
+  err =  vtieio(&VM, nPR[2], X, SIZE, C, SIZE, D2, SIZE);                                           errCheck(err, FUN_VTIEIO);
+  err =  vstart(&VM, &rest);                                                                        errCheck(err, FUN_VSTART);
+  gettimeofday(&end, NULL);
+  timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+  printf("host buffer     :\t%'12d us\r\n", timeuse);
+  for (i = 0; i < SIZE; i++)
+    if (D1[i] != (A[i] + B[i]) * C[i] || D2[i] != A[i] + B[i] + C[i]) { printf("host buffer: Error at %d\r\n", i); errors++; break; }
+
+  memset(D1, 0, SIZE * 4); memset(D2, 0, SIZE * 4);
+  gettimeofday(&start, NULL);
+  err =  vtieio(&VM, nPR[0], A, SIZE, B, SIZE, nPR[1], SIZE);                                       errCheck(err, FUN_VTIEIO);
+  err =  vtieio(&VM, nPR[1], nPR[0], SIZE, C, SIZE, D1, SIZE);                                      errCheck(err, FUN_VTIEIO);
+  err =  vtieio(&VM, nPR[2], nPR[0], SIZE, C, SIZE, D2, SIZE);                                      errCheck(err, FUN_VTIEIO);
+  err =  vstart(&VM, &nPR);                                                                         errCheck(err, FUN_VSTART);
+  gettimeofday(&end, NULL);
+  timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+  printf("multicast       :\t%'12d us\r\n", timeuse);
+  for (i = 0; i < SIZE; i++)
+    if (D1[i] != (A[i] + B[i]) * C[i] || D2[i] != A[i] + B[i] + C[i]) { printf("multicast: Error at %d\r\n", i); errors++; break; }
+
+  memset(D1, 0, SIZE * 4); memset(X, 0, SIZE * 4);
+  gettimeofday(&start, NULL);
+  err = vsetcast(&VM, nPR[0]);                                                                      errCheck(err, FUN_VTIEIO);
+  err =  vtieio(&VM, nPR[0], A, SIZE, B, SIZE, X,  SIZE);                                           errCheck(err, FUN_VTIEIO);
+  err =  vtieio(&VM, nPR[1], nPR[0], SIZE, C, SIZE, D1, SIZE);                                      errCheck(err, FUN_VTIEIO);
+  err =  vstart(&VM, &pair);                                                                        errCheck(err, FUN_VSTART);
+  gettimeofday(&end, NULL);
+  timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+  printf("host + crossbar :\t%'12d us\r\n", timeuse);
+  for (i = 0; i < SIZE; i++)
+    if (X[i] != A[i] + B[i] || D1[i] != (A[i] + B[i]) * C[i]) { printf("host + crossbar: Error at %d\r\n", i); errors++; break; }
+
+  err =    vdel(&VM, &nPR);                                                                         errCheck(err, FUN_VDEL);
+  VAM_VM_CLEAN(&VM);
+  delete[] A; delete[] B; delete[] C; delete[] X; delete[] D1; delete[] D2;
+
+  if (errors == 0) printf("Passed\r\n");
+  else             printf("Failed\r\n");
+  return 0;
+}
@@ -0,0 +1,99 @@
+#include <iostream>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <picodrv.h>
+#include <pico_errors.h>
+#include <sys/time.h>
+#include <pthread.h>
+#include <locale.h>
+#include <algorithm>
+
+using namespace std;
+
+//#define VERBOSE
+//#define VERBOSE_THREAD
+#include "jit_isa.h"
+#include "jit_dev.h"
+
+// Device buffers: X = A + B feeding D = X * C. Once through a host buffer (X out and back in), once
+// with X kept in the DRAM of the card (jit_dev.h), written by a DMA writer and read by a DMA reader,
+// then X read back by the host (not timed). The device path saves X over PCIe both ways, 2 of the 6
+// transfers. The emulator models that cost with JIT_EMU_LINK_MBPS, a link shared by all streams;
+// its nodes run far below card speed, so the link is scaled down with them, 250 MB/s unless set.
+// #define SIZE 1024 * 64
+#define SIZE    1024 * 1024 * 4
+
+int main(int argc, char* argv[])
+{
+  printf("Begin...\r\n");
+  setlocale(LC_NUMERIC, ""); // for thounds seperator
+  setenv("JIT_EMU_LINK_MBPS", "250", 0);
+  printf("%'d elements\r\n", SIZE);
+
+  struct timeval start, end;
+  int timeuse;
+  int i, err;
+  int errors = 0;
+
+  int *A = new int[SIZE], *B = new int[SIZE], *C = new int[SIZE], *X = new int[SIZE];
+  int *D = new int[SIZE];
+  srand(1);
+  for (i = 0; i < SIZE; i++) {
+    A[i]  = rand() % 256 - 128;
+    B[i]  = rand() % 256 - 128;
+    C[i]  = rand() % 256 - 128;
+  }
+  //////////////////////////////////////////////////////////////////////////////
+  vam_vm_t VM;
+  VM.VAM_TABLE = NULL;
+  VM.BITSTREAM_TABLE = NULL;
+  VAM_VM_INIT(&VM, argc, argv);
+
+  vector<int> nPR(2);
+  vector<int> first(1), second(1);
+  vdev_t XD;
+
+  err =    vnew(&VM, &nPR);                                                                         errCheck(err, FUN_VNEW);
+  err =    vlpr(&VM, nPR[0], VADD);                                                                 errCheck(err, FUN_VLPR);
+  err =    vlpr(&VM, nPR[1], VMUL);                                                                 errCheck(err, FUN_VLPR);
+  first[0] = nPR[0]; second[0] = nPR[1];
+
+  memset(D, 0, SIZE * 4);
+  gettimeofday(&start, NULL);
+  err =  vtieio(&VM, nPR[0], A, SIZE, B, SIZE, X, SIZE);                                            errCheck(err, FUN_VTIEIO);
+  err =  vstart(&VM, &first);                                                                       errCheck(err, FUN_VSTART);
+  err =  vtieio(&VM, nPR[1], X, SIZE, C, SIZE, D, SIZE);                                            errCheck(err, FUN_VTIEIO);
+  err =  vstart(&VM, &second);                                                                      errCheck(err, FUN_VSTART);
+  gettimeofday(&end, NULL);
+  timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+  printf("host buffer     :\t%'12d us\t%'6d MB over PCIe\r\n", timeuse, 6 * SIZE / 1024 / 1024 * 4);
+  for (i = 0; i < SIZE; i++)
+    if (D[i] != (A[i] + B[i]) * C[i]) { printf("host buffer: Error at %d\r\n", i); errors++; break; }
+
+  err =  VDEV_INIT(&VM);                                                                            errCheck(err, FUN_VNEW);
+  err = vdevnew(&VM, VNPR_CARD(nPR[0]), SIZE, &XD);                                                 errCheck(err, FUN_VNEW);
+  memset(D, 0, SIZE * 4); memset(X, 0, SIZE * 4);
+  gettimeofday(&start, NULL);
+  err =  vtieio(&VM, nPR[0], A, SIZE, B, SIZE, &XD, SIZE);                                          errCheck(err, FUN_VTIEIO);
+  err =  vstart(&VM, &first);                                                                       errCheck(err, FUN_VSTART);
+  err =  vtieio(&VM, nPR[1], &XD, SIZE, C, SIZE, D, SIZE);                                          errCheck(err, FUN_VTIEIO);
+  err =  vstart(&VM, &second);                                                                      errCheck(err, FUN_VSTART);
+  gettimeofday(&end, NULL);
+  timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+  printf("device buffer   :\t%'12d us\t%'6d MB over PCIe\r\n", timeuse, 4 * SIZE / 1024 / 1024 * 4);
+  err = vdevread(&VM, &XD, X, SIZE);                                                                errCheck(err, FUN_VEND);
+  for (i = 0; i < SIZE; i++)
+    if (X[i] != A[i] + B[i] || D[i] != (A[i] + B[i]) * C[i]) { printf("device buffer: Error at %d\r\n", i); errors++; break; }
+  err =  vdevdel(&VM, &XD);                                                                         errCheck(err, FUN_VDEL);
+  VDEV_CLEAN(&VM);
+
+  err =    vdel(&VM, &nPR);                                                                         errCheck(err, FUN_VDEL);
+  VAM_VM_CLEAN(&VM);
+  delete[] A; delete[] B; delete[] C; delete[] X; delete[] D;
+
+  if (errors == 0) printf("Passed\r\n");
+  else             printf("Failed\r\n");
+  return 0;
+}
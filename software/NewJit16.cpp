@@ -0,0 +1,95 @@
+#include <iostream>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <picodrv.h>
+#include <pico_errors.h>
+#include <sys/time.h>
+#include <pthread.h>
+#include <locale.h>
+#include <algorithm>
+
+using namespace std;
+
+//#define VERBOSE
+//#define VERBOSE_THREAD
+#include "jit_isa.h"
+#include "jit_dev.h"
+
+// Bitstream cache: a node swapped between VADD and VMUL, each PR once streamed from the host on
+// stream 100, once from the DRAM of the card through the PR reader (jit_dev.h), then both checked
+#define SIZE    1024 * 64
+#define SWAPS   32
+
+int main(int argc, char* argv[])
+{
+  printf("Begin...\r\n");
+  setlocale(LC_NUMERIC, ""); // for thounds seperator
+  printf("%'d elements, %d swaps\r\n", SIZE, SWAPS);
+
+  struct timeval start, end;
+  int timeuse;
+  int i, s, err;
+  int errors = 0;
+
+  int *A = new int[SIZE], *B = new int[SIZE], *C = new int[SIZE];
+  srand(1);
+  for (i = 0; i < SIZE; i++) {
+    A[i]  = rand() % 256 - 128;
+    B[i]  = rand() % 256 - 128;
+  }
+  //////////////////////////////////////////////////////////////////////////////
+  vam_vm_t VM;
+  VM.VAM_TABLE = NULL;
+  VM.BITSTREAM_TABLE = NULL;
+  VAM_VM_INIT(&VM, argc, argv);
+
+  vector<int> nPR(1);
+
+  err =    vnew(&VM, &nPR);                                                                         errCheck(err, FUN_VNEW);
+
+  gettimeofday(&start, NULL);
+  for (s = 0; s < SWAPS; s++) {
+    err =  vlpr(&VM, nPR[0], (s % 2) ? VMUL : VADD);                                                errCheck(err, FUN_VLPR);
+  }
+  gettimeofday(&end, NULL);
+  timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+  printf("stream 100      :\t%'12d us\r\n", timeuse);
+
+  err =  VDEV_INIT(&VM);                                                                            errCheck(err, FUN_VNEW);
+  err = vpcache_on(&VM, 1);                                                                         errCheck(err, FUN_VLPR);
+  gettimeofday(&start, NULL);
+  for (s = 0; s < SWAPS; s++) {
+    err =  vlpr(&VM, nPR[0], (s % 2) ? VMUL : VADD);                                                errCheck(err, FUN_VLPR);
+  }
+  gettimeofday(&end, NULL);
+  timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+  printf("DRAM cache      :\t%'12d us\r\n", timeuse);
+
+  // the last swap loaded VMUL, checked as is, then VADD from the cache
+  memset(C, 0, SIZE * 4);
+  err =    vlpr(&VM, nPR[0], VMUL);                                                                 errCheck(err, FUN_VLPR);
+  err =  vtieio(&VM, nPR[0], A, SIZE, B, SIZE, C, SIZE);                                            errCheck(err, FUN_VTIEIO);
+  err =  vstart(&VM, &nPR);                                                                         errCheck(err, FUN_VSTART);
+  for (i = 0; i < SIZE; i++)
+    if (C[i] != A[i] * B[i]) { printf("VMUL: Error at %d\r\n", i); errors++; break; }
+
+  memset(C, 0, SIZE * 4);
+  err =    vlpr(&VM, nPR[0], VADD);                                                                 errCheck(err, FUN_VLPR);
+  err =  vtieio(&VM, nPR[0], A, SIZE, B, SIZE, C, SIZE);                                            errCheck(err, FUN_VTIEIO);
+  err =  vstart(&VM, &nPR);                                                                         errCheck(err, FUN_VSTART);
+  for (i = 0; i < SIZE; i++)
+    if (C[i] != A[i] + B[i]) { printf("VADD: Error at %d\r\n", i); errors++; break; }
+
+  vpcache_off(&VM);
+  VDEV_CLEAN(&VM);
+
+  err =    vdel(&VM, &nPR);                                                                         errCheck(err, FUN_VDEL);
+  VAM_VM_CLEAN(&VM);
+  delete[] A; delete[] B; delete[] C;
+
+  if (errors == 0) printf("Passed\r\n");
+  else             printf("Failed\r\n");
+  return 0;
+}
@@ -0,0 +1,96 @@
+#include <iostream>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <picodrv.h>
+#include <pico_errors.h>
+#include <sys/time.h>
+#include <pthread.h>
+#include <locale.h>
+#include <algorithm>
+
+using namespace std;
+
+//#define VERBOSE
+//#define VERBOSE_THREAD
+#include "jit_isa.h"
+
+// Region ID readback: VADD and VMUL loaded on two nodes, then the node table forgotten as by a new
+// host process. vprid_sync (run by VAM_VM_INIT with JIT_PRID_SYNC=1, set here unless given) restores
+// PR_key from the regions, so loading the same operators again sends no bitstream; then both nodes
+// checked
+#define SIZE    1024 * 64
+
+int main(int argc, char* argv[])
+{
+  printf("Begin...\r\n");
+  setlocale(LC_NUMERIC, ""); // for thounds seperator
+  setenv("JIT_PRID_SYNC", "1", 0);
+  printf("%'d elements\r\n", SIZE);
+
+  struct timeval start, end;
+  int timeuse;
+  int i, err;
+  int errors = 0;
+
+  int *A = new int[SIZE], *B = new int[SIZE], *C = new int[SIZE];
+  srand(1);
+  for (i = 0; i < SIZE; i++) {
+    A[i]  = rand() % 256 - 128;
+    B[i]  = rand() % 256 - 128;
+  }
+  //////////////////////////////////////////////////////////////////////////////
+  vam_vm_t VM;
+  VM.VAM_TABLE = NULL;
+  VM.BITSTREAM_TABLE = NULL;
+  VAM_VM_INIT(&VM, argc, argv);
+
+  vector<int> nPR(2);
+  vector<int> first(1), second(1);
+
+  err =    vnew(&VM, &nPR);                                                                         errCheck(err, FUN_VNEW);
+  first[0] = nPR[0]; second[0] = nPR[1];
+
+  gettimeofday(&start, NULL);
+  err =    vlpr(&VM, nPR[0], VADD);                                                                 errCheck(err, FUN_VLPR);
+  err =    vlpr(&VM, nPR[1], VMUL);                                                                 errCheck(err, FUN_VLPR);
+  gettimeofday(&end, NULL);
+  timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+  printf("cold vlpr       :\t%'12d us\r\n", timeuse);
+
+  // what a restarted host process starts from
+  for (i = 0; i < (int)VM.VAM_TABLE->size(); i++) VM.VAM_TABLE->at(i).PR_key = 0;
+  err = vprid_sync(&VM);                                                                            errCheck(err, FUN_VNEW);
+  if (VM.VAM_TABLE->at(VNPR_INDEX(nPR[0])).PR_key != VADD || VM.VAM_TABLE->at(VNPR_INDEX(nPR[1])).PR_key != VMUL) {
+    printf("vprid_sync: Error, PR_key %d %d\r\n", VM.VAM_TABLE->at(VNPR_INDEX(nPR[0])).PR_key, VM.VAM_TABLE->at(VNPR_INDEX(nPR[1])).PR_key);
+    errors++;
+  }
+
+  gettimeofday(&start, NULL);
+  err =    vlpr(&VM, nPR[0], VADD);                                                                 errCheck(err, FUN_VLPR);
+  err =    vlpr(&VM, nPR[1], VMUL);                                                                 errCheck(err, FUN_VLPR);
+  gettimeofday(&end, NULL);
+  timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+  printf("warm vlpr       :\t%'12d us\r\n", timeuse);
+
+  memset(C, 0, SIZE * 4);
+  err =  vtieio(&VM, nPR[0], A, SIZE, B, SIZE, C, SIZE);                                            errCheck(err, FUN_VTIEIO);
+  err =  vstart(&VM, &first);                                                                       errCheck(err, FUN_VSTART);
+  for (i = 0; i < SIZE; i++)
+    if (C[i] != A[i] + B[i]) { printf("VADD: Error at %d\r\n", i); errors++; break; }
+
+  memset(C, 0, SIZE * 4);
+  err =  vtieio(&VM, nPR[1], A, SIZE, B, SIZE, C, SIZE);                                            errCheck(err, FUN_VTIEIO);
+  err =  vstart(&VM, &second);                                                                      errCheck(err, FUN_VSTART);
+  for (i = 0; i < SIZE; i++)
+    if (C[i] != A[i] * B[i]) { printf("VMUL: Error at %d\r\n", i); errors++; break; }
+
+  err =    vdel(&VM, &nPR);                                                                         errCheck(err, FUN_VDEL);
+  VAM_VM_CLEAN(&VM);
+  delete[] A; delete[] B; delete[] C;
+
+  if (errors == 0) printf("Passed\r\n");
+  else             printf("Failed\r\n");
+  return 0;
+}
@@ -0,0 +1,118 @@
+#include <iostream>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <picodrv.h>
+#include <pico_errors.h>
+#include <sys/time.h>
+#include <pthread.h>
+#include <locale.h>
+#include <algorithm>
+
+using namespace std;
+
+//#define VERBOSE
+//#define VERBOSE_THREAD
+#include "jit_isa.h"
+#include "jit_dev.h"
+#include "jit_perf.h"
+
+// DMA priority: two nodes of one card each add B to a device buffer, the first one weighted
+// VDMA_PRIO_MAX with vdevprio, the second left at 1, both started at once so their readers share
+// the AXI master; then the bursts each reader was granted and the cycles it waited, both checked.
+// Both readers issue all the bursts of SIZE words. While both had bursts, the first one (reader 0,
+// claimed first) got VDMA_PRIO_MAX for each of the second, so the second waited VDMA_PRIO_MAX times
+// the cycles the first did, up to a turn at either end. The emulator grants one burst per cycle and
+// must match that; on a card AR stalls count for both readers and a full reader drops out, so only
+// the order is checked there.
+#define SIZE    1024 * 1024
+#define BURSTS  ((SIZE / JIT_BEAT_WORDS + 15) / 16)
+
+int main(int argc, char* argv[])
+{
+  printf("Begin...\r\n");
+  setlocale(LC_NUMERIC, ""); // for thounds seperator
+  printf("%'d elements\r\n", SIZE);
+
+  struct timeval start, end;
+  int timeuse;
+  int i, k, err;
+  int errors = 0;
+
+  int *A = new int[SIZE], *B = new int[SIZE], *C0 = new int[SIZE], *C1 = new int[SIZE];
+  srand(1);
+  for (i = 0; i < SIZE; i++) {
+    A[i]  = rand() % 256 - 128;
+    B[i]  = rand() % 256 - 128;
+  }
+  //////////////////////////////////////////////////////////////////////////////
+  vam_vm_t VM;
+  VM.VAM_TABLE = NULL;
+  VM.BITSTREAM_TABLE = NULL;
+  VAM_VM_INIT(&VM, argc, argv);
+
+  vector<int> nPR(2), rd(VDMA_RDS);
+  vector<vperf_t> perf;
+  vdev_t XA, XB;
+
+  err =    vnew(&VM, &nPR);                                                                         errCheck(err, FUN_VNEW);
+  if (VNPR_CARD(nPR[0]) != VNPR_CARD(nPR[1])) printf("nodes on two cards, no sharing\r\n");
+  err =    vlpr(&VM, nPR[0], VADD);                                                                 errCheck(err, FUN_VLPR);
+  err =    vlpr(&VM, nPR[1], VADD);                                                                 errCheck(err, FUN_VLPR);
+  for (k = 0; k < VDMA_RDS; k++) rd[k] = VNPR(VNPR_CARD(nPR[0]), VDMA_RD(k));
+
+  err =  VDEV_INIT(&VM);                                                                            errCheck(err, FUN_VNEW);
+  err = vdevnew(&VM, VNPR_CARD(nPR[0]), SIZE, &XA);                                                 errCheck(err, FUN_VNEW);
+  err = vdevnew(&VM, VNPR_CARD(nPR[1]), SIZE, &XB);                                                 errCheck(err, FUN_VNEW);
+  err = vdevwrite(&VM, &XA, A, SIZE);                                                               errCheck(err, FUN_VTIEIO);
+  err = vdevwrite(&VM, &XB, A, SIZE);                                                               errCheck(err, FUN_VTIEIO);
+  err = vdevprio(&VM, &XA, VDMA_PRIO_MAX);                                                          errCheck(err, FUN_VTIEIO);
+
+  memset(C0, 0, SIZE * 4); memset(C1, 0, SIZE * 4);
+  err = vperf_clear(&VM, &rd);                                                                      errCheck(err, FUN_VEND);
+  gettimeofday(&start, NULL);
+  err =  vtieio(&VM, nPR[0], &XA, SIZE, B, SIZE, C0, SIZE);                                         errCheck(err, FUN_VTIEIO);
+  err =  vtieio(&VM, nPR[1], &XB, SIZE, B, SIZE, C1, SIZE);                                         errCheck(err, FUN_VTIEIO);
+  err =  vstart(&VM, &nPR);                                                                         errCheck(err, FUN_VSTART);
+  gettimeofday(&end, NULL);
+  timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+  printf("both jobs       :\t%'12d us\r\n", timeuse);
+  for (i = 0; i < SIZE; i++)
+    if (C0[i] != A[i] + B[i] || C1[i] != A[i] + B[i]) { printf("Error at %d\r\n", i); errors++; break; }
+
+  // vdevdel takes the records of the readers, vperf_read would drop them
+  err =  vdevdel(&VM, &XA);                                                                         errCheck(err, FUN_VDEL);
+  err =  vdevdel(&VM, &XB);                                                                         errCheck(err, FUN_VDEL);
+  err =  vperf_read(&VM, &rd, &perf);                                                               errCheck(err, FUN_VEND);
+  for (k = 0; k < VDMA_RDS; k++)
+    printf("reader node 0x%02x:\t%'12u bursts %'12u cycles waited\r\n", perf[k].nPR, perf[k].cnt[VPERF_GRANTS],
+           perf[k].cnt[VPERF_WAITS]);
+  for (k = 0; k < 2; k++) {
+    if (perf[k].cnt[VPERF_GRANTS] != BURSTS) {
+      printf("reader %d: Error, %u bursts, %d expected\r\n", k, perf[k].cnt[VPERF_GRANTS], BURSTS);
+      errors++;
+    }
+  }
+  long hi = perf[0].cnt[VPERF_WAITS], lo = perf[1].cnt[VPERF_WAITS];
+  #ifdef JIT_EMU_H
+    if (hi == 0 || labs(lo - (long)VDMA_PRIO_MAX * hi) > 2 * VDMA_PRIO_MAX) {
+      printf("weights: Error, waits %ld and %ld, not %d to 1\r\n", lo, hi, VDMA_PRIO_MAX);
+      errors++;
+    }
+  #else
+    if (lo <= hi) {
+      printf("weights: Error, the weight 1 reader waited %ld cycles, the weight %d one %ld\r\n", lo, VDMA_PRIO_MAX, hi);
+      errors++;
+    }
+  #endif
+  VDEV_CLEAN(&VM);
+
+  err =    vdel(&VM, &nPR);                                                                         errCheck(err, FUN_VDEL);
+  VAM_VM_CLEAN(&VM);
+  delete[] A; delete[] B; delete[] C0; delete[] C1;
+
+  if (errors == 0) printf("Passed\r\n");
+  else             printf("Failed\r\n");
+  return 0;
+}
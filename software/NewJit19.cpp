@@ -0,0 +1,135 @@
+#include <iostream>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <picodrv.h>
+#include <pico_errors.h>
+#include <sys/time.h>
+#include <pthread.h>
+#include <locale.h>
+#include <algorithm>
+
+using namespace std;
+
+//#define VERBOSE
+//#define VERBOSE_THREAD
+#include "jit_isa.h"
+#include "jit_plan.h"
+
+// Offload planner: VADD and VMUL of growing sizes through vplan_run, then the graph D = (A + B) * C
+// described as two vplan_node_t, run on the CPU and on two chained nodes and each timed against the
+// prediction of vplan_predict, next to the pick of vplan_graph; every result checked on the host
+#define SIZE    1024 * 1024
+#define ROUNDS  3
+
+static double now_us(void)
+{
+  struct timeval t;
+  gettimeofday(&t, NULL);
+  return 1000000.0 * t.tv_sec + t.tv_usec;
+}
+
+int main(int argc, char* argv[])
+{
+  printf("Begin...\r\n");
+  setlocale(LC_NUMERIC, ""); // for thounds seperator
+  printf("%'d elements max, %d rounds\r\n", SIZE, ROUNDS);
+
+  int i, k, r, s, t, err, target, free, resident, reload;
+  int errors = 0;
+  double pred, ratio, t0, tp, us[2], cost[2];
+
+  int *A = new int[SIZE], *B = new int[SIZE], *C = new int[SIZE], *D = new int[SIZE], *T = new int[SIZE];
+  srand(1);
+  for (i = 0; i < SIZE; i++) {
+    A[i]  = rand() % 256 - 128;
+    B[i]  = rand() % 256 - 128;
+    C[i]  = rand() % 256 - 128;
+  }
+  //////////////////////////////////////////////////////////////////////////////
+  vam_vm_t VM;
+  VM.VAM_TABLE = NULL;
+  VM.BITSTREAM_TABLE = NULL;
+  VAM_VM_INIT(&VM, argc, argv);
+
+  vam_plan_t PLAN;
+  VPLAN_INIT(&PLAN);
+
+  // single operators, the planner picks and calibrates on each run
+  for (r = 0; r < ROUNDS; r++) {
+    for (s = 4096; s <= SIZE; s *= 4) {
+      memset(D, 0, s * 4);
+      err = vplan_run(&VM, &PLAN, VADD, A, B, D, s, 0);                                             errCheck(err, FUN_VSTART);
+      for (i = 0; i < s; i++)
+        if (D[i] != A[i] + B[i]) { printf("VADD %d: Error at %d\r\n", s, i); errors++; break; }
+      memset(D, 0, s * 4);
+      err = vplan_run(&VM, &PLAN, VMUL, A, B, D, s, 0);                                             errCheck(err, FUN_VSTART);
+      for (i = 0; i < s; i++)
+        if (D[i] != A[i] * B[i]) { printf("VMUL %d: Error at %d\r\n", s, i); errors++; break; }
+    }
+  }
+  printf("vplan_run       :\t%ld CPU %ld FPGA %ld SPLIT, mean |err| %.1f%% over %ld jobs\r\n",
+         PLAN.decisions[VPLAN_CPU], PLAN.decisions[VPLAN_FPGA], PLAN.decisions[VPLAN_SPLIT],
+         (PLAN.samples > 0) ? 100.0 * PLAN.abs_err / PLAN.samples : 0.0, PLAN.samples);
+
+  // a hand-built graph: the adder feeds the multiplier through the crossbar. Both targets run and
+  // are timed against their prediction, the pick of vplan_graph should be the faster one
+  vector<vplan_node_t> graph(2);
+  graph[0].op = VADD; graph[0].host_in = 2; graph[0].host_out = 0;
+  graph[1].op = VMUL; graph[1].host_in = 1; graph[1].host_out = 1;
+  printf("%-10s %-6s %14s %14s %14s %14s\r\n", "size", "pick", "CPU pred", "CPU actual", "FPGA pred", "FPGA actual");
+  for (r = 0; r < ROUNDS; r++) {
+    for (s = 4096; s <= SIZE; s *= 4) {
+      graph[0].size = graph[1].size = s;
+      target = vplan_graph(&VM, &PLAN, &graph, &pred, &ratio);
+      free   = vplan_free(&VM, VADD, &resident);
+      pthread_mutex_lock(&PLAN.mutex);
+      for (t = VPLAN_CPU; t <= VPLAN_FPGA; t++) cost[t] = vplan_predict(&PLAN, &graph, free, resident, t, NULL);
+      pthread_mutex_unlock(&PLAN.mutex);
+
+      for (t = VPLAN_CPU; t <= VPLAN_FPGA; t++) {
+        memset(D, 0, s * 4);
+        t0 = now_us();
+        if (t == VPLAN_FPGA) {
+          vector<int> nPR(2);
+          err =    vnew(&VM, &nPR);                                                                 errCheck(err, FUN_VNEW);
+          for (k = 0; k < 2; k++) {
+            reload = VM.VAM_TABLE->at(VNPR_INDEX(nPR[k])).PR_key != graph[k].op;
+            tp  = now_us();
+            err =  vlpr(&VM, nPR[k], graph[k].op);                                                  errCheck(err, FUN_VLPR);
+            if (reload) vplan_observe_pr(&PLAN, graph[k].op, now_us() - tp);
+            else        vplan_observe_cmd(&PLAN, 2, now_us() - tp);
+          }
+          err =  vtieio(&VM, nPR[0], A, s, B, s, nPR[1], s);                                        errCheck(err, FUN_VTIEIO);
+          err =  vtieio(&VM, nPR[1], nPR[0], s, C, s, D, s);                                        errCheck(err, FUN_VTIEIO);
+          err =  vstart(&VM, &nPR);                                                                 errCheck(err, FUN_VSTART);
+          us[t] = now_us() - t0;
+          vplan_observe_stream(&PLAN, 4.0 * s, us[t]);
+          err =    vdel(&VM, &nPR);                                                                 errCheck(err, FUN_VDEL);
+        } else {
+          vcpu(VADD, A, B, T, s, 0);
+          us[t] = now_us() - t0;
+          vplan_observe_cpu(&PLAN, VADD, 2.0 * s, us[t]);
+          vcpu(VMUL, T, C, D, s, 0);
+          vplan_observe_cpu(&PLAN, VMUL, 2.0 * s, now_us() - t0 - us[t]);
+          us[t] = now_us() - t0;
+        }
+        vplan_observe_graph(&PLAN, &graph, t, cost[t], us[t]);
+        for (i = 0; i < s; i++)
+          if (D[i] != (A[i] + B[i]) * C[i]) { printf("graph %d on %s: Error at %d\r\n", s, vplan_name(t), i); errors++; break; }
+      }
+      printf("%'-10d %-6s %'11.0f us %'11.0f us %'11.0f us %'11.0f us%s\r\n", s, vplan_name(target), cost[VPLAN_CPU],
+             us[VPLAN_CPU], cost[VPLAN_FPGA], us[VPLAN_FPGA], (us[target] <= us[1 - target]) ? "" : "  (slower pick)");
+    }
+  }
+  printf("all jobs        :\tmean |err| %.1f%% over %ld jobs\r\n", 100.0 * PLAN.abs_err / PLAN.samples, PLAN.samples);
+
+  VPLAN_CLEAN(&PLAN);
+  VAM_VM_CLEAN(&VM);
+  delete[] A; delete[] B; delete[] C; delete[] D; delete[] T;
+
+  if (errors == 0) printf("Passed\r\n");
+  else             printf("Failed\r\n");
+  return 0;
+}
@@ -0,0 +1,73 @@
+#include <iostream>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <picodrv.h>
+#include <pico_errors.h>
+#include <sys/time.h>
+#include <pthread.h>
+#include <locale.h>
+#include <algorithm>
+
+using namespace std;
+
+//#define VERBOSE
+//#define VERBOSE_THREAD
+#include "jit_isa.h"
+#include "jit_split.h"
+
+// Hybrid split: VADD then VMUL run RUNS times each through vsplit on up to 2 nodes and the CPU.
+// Each run prints the share the card got, the time of both sides and the share of the next run,
+// which settles where both sides finish together; every C checked against the host
+#define SIZE    1024 * 1024 * 4
+#define RUNS    10
+
+int main(int argc, char* argv[])
+{
+  printf("Begin...\r\n");
+  setlocale(LC_NUMERIC, ""); // for thounds seperator
+  printf("%'d elements, %d runs\r\n", SIZE, RUNS);
+
+  int i, r, k, op, err;
+  int errors = 0;
+  int ops[2] = {VADD, VMUL};
+
+  int *A = new int[SIZE], *B = new int[SIZE], *C = new int[SIZE];
+  srand(1);
+  for (i = 0; i < SIZE; i++) {
+    A[i]  = rand() % 256 - 128;
+    B[i]  = rand() % 256 - 128;
+  }
+  //////////////////////////////////////////////////////////////////////////////
+  vam_vm_t VM;
+  VM.VAM_TABLE = NULL;
+  VM.BITSTREAM_TABLE = NULL;
+  VAM_VM_INIT(&VM, argc, argv);
+
+  vam_split_t SPLIT;
+  vsplit_stat_t st;
+  VSPLIT_INIT(&SPLIT);
+
+  for (k = 0; k < 2; k++) {
+    op = ops[k];
+    printf("%-4s %-4s %6s %12s %12s %12s %12s %6s\r\n", (op == VADD) ? "VADD" : "VMUL", "run", "ratio", "card elems",
+           "card us", "cpu elems", "cpu us", "next");
+    for (r = 0; r < RUNS; r++) {
+      memset(C, 0, SIZE * 4);
+      err = vsplit(&VM, &SPLIT, op, A, B, C, SIZE, 2, &st);                                         errCheck(err, FUN_VSTART);
+      printf("     %-4d %6.3f %'12d %'12.0f %'12d %'12.0f %6.3f\r\n", r, st.ratio, st.fpga_size, st.fpga_us, st.cpu_size,
+             st.cpu_us, SPLIT.ratio[op]);
+      for (i = 0; i < SIZE; i++)
+        if (C[i] != ((op == VADD) ? A[i] + B[i] : A[i] * B[i])) { printf("run %d: Error at %d\r\n", r, i); errors++; break; }
+    }
+  }
+
+  VSPLIT_CLEAN(&SPLIT);
+  VAM_VM_CLEAN(&VM);
+  delete[] A; delete[] B; delete[] C;
+
+  if (errors == 0) printf("Passed\r\n");
+  else             printf("Failed\r\n");
+  return 0;
+}
@@ -0,0 +1,89 @@
+#include <iostream>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <picodrv.h>
+#include <pico_errors.h>
+#include <sys/time.h>
+#include <pthread.h>
+#include <locale.h>
+#include <algorithm>
+
+using namespace std;
+
+//#define VERBOSE
+//#define VERBOSE_THREAD
+#define CARD    2        // the partials of two cards are combined on the host: two boards or the emulator
+#include "jit_isa.h"
+#include "jit_reduce.h"
+
+// Scalar reductions of jit_reduce.h against the host, mod 2^32 over full range values:
+//   size   below VREDUCE_MIN (CPU kernels), and an odd size whose last slice is not aligned
+//   nodes  1: one leaf read back alone (CPU for the ops needing a VADD/VMUL node in front),
+//          4: a small tree, partials added by a VADD node on the card,
+//          2 * NUM_ACCs: the full trees of both cards, their beats added on the host
+// Overlays without a bitstream for an operator (VSUB in the default one) run it on the CPU.
+#define SIZE    (1024 * 1024 + 37)
+
+int main(int argc, char* argv[])
+{
+  printf("Begin...\r\n");
+  setlocale(LC_NUMERIC, ""); // for thounds seperator
+
+  struct timeval start, end;
+  int timeuse;
+  int i, o, s, k, err, result;
+  int errors = 0;
+  int ops[4]           = {VREDUCE, VADDREDUCE, VSUBREDUCE, VMUL};
+  const char *names[4] = {"VREDUCE", "VADDREDUCE", "VSUBREDUCE", "vdot"};
+  int sizes[2]         = {VREDUCE_MIN - 1, SIZE};
+  int nodes[3]         = {1, 4, 2 * NUM_ACCs};
+
+  int *A = new int[SIZE], *B = new int[SIZE];
+  srand(1);
+  for (i = 0; i < SIZE; i++) {
+    A[i] = (rand() << 1) ^ rand();
+    B[i] = (rand() << 1) ^ rand();
+  }
+  //////////////////////////////////////////////////////////////////////////////
+  vam_vm_t VM;
+  VM.VAM_TABLE = NULL;
+  VM.BITSTREAM_TABLE = NULL;
+  VAM_VM_INIT(&VM, argc, argv);
+
+  printf("%-10s %10s %5s %12s %12s %12s\r\n", "op", "size", "nodes", "host", "result", "us");
+  for (o = 0; o < 4; o++) {
+    for (s = 0; s < 2; s++) {
+      uint32_t ref = 0;
+      for (i = 0; i < sizes[s]; i++) {
+        switch (ops[o]) {
+          case VREDUCE:    ref += (uint32_t)A[i];                         break;
+          case VADDREDUCE: ref += (uint32_t)A[i] + (uint32_t)B[i];        break;
+          case VSUBREDUCE: ref += (uint32_t)A[i] - (uint32_t)B[i];        break;
+          default:         ref += (uint32_t)A[i] * (uint32_t)B[i];        break;
+        }
+      }
+      for (k = 0; k < 3; k++) {
+        result = 0;
+        gettimeofday(&start, NULL);
+        if (ops[o] == VMUL) err = vdot(&VM, A, B, sizes[s], nodes[k], &result);
+        else                err = vreduce(&VM, ops[o], A, (ops[o] == VREDUCE) ? NULL : B, sizes[s], nodes[k], &result);
+        gettimeofday(&end, NULL);
+        timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+        printf("%-10s %'10d %5d %12d %12d %'12d\r\n", names[o], sizes[s], nodes[k], (int)ref, result, timeuse);
+        if (err != 0 || result != (int)ref) {
+          printf("%s size %d nodes %d: Error, err:%d\r\n", names[o], sizes[s], nodes[k], err);
+          errors++;
+        }
+      }
+    }
+  }
+
+  VAM_VM_CLEAN(&VM);
+  delete[] A; delete[] B;
+
+  if (errors == 0) printf("Passed\r\n");
+  else             printf("Failed\r\n");
+  return 0;
+}
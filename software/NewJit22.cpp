@@ -0,0 +1,164 @@
+#include <iostream>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <picodrv.h>
+#include <pico_errors.h>
+#include <sys/time.h>
+#include <pthread.h>
+#include <locale.h>
+#include <algorithm>
+
+using namespace std;
+
+//#define VERBOSE
+//#define VERBOSE_THREAD
+#include "jit_isa.h"
+#include "jit_expr.h"
+
+// Expressions of jit_expr.h against the host, with the plan vexpr_run reports for each:
+//   BBR_RRB   (A+B) + (D+E)              the three VADD of NewJit06, Reg edges only
+//   RRR       ((A+B) + (D+E)) + F        the four VADD of NewJit06
+//   CSE       (A+B)*(A-B) + (B+A)*D      B+A is A+B, one node read by both VMUL
+//   A2PB2     A*A + B*B                  one fused node when the overlay has the kernel
+//   VAPBB     (A-B) + D*D                VSUB feeding a fused node
+//   deep      A+B+D+E+F+A+... DEEP adds  longer than the nodes: split through host buffers
+//   tiny      RRR below VEXPR_MIN        CPU only
+// Every expression also runs with 0 nodes (CPU operators) and must give the same C.
+#define SIZE    (1024 * 1024)
+#define NODES   8
+#define DEEP    20
+
+typedef struct {
+  const char *name;
+  int         root;
+  int         size;
+  int         ops, fused, temps;   // expected, -1 not checked
+}shape_t;
+
+int main(int argc, char* argv[])
+{
+  printf("Begin...\r\n");
+  setlocale(LC_NUMERIC, ""); // for thounds seperator
+
+  struct timeval start, end;
+  int timeuse;
+  int i, s, k, err;
+  int errors = 0;
+
+  int *A = new int[SIZE], *B = new int[SIZE], *D = new int[SIZE], *E = new int[SIZE], *F = new int[SIZE];
+  int *C = new int[SIZE], *Ref = new int[SIZE];
+  srand(1);
+  for (i = 0; i < SIZE; i++) {
+    A[i] = rand() % 256 - 128;
+    B[i] = rand() % 256 - 128;
+    D[i] = rand() % 256 - 128;
+    E[i] = rand() % 256 - 128;
+    F[i] = rand() % 256 - 128;
+  }
+  //////////////////////////////////////////////////////////////////////////////
+  vam_vm_t VM;
+  VM.VAM_TABLE = NULL;
+  VM.BITSTREAM_TABLE = NULL;
+  VAM_VM_INIT(&VM, argc, argv);
+
+  vexpr_t X;
+  VEXPR_INIT(&X);
+  int a = vexpr_leaf(&X, A), b = vexpr_leaf(&X, B), d = vexpr_leaf(&X, D), e = vexpr_leaf(&X, E), f = vexpr_leaf(&X, F);
+  int ab = vexpr_add(&X, a, b), de = vexpr_add(&X, d, e);
+  int bbr_rrb = vexpr_add(&X, ab, de);
+  int rrr     = vexpr_add(&X, bbr_rrb, f);
+  int cse     = vexpr_add(&X, vexpr_mul(&X, ab, vexpr_sub(&X, a, b)), vexpr_mul(&X, vexpr_add(&X, b, a), d));
+  int a2pb2   = vexpr_add(&X, vexpr_mul(&X, a, a), vexpr_mul(&X, b, b));
+  int vapbb   = vexpr_add(&X, vexpr_sub(&X, a, b), vexpr_mul(&X, d, d));
+  int deep    = a;
+  int leaf[5] = {b, d, e, f, a};
+  int *add[5] = {B, D, E, F, A};
+  for (k = 0; k < DEEP; k++) deep = vexpr_add(&X, deep, leaf[k % 5]);
+  if (vexpr_add(&X, b, a) != ab) {
+    printf("CSE: B+A is not A+B\r\n");
+    errors++;
+  }
+
+  int fa = vhasbit(&VM, A2PB2), fb = vhasbit(&VM, VAPBB);
+  shape_t shape[7] = {
+    {"BBR_RRB", bbr_rrb, SIZE,          3,                 0,      0},
+    {"RRR",     rrr,     SIZE,          4,                 0,      0},
+    {"CSE",     cse,     SIZE,          5,                 0,     -1},
+    {"A2PB2",   a2pb2,   SIZE,          fa ? 1 : 3,        fa,     -1},
+    {"VAPBB",   vapbb,   SIZE,          fb ? 2 : 3,        fb,     -1},
+    {"deep",    deep,    SIZE,          DEEP,              0,     -1},
+    {"tiny",    rrr,     VEXPR_MIN - 1, 4,                 0,     -1},
+  };
+
+  printf("%-8s %5s %4s %5s %4s %5s %6s %5s %10s %10s\r\n", "expr", "nodes", "ops", "fused", "cpu", "temps", "shared", "waves", "us", "cpu us");
+  for (s = 0; s < 7; s++) {
+    vexpr_stat_t st, cst;
+    int          ctime;
+
+    memset(Ref, 0, SIZE * 4);
+    gettimeofday(&start, NULL);
+    err = vexpr_run(&VM, &X, shape[s].root, Ref, shape[s].size, 0, &cst);                          errCheck(err, FUN_VSTART);
+    gettimeofday(&end, NULL);
+    ctime = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+
+    memset(C, 0, SIZE * 4);
+    gettimeofday(&start, NULL);
+    err = vexpr_run(&VM, &X, shape[s].root, C, shape[s].size, NODES, &st);                          errCheck(err, FUN_VSTART);
+    gettimeofday(&end, NULL);
+    timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+    printf("%-8s %5d %4d %5d %4d %5d %6d %5d %'10d %'10d\r\n", shape[s].name, st.nodes, st.ops, st.fused, st.cpu, st.temps, st.shared,
+           st.waves, timeuse, ctime);
+
+    for (i = 0; i < shape[s].size; i++) {
+      int ref;
+      switch (s) {
+        case 0:  ref = (A[i] + B[i]) + (D[i] + E[i]);                  break;
+        case 1:
+        case 6:  ref = (A[i] + B[i]) + (D[i] + E[i]) + F[i];           break;
+        case 2:  ref = (A[i] + B[i]) * (A[i] - B[i]) + (B[i] + A[i]) * D[i]; break;
+        case 3:  ref = A[i] * A[i] + B[i] * B[i];                      break;
+        case 4:  ref = (A[i] - B[i]) + D[i] * D[i];                    break;
+        default: ref = A[i];
+                 for (k = 0; k < DEEP; k++) ref += add[k % 5][i];
+                 break;
+      }
+      if (C[i] != ref || Ref[i] != ref) {
+        printf("%s: Error at %d, card %d cpu %d != %d\r\n", shape[s].name, i, C[i], Ref[i], ref);
+        errors++;
+        break;
+      }
+    }
+    if (st.ops != shape[s].ops || st.fused != shape[s].fused || (shape[s].temps >= 0 && st.temps != shape[s].temps)) {
+      printf("%s: plan ops:%d fused:%d temps:%d, expected %d %d %d\r\n", shape[s].name, st.ops, st.fused, st.temps,
+             shape[s].ops, shape[s].fused, shape[s].temps);
+      errors++;
+    }
+    if (s == 2 && st.nodes > 0 && st.shared == 0 && st.temps == 0) {
+      printf("%s: A+B neither shared nor buffered\r\n", shape[s].name);
+      errors++;
+    }
+    if (s == 5 && st.nodes > 0 && (st.temps == 0 || st.waves < 2)) {
+      printf("%s: %d adds on %d nodes not split\r\n", shape[s].name, DEEP, st.nodes);
+      errors++;
+    }
+    if (s == 6 && (st.nodes != 0 || st.cpu != st.ops)) {
+      printf("%s: below VEXPR_MIN not on the CPU\r\n", shape[s].name);
+      errors++;
+    }
+    if (cst.cpu != cst.ops) {
+      printf("%s: 0 nodes, %d of %d operators on the CPU\r\n", shape[s].name, cst.cpu, cst.ops);
+      errors++;
+    }
+  }
+
+  VEXPR_CLEAN(&X);
+  VAM_VM_CLEAN(&VM);
+  delete[] A; delete[] B; delete[] D; delete[] E; delete[] F;
+  delete[] C; delete[] Ref;
+
+  if (errors == 0) printf("Passed\r\n");
+  else             printf("Failed\r\n");
+  return 0;
+}
@@ -0,0 +1,109 @@
+#include <iostream>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <picodrv.h>
+#include <pico_errors.h>
+#include <sys/time.h>
+#include <pthread.h>
+#include <locale.h>
+#include <algorithm>
+
+using namespace std;
+
+//#define VERBOSE
+//#define VERBOSE_THREAD
+#include "jit_isa.h"
+#include "jit_vec.h"
+
+// jit::vec<int32_t> against the host on sizes from 1 word, through the tails of the SIMD kernels
+// and the VEXPR_MIN edge, up to one that runs on the card:
+//   c  = (a + b) * (a + b) + a * a      one graph, a+b once
+//   c += b;  c = c - a                  c is also an input, through a temporary
+//   sum(a), sum(a+b), sum(a-b), dot(a,b), sum((a+b)*c)
+// Every size runs bound to the VM and unbound (CPU only). A size mismatch must be refused.
+#define SIZE    (1024 * 1024 + 3)
+#define NODES   8
+
+int main(int argc, char* argv[])
+{
+  printf("Begin...\r\n");
+  setlocale(LC_NUMERIC, ""); // for thounds seperator
+
+  struct timeval start, end;
+  int timeuse;
+  int i, s, m, n;
+  int errors = 0;
+  int sizes[9] = {1, 3, 7, 15, 16, 17, VEXPR_MIN - 1, VEXPR_MIN, SIZE};
+
+  int *A = new int[SIZE], *B = new int[SIZE];
+  srand(1);
+  for (i = 0; i < SIZE; i++) {
+    A[i] = (rand() << 1) ^ rand();
+    B[i] = (rand() << 1) ^ rand();
+  }
+  //////////////////////////////////////////////////////////////////////////////
+  vam_vm_t VM;
+  VM.VAM_TABLE = NULL;
+  VM.BITSTREAM_TABLE = NULL;
+  VAM_VM_INIT(&VM, argc, argv);
+
+  printf("%-5s %10s %5s %4s %10s\r\n", "mode", "size", "nodes", "ops", "us");
+  for (m = 0; m < 2; m++) {
+    jit::vec_bind(m ? &VM : NULL, NODES);
+    for (s = 0; s < 9; s++) {
+      n = sizes[s];
+      jit::vec<int32_t> a(A, n), b(B, n), c(n);
+      uint32_t sa = 0, sab = 0, ssub = 0, sdot = 0, sabc = 0;
+      int      err = 0;
+
+      gettimeofday(&start, NULL);
+      c = (a + b) * (a + b) + a * a;
+      int nodes = jit::vec_ctx()->stat.nodes, ops = jit::vec_ctx()->stat.ops;
+      for (i = 0; i < n; i++) {
+        uint32_t x = (uint32_t)A[i], y = (uint32_t)B[i];
+        if ((uint32_t)c[i] != (x + y) * (x + y) + x * x) { err = 1; break; }
+      }
+      c += b;
+      c  = c - a;
+      gettimeofday(&end, NULL);
+      timeuse = 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+      for (i = 0; i < n && !err; i++) {
+        uint32_t x = (uint32_t)A[i], y = (uint32_t)B[i];
+        uint32_t z = (x + y) * (x + y) + x * x + y - x;
+        if ((uint32_t)c[i] != z) err = 2;
+        sa   += x;
+        sab  += x + y;
+        ssub += x - y;
+        sdot += x * y;
+        sabc += (x + y) * z;
+      }
+      if (!err && (uint32_t)jit::sum(a)           != sa)   err = 3;
+      if (!err && (uint32_t)jit::sum(a + b)       != sab)  err = 4;
+      if (!err && (uint32_t)jit::sum(a - b)       != ssub) err = 5;
+      if (!err && (uint32_t)jit::dot(a, b)        != sdot) err = 6;
+      if (!err && (uint32_t)jit::sum(a * b)       != sdot) err = 7;
+      if (!err && (uint32_t)jit::sum((a + b) * c) != sabc) err = 8;
+
+      printf("%-5s %'10d %5d %4d %'10d\r\n", m ? "card" : "cpu", n, nodes, ops, timeuse);
+      if (err) {
+        printf("%s size %d: Error at step %d\r\n", m ? "card" : "cpu", n, err);
+        errors++;
+      }
+    }
+  }
+
+  jit::vec<int32_t> a(A, 8), b(B, 9), c(8);
+  if (c.assign(a + b) != -1) {
+    printf("size mismatch: not refused\r\n");
+    errors++;
+  }
+
+  VAM_VM_CLEAN(&VM);
+  delete[] A; delete[] B;
+
+  if (errors == 0) printf("Passed\r\n");
+  else             printf("Failed\r\n");
+  return 0;
+}
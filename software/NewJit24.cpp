@@ -0,0 +1,140 @@
+#include <iostream>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <picodrv.h>
+#include <pico_errors.h>
+#include <sys/time.h>
+#include <pthread.h>
+#include <locale.h>
+#include <algorithm>
+
+using namespace std;
+
+//#define VERBOSE
+//#define VERBOSE_THREAD
+#include "jit_isa.h"
+#include "jit_cq.h"
+
+// Command bursts against one packet per command:
+//   encode   vburst_encode on 0 .. 2 * VBURST_MAX + 7 words: headers, lengths, 0xDEADBEEF pad to
+//            whole packets, and the words decoded back as they went in
+//   held     vsettag + vtieio of NODES nodes between vburst_begin and vburst_end: the 0xDEADBEEF
+//            filler of the vsettag packets is not held, the tag and the 0xC.../0xB... words are
+//   tie      the same NODES VADD jobs tied packet by packet and in one burst, ROUNDS each, every C
+//            checked; the emulator charges JIT_EMU_CMD_US (20 us unless set) per stream 50 write
+#define SIZE    (1024 * 16)
+#define NODES   8
+#define ROUNDS  20
+
+int main(int argc, char* argv[])
+{
+  printf("Begin...\r\n");
+  setlocale(LC_NUMERIC, ""); // for thounds seperator
+  setenv("JIT_EMU_CMD_US", "20", 0);
+
+  struct timeval start, end;
+  int timeuse[2];
+  int i, j, k, m, r, err;
+  int errors = 0;
+
+  //////////////////////////////////////////////////////////////////////////////
+  // encode
+  int lens[8] = {0, 1, 3, 4, 5, VBURST_MAX, VBURST_MAX + 1, 2 * VBURST_MAX + 7};
+  vector<uint32_t> words, pkt, back;
+  for (k = 0; k < 8; k++) {
+    int n = lens[k], bursts, pad;
+    words.resize(n);
+    for (i = 0; i < n; i++) words[i] = 0xC0100000 | (i & 0xFFFF);
+    bursts = vburst_encode(words.data(), n, &pkt);
+
+    back.clear();
+    for (i = 0, j = 0; i < (int)pkt.size() && (pkt[i] & 0xFFFF0000) == VBURST_HEADER; i += 1 + (pkt[i] & 0xFFFF), j++)
+      back.insert(back.end(), pkt.begin() + i + 1, pkt.begin() + std::min((int)pkt.size(), i + 1 + (int)(pkt[i] & 0xFFFF)));
+    for (pad = 0; i + pad < (int)pkt.size() && pkt[i + pad] == VCMD_FILLER; pad++);
+    printf("encode %'7d words: %d bursts, %'7d packet words, %d pad\r\n", n, bursts, (int)pkt.size(), pad);
+    if (bursts != (n + VBURST_MAX - 1) / VBURST_MAX || j != bursts || back != words || i + pad != (int)pkt.size() ||
+        pkt.size() % 4 != 0 || pad > 3) {
+      printf("encode %d words: Error\r\n", n);
+      errors++;
+    }
+  }
+  //////////////////////////////////////////////////////////////////////////////
+  int *A = new int[SIZE * NODES], *B = new int[SIZE * NODES], *C = new int[SIZE * NODES];
+  srand(1);
+  for (i = 0; i < SIZE * NODES; i++) {
+    A[i] = rand() % 256 - 128;
+    B[i] = rand() % 256 - 128;
+  }
+
+  vam_vm_t VM;
+  VM.VAM_TABLE = NULL;
+  VM.BITSTREAM_TABLE = NULL;
+  VAM_VM_INIT(&VM, argc, argv);
+
+  vector<int> nPR(NODES);
+  err = vnew(&VM, &nPR);                                                                            errCheck(err, FUN_VNEW);
+  for (i = 0; i < NODES; i++) {
+    err = vlpr(&VM, nPR[i], VADD);                                                                  errCheck(err, FUN_VLPR);
+  }
+
+  // held
+  vburst_begin(&VM);
+  for (i = 0; i < NODES; i++) {
+    err = vsettag(&VM, nPR[i], i + 1);                                                              errCheck(err, FUN_VTIEIO);
+    err = vtieio(&VM, nPR[i], A + i * SIZE, SIZE, B + i * SIZE, SIZE, C + i * SIZE, SIZE);          errCheck(err, FUN_VTIEIO);
+  }
+  int held = vam_burst->cmd[0].size(), bad = 0;
+  for (i = 0; i < held; i++) {
+    uint32_t w = vam_burst->cmd[0][i];
+    bad += (w == VCMD_FILLER);
+    if ((w >> 28) != ((i % 5 == 4) ? 0xBu : 0xCu)) bad++;
+  }
+  vburst_encode(vam_burst->cmd[0].data(), held, &pkt);
+  err = vburst_end(&VM);                                                                            errCheck(err, FUN_VTIEIO);
+  err = vstart(&VM, &nPR);                                                                          errCheck(err, FUN_VSTART);
+  printf("held   %d nodes: %d words (%d packets), %d filler or misplaced, one write of %d words\r\n", NODES, held, NODES * 2, bad,
+         (int)pkt.size());
+  if (held != NODES * 5 || bad != 0) {
+    printf("held: Error, %d words, %d expected, %d filler or out of order\r\n", held, NODES * 5, bad);
+    errors++;
+  }
+
+  // tie
+  for (m = 0; m < 2; m++) {
+    timeuse[m] = 0;
+    for (r = 0; r < ROUNDS; r++) {
+      memset(C, 0, SIZE * NODES * 4);
+      gettimeofday(&start, NULL);
+      if (m) vburst_begin(&VM);
+      for (i = 0; i < NODES; i++) {
+        err = vtieio(&VM, nPR[i], A + i * SIZE, SIZE, B + i * SIZE, SIZE, C + i * SIZE, SIZE);      errCheck(err, FUN_VTIEIO);
+      }
+      if (m) {
+        err = vburst_end(&VM);                                                                      errCheck(err, FUN_VTIEIO);
+      }
+      gettimeofday(&end, NULL);
+      timeuse[m] += 1000000 * (end.tv_sec - start.tv_sec) + end.tv_usec - start.tv_usec;
+      err = vstart(&VM, &nPR);                                                                      errCheck(err, FUN_VSTART);
+      for (i = 0; i < SIZE * NODES; i++) {
+        if (C[i] != A[i] + B[i]) {
+          printf("%s round %d: Error at %d\r\n", m ? "burst" : "packet", r, i);
+          errors++;
+          break;
+        }
+      }
+    }
+  }
+  printf("tie    %d nodes: per packet %'8.1f us, burst %'8.1f us\r\n", NODES, (double)timeuse[0] / ROUNDS,
+         (double)timeuse[1] / ROUNDS);
+
+  err = vdel(&VM, &nPR);                                                                            errCheck(err, FUN_VDEL);
+  VAM_VM_CLEAN(&VM);
+  delete[] A; delete[] B; delete[] C;
+
+  if (errors == 0) printf("Passed\r\n");
+  else             printf("Failed\r\n");
+  return 0;
+}
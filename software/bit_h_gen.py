@@ -1,5 +1,5 @@
 #!/usr/bin/python
-import sys, os, commands
+import sys, os, re, commands
 
 def main():
   PATH = os.getcwd()
@@ -7,12 +7,33 @@ def main():
   LIST.sort()
 
   file = open("jit_bit.h", "w")
+  HAVE = []
   for i in range(len(LIST)):
     if ("_bit.h" in LIST[i]):
       if (LIST[i] == "jit_bit.h"):
         continue
       print LIST[i]
       file.write("#include \"" + LIST[i] + "\"\r\n")
+      # HAVE_<acc> for the optional rows of VAM_BITSTREAM_TABLE_INIT
+      NAME = re.sub("_PR[0-9]+_bit.h$", "", LIST[i])
+      if (NAME not in HAVE):
+        HAVE.append(NAME)
+        file.write("#define HAVE_" + NAME + "\r\n")
+        # PACK_<acc>: packed lanes listed in <acc>.pack, e.g. "i16 i8"
+        if (os.path.isfile(NAME + ".pack")):
+          LANES = open(NAME + ".pack").read().split()
+          PACK  = ["VPACK_" + x.upper() for x in LANES if x.lower() in ("i16", "i8")]
+          if (PACK):
+            file.write("#define PACK_" + NAME + " (" + " | ".join(PACK) + ")\r\n")
+  # <acc>_PR_bit[] / <acc>_PR_bit_len[]: the bitstreams of PR1, PR2, ... for VAM_BIT_ROW
+  for NAME in HAVE:
+    PRS = [int(m.group(1)) for m in [re.match(NAME + "_PR([0-9]+)_bit.h$", x) for x in LIST] if m]
+    PRS.sort()
+    PRS = [n for n in PRS if n <= len(PRS) and PRS[:n] == range(1, n + 1)]   # row i is PR(i+1)
+    file.write("static const unsigned int *" + NAME + "_PR_bit[] = {" +
+               ", ".join([NAME + "_PR" + str(n) + "_bit" for n in PRS]) + "};\r\n")
+    file.write("static const unsigned int  " + NAME + "_PR_bit_len[] = {" +
+               ", ".join([NAME + "_PR" + str(n) + "_bit_len" for n in PRS]) + "};\r\n")
   file.close()
 
 if __name__ == "__main__":
@@ -0,0 +1,76 @@
+#ifndef JIT_BIT_H
+#define JIT_BIT_H
+//==================================================================================================
+// Emulated partial bitstreams. bit_h_gen.py writes the real jit_bit.h next to jit_isa.h; without it
+// this one is picked up through -Iemu. Word 0 of the image tags the operator for jit_emu.h, the rest
+// is padding; compressed and padded to 16 words like the output of pr.c (the tag, then a run of 15
+// 0xFFFFFFFF), _bit_len counts words. All 32 PR regions of jit.v get one, with the _PR_bit /
+// _PR_bit_len arrays bit_h_gen.py writes for VAM_BIT_ROW.
+//==================================================================================================
+#include "../jit_op.h"
+#include "jit_emu.h"
+
+#define EMU_BIT(NAME, OP)                                                                          \
+  static const unsigned int NAME##_bit[16] = {EMU_RLE_MAGIC, 0x00000001, EMU_BIT_MAGIC | (OP),     \
+    0x2000000F, 0xF0000000, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, \
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF};                                   \
+  static const unsigned int NAME##_bit_len = sizeof(NAME##_bit) / 4;
+
+#define EMU_BIT_PR(NAME, OP)                                                                          \
+  EMU_BIT(NAME##_PR1, OP) EMU_BIT(NAME##_PR2, OP) EMU_BIT(NAME##_PR3, OP) EMU_BIT(NAME##_PR4, OP)     \
+  EMU_BIT(NAME##_PR5, OP) EMU_BIT(NAME##_PR6, OP) EMU_BIT(NAME##_PR7, OP) EMU_BIT(NAME##_PR8, OP)     \
+  EMU_BIT(NAME##_PR9, OP) EMU_BIT(NAME##_PR10, OP) EMU_BIT(NAME##_PR11, OP) EMU_BIT(NAME##_PR12, OP)  \
+  EMU_BIT(NAME##_PR13, OP) EMU_BIT(NAME##_PR14, OP) EMU_BIT(NAME##_PR15, OP) EMU_BIT(NAME##_PR16, OP) \
+  EMU_BIT(NAME##_PR17, OP) EMU_BIT(NAME##_PR18, OP) EMU_BIT(NAME##_PR19, OP) EMU_BIT(NAME##_PR20, OP) \
+  EMU_BIT(NAME##_PR21, OP) EMU_BIT(NAME##_PR22, OP) EMU_BIT(NAME##_PR23, OP) EMU_BIT(NAME##_PR24, OP) \
+  EMU_BIT(NAME##_PR25, OP) EMU_BIT(NAME##_PR26, OP) EMU_BIT(NAME##_PR27, OP) EMU_BIT(NAME##_PR28, OP) \
+  EMU_BIT(NAME##_PR29, OP) EMU_BIT(NAME##_PR30, OP) EMU_BIT(NAME##_PR31, OP) EMU_BIT(NAME##_PR32, OP) \
+  static const unsigned int *NAME##_PR_bit[] = {                                                      \
+    NAME##_PR1_bit, NAME##_PR2_bit, NAME##_PR3_bit, NAME##_PR4_bit,                                   \
+    NAME##_PR5_bit, NAME##_PR6_bit, NAME##_PR7_bit, NAME##_PR8_bit,                                   \
+    NAME##_PR9_bit, NAME##_PR10_bit, NAME##_PR11_bit, NAME##_PR12_bit,                                \
+    NAME##_PR13_bit, NAME##_PR14_bit, NAME##_PR15_bit, NAME##_PR16_bit,                               \
+    NAME##_PR17_bit, NAME##_PR18_bit, NAME##_PR19_bit, NAME##_PR20_bit,                               \
+    NAME##_PR21_bit, NAME##_PR22_bit, NAME##_PR23_bit, NAME##_PR24_bit,                               \
+    NAME##_PR25_bit, NAME##_PR26_bit, NAME##_PR27_bit, NAME##_PR28_bit,                               \
+    NAME##_PR29_bit, NAME##_PR30_bit, NAME##_PR31_bit, NAME##_PR32_bit};                              \
+  static const unsigned int  NAME##_PR_bit_len[] = {                                                  \
+    NAME##_PR1_bit_len, NAME##_PR2_bit_len, NAME##_PR3_bit_len, NAME##_PR4_bit_len,                   \
+    NAME##_PR5_bit_len, NAME##_PR6_bit_len, NAME##_PR7_bit_len, NAME##_PR8_bit_len,                   \
+    NAME##_PR9_bit_len, NAME##_PR10_bit_len, NAME##_PR11_bit_len, NAME##_PR12_bit_len,                \
+    NAME##_PR13_bit_len, NAME##_PR14_bit_len, NAME##_PR15_bit_len, NAME##_PR16_bit_len,               \
+    NAME##_PR17_bit_len, NAME##_PR18_bit_len, NAME##_PR19_bit_len, NAME##_PR20_bit_len,               \
+    NAME##_PR21_bit_len, NAME##_PR22_bit_len, NAME##_PR23_bit_len, NAME##_PR24_bit_len,               \
+    NAME##_PR25_bit_len, NAME##_PR26_bit_len, NAME##_PR27_bit_len, NAME##_PR28_bit_len,               \
+    NAME##_PR29_bit_len, NAME##_PR30_bit_len, NAME##_PR31_bit_len, NAME##_PR32_bit_len};
+
+EMU_BIT_PR(MergeUnit,     MERGE)
+EMU_BIT_PR(InsertionUnit, INSERTION)
+EMU_BIT_PR(acc_vadd,      VADD)
+EMU_BIT_PR(acc_vmul,      VMUL)
+EMU_BIT_PR(acc_vredu,     VREDUCE)
+EMU_BIT_PR(acc_f_avg,     SQLAVG)
+EMU_BIT_PR(acc_f_less,    SQLLESS)
+EMU_BIT_PR(acc_f_large,   SQLLARGE)
+EMU_BIT_PR(acc_mm,        ACCMM)
+EMU_BIT_PR(acc_mmm,       ACCMMM)
+EMU_BIT_PR(acc_a2pb2,     A2PB2)
+EMU_BIT_PR(acc_vapbb,     VAPBB)
+EMU_BIT_PR(acc_vaapb,     VAAPB)
+
+#define HAVE_acc_f_avg
+#define HAVE_acc_f_less
+#define HAVE_acc_f_large
+#define HAVE_acc_mm
+#define HAVE_acc_mmm
+#define HAVE_acc_a2pb2
+#define HAVE_acc_vapbb
+#define HAVE_acc_vaapb
+
+#define PACK_acc_vadd     (VPACK_I16 | VPACK_I8)
+#define PACK_acc_vmul     (VPACK_I16 | VPACK_I8)
+#define PACK_acc_a2pb2    (VPACK_I16 | VPACK_I8)
+#define PACK_acc_vapbb    (VPACK_I16 | VPACK_I8)
+#define PACK_acc_vaapb    (VPACK_I16 | VPACK_I8)
+
+#endif
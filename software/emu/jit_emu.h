@@ -0,0 +1,917 @@
+#ifndef JIT_EMU_H
+#define JIT_EMU_H
+//==================================================================================================
+// Functional model of the JIT overlay (firmware/jit.v) behind the PicoDrv stream interface.
+//
+//   stream 50        command words decoded like jit_dispatch.v (0xC0n size/arg, 0xB0 routing,
+//                    bit 16 for the shadow set, 0xF000nnnn burst headers skipped) and the PR
+//                    framing of prctrl.v (0xDn00BEEF ... 0xDn00DEAD); reads return the
+//                    completion records of jit_cq.v (0xBABE000n, tag, words, status), one held
+//                    per node and VCQ_LOST when it overwrote one not sent through the 1K-word
+//                    stream fifo yet, and the counter records of jit_perf.v (0xEn), with the
+//                    region ID of 0xEn10kkkk.
+//   stream 100       ICAP, expanded like jit_rle.v, the bitstream is only inspected for the emulator
+//                    tag (emu/jit_bit.h).
+//   stream j*10+11   node j input A, j*10+12 input B, j*10+13 output C. With JIT_DW = 128 their
+//                    transfers are whole 16-byte beats, padded like the converters of jit_width.v.
+//   WriteRam/ReadRam the on-board DRAM, which the DMA nodes of jit_dma.v (VDMA_RD / VDMA_WR of
+//                    jit_op.h, after the NUM_ACCs slots) stream to and from the crossbar, and the
+//                    PR reader (VPR_NODE) to the ICAP, like stream 100. The bursts of the readers
+//                    and of the writers go through the weighted round robin of jit_mux.v.
+//
+// Each node is a thread which runs the operator loaded by PR on the configured routing: inputs come
+// from the host FIFOs or from the crossbar, the result goes to the host FIFO, to the crossbar inputs
+// of every node whose job reads it (jit_fork.v) or to both, as selected by jit_couple.v. A node
+// holds one queued job, the shadow set of jit_dispatch.v, started as the running one is done.
+//
+// Environment knobs (all optional, 0 means unlimited / none):
+//   JIT_EMU_MBPS          bandwidth of each data stream in MB/s, per 32 bits of JIT_DW
+//   JIT_EMU_LINK_MBPS     bandwidth of the PCIe link of a card in MB/s per direction, shared by all
+//                         data streams and WriteRam/ReadRam: transfers queue behind each other
+//   JIT_EMU_LATENCY_US    fixed latency of each data stream transfer
+//   JIT_EMU_CMD_US        fixed latency of each stream 50 transfer, its commands apply after it
+//   JIT_EMU_ICAP_MBPS     bandwidth of the ICAP stream in MB/s
+//   JIT_EMU_FIFO_WORDS    depth of every stream FIFO in words
+//==================================================================================================
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <time.h>
+#include <deque>
+#include <vector>
+#include <algorithm>
+#include "../jit_op.h"
+#include "../jit_cpu.h"
+#include "pico_errors.h"
+
+#define EMU_MAX_NODES       (32 + VDMA_NODES + 1)   // SLOT[0 .. 31] of jit.v, the DMA nodes and the PR reader
+#define EMU_FIFO_WORDS      (1024 * 64)
+#define EMU_CHUNK_WORDS     4096
+#define EMU_CQ_WORDS        1024          // u_fifo_s50o of jit.v, between jit_cq.v and stream 50
+#define EMU_BIT_MAGIC       0xE3D00000    // word 0 of an emulated bitstream, low 16 bits = operator
+#define EMU_BIT_MASK        0xFFFF0000
+#define EMU_RLE_MAGIC       0x524C4531    // compressed bitstream of pr.c, MAGIC of jit_rle.v
+#define EMU_STREAM_CMD      50
+#define EMU_STREAM_ICAP     100
+#define EMU_PORT_A          0
+#define EMU_PORT_B          1
+#define EMU_PORT_C          2
+#define EMU_OUT_HOST        0
+#define EMU_OUT_XBAR        1
+#define EMU_OUT_BOTH        2
+
+typedef struct {
+  pthread_mutex_t       mutex;
+  pthread_cond_t        cond;
+  std::deque<uint32_t> *q;
+  size_t                cap;    // 0 means unbounded
+  size_t                hw;     // high-water mark in words, for the 0xE counters
+  int                   closed;
+}emu_fifo_t;
+
+typedef struct {
+  int       op;
+  uint32_t  size;   // words per input, {R1, R2}
+  uint32_t  arg;    // R3
+  uint32_t  tag;    // R4
+  int       srcA;   // 0 host, n node n - 1 through the crossbar
+  int       srcB;
+  int       dst;    // EMU_OUT_HOST, EMU_OUT_XBAR or EMU_OUT_BOTH
+  uint32_t  addr;   // DRAM byte address of a DMA node, {R5, R6}
+  uint64_t  t0;     // cycle it was loaded, its B command or its SWAP
+}emu_job_t;
+
+struct emu_card_t;
+
+typedef struct {
+  int                    id;
+  struct emu_card_t     *card;
+  uint32_t               R1, R2, R3, R4;
+  uint32_t               S1, S2, S3, S4;        // shadow set, written with bit 16 of the command
+  int                    arm;                   // rarm of jit_dispatch.v, shadow waits for SWAP
+  emu_job_t              shadow;                // the job of the shadow B command
+  uint32_t               R5, R6;                // DRAM address of a DMA node
+  int                    op;
+  std::deque<emu_job_t> *jobs;
+  emu_fifo_t             inA;
+  emu_fifo_t             inB;
+  emu_fifo_t             out;
+  emu_fifo_t             xinA;                  // crossbar inputs, filled by the node they read
+  emu_fifo_t             xinB;
+  pthread_t              thread;
+  uint64_t               perf[VPERF_COUNTERS];  // jit_perf.v, in 10 ns cycles, VPERF_CYCLES unused
+  uint64_t               perf_t0;               // cycle of the last clear
+  uint32_t               prid;                  // region ID of jit_perf.v, 0xEn10kkkk
+  uint64_t               grants;                // bursts of a DMA node since the last clear
+  uint64_t               waits;                 // AR / AW cycles it had a burst and another got it
+  int                    cq_pend;               // jit_cq.v: its completion record is not sent yet
+  uint32_t               cq_rec[VCQ_WORDS];
+}emu_node_t;
+
+typedef struct {
+  double           mbps;
+  double           latency_us;
+  double           cmd_us;
+  double           icap_mbps;
+  double           link_mbps;
+  double           busy_us[2];  // end of the last transfer booked on the link, to / from the card
+  pthread_mutex_t  mutex;
+}emu_link_t;
+
+// jit_mux.v (ARB 1, CONF 2'b01) in front of AR or AW of jit_dma.v, one burst per cycle. A node counts
+// as having a burst for its whole job, as if the AXI master were the bottleneck; grants run ahead
+// of the data, the node moves the words of a burst once it was granted.
+typedef struct {
+  int       rgnt;                 // port of the last burst
+  int       rleft;                // bursts left of its turn
+  uint32_t  left[VDMA_NODES];     // bursts of the job of each port not granted yet
+  uint32_t  banked[VDMA_NODES];   // granted, the words not moved yet
+  uint32_t  weight[VDMA_NODES];   // R3 of the node, 0 counts as 1
+}emu_arb_t;
+
+typedef struct emu_card_t {
+  int              id;
+  pthread_mutex_t  mutex;
+  pthread_cond_t   cond;
+  emu_node_t       node[EMU_MAX_NODES];
+  emu_fifo_t       rsp;       // stream 50 out, completion records only while EMU_CQ_WORDS has room
+  int              cq_ptr;    // jit_cq.v: round robin pointer of the held records
+  int              pr_node;   // node inside a BEEF/DEAD frame, -1 if none
+  uint32_t         pr_words;  // ICAP words received in the current frame
+  int              rle_state; // jit_rle.v: 0 pass-through, 1 header, 2 literal, 3 run word, 4 first word
+  uint32_t         rle_cnt;
+  emu_link_t       link;
+  emu_arb_t        arb[2];    // jit_dma.v: AR of the readers, AW of the writers, under mutex
+  pthread_mutex_t  dram_mutex;
+  std::vector<uint32_t> *dram;  // on-board DRAM, grown to the highest word used
+}emu_card_t;
+
+//==================================================================================================
+static void emu_fifo_init(emu_fifo_t *f, size_t cap)
+{
+  pthread_mutex_init(&f->mutex, NULL);
+  pthread_cond_init(&f->cond, NULL);
+  f->q      = new std::deque<uint32_t>;
+  f->cap    = cap;
+  f->hw     = 0;
+  f->closed = 0;
+}
+
+// Blocks while the FIFO is full, like the AXIS tready of jit_fifo.
+static int emu_fifo_push(emu_fifo_t *f, const uint32_t *buf, size_t n)
+{
+  size_t done = 0;
+  pthread_mutex_lock(&f->mutex);
+  while (done < n) {
+    while (f->cap != 0 && f->q->size() >= f->cap && !f->closed)
+      pthread_cond_wait(&f->cond, &f->mutex);
+    if (f->closed) break;
+    size_t room = (f->cap == 0) ? n - done : std::min(n - done, f->cap - f->q->size());
+    f->q->insert(f->q->end(), buf + done, buf + done + room);
+    f->hw = std::max(f->hw, f->q->size());
+    done += room;
+    pthread_cond_broadcast(&f->cond);
+  }
+  pthread_mutex_unlock(&f->mutex);
+  return (done == n) ? (int)n : PICO_ERR_STREAM_CLOSED;
+}
+
+static int emu_fifo_pop(emu_fifo_t *f, uint32_t *buf, size_t n)
+{
+  size_t done = 0;
+  pthread_mutex_lock(&f->mutex);
+  while (done < n) {
+    while (f->q->empty() && !f->closed)
+      pthread_cond_wait(&f->cond, &f->mutex);
+    if (f->q->empty()) break;
+    size_t take = std::min(n - done, f->q->size());
+    std::copy(f->q->begin(), f->q->begin() + take, buf + done);
+    f->q->erase(f->q->begin(), f->q->begin() + take);
+    done += take;
+    pthread_cond_broadcast(&f->cond);
+  }
+  pthread_mutex_unlock(&f->mutex);
+  return (done == n) ? (int)n : PICO_ERR_STREAM_CLOSED;
+}
+
+static size_t emu_fifo_level(emu_fifo_t *f)
+{
+  size_t n;
+  pthread_mutex_lock(&f->mutex);
+  n = f->q->size();
+  pthread_mutex_unlock(&f->mutex);
+  return n;
+}
+
+//==================================================================================================
+//  Operators
+//==================================================================================================
+// The operators are the CPU kernels of jit_cpu.h, one thread per node like the hardware slot.
+static int emu_op_inputs(int op)
+{
+  return vcpu_inputs(op);
+}
+
+// Streaming operators produce one output word per input word, the others need the whole job.
+static int emu_op_streaming(int op)
+{
+  switch (op) {
+    case VADD: case VSUB: case VMUL: case SQLLESS: case SQLLARGE: case NOP: return 1;
+    case A2PB2: case VAPBB: case VAAPB:                                   return 1;
+    default:                                                              return 0;
+  }
+}
+
+// Reductions accumulate chunk by chunk and return one beat, the sum in word 0.
+static int emu_op_reducing(int op)
+{
+  return op == VREDUCE || op == VADDREDUCE || op == VSUBREDUCE;
+}
+
+static int emu_op_run(int op, const uint32_t *a, const uint32_t *b, uint32_t *c, uint32_t n, uint32_t arg)
+{
+  return vcpu_run(op, (const int *)a, (const int *)b, (int *)c, (int)n, (int)arg, 1);
+}
+
+//==================================================================================================
+//  Node worker
+//==================================================================================================
+// Time base of the counters, cycles of the 100 MHz slot clock.
+static uint64_t emu_cycles(void)
+{
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return ((uint64_t)t.tv_sec * 1000000000ull + t.tv_nsec) / 10;
+}
+
+static void emu_pop_timed(emu_fifo_t *f, uint32_t *buf, size_t n, uint64_t *stall)
+{
+  uint64_t t = emu_cycles();
+  emu_fifo_pop(f, buf, n);
+  *stall += emu_cycles() - t;
+}
+
+static void emu_push_timed(emu_fifo_t *f, const uint32_t *buf, size_t n, uint64_t *block)
+{
+  uint64_t t = emu_cycles();
+  emu_fifo_push(f, buf, n);
+  *block += emu_cycles() - t;
+}
+
+// Adds what a job counted so far to the counters of its node. Done before the last output push too,
+// the host reading the counters as soon as it has its data. p[VPERF_CYCLES] is the cycle the counts
+// of p start at; like jit_perf.v, a cycle of a job not stalled or blocked is active, the cycles of
+// a node without a job are the idle ones.
+static void emu_perf_add(emu_node_t *n, const emu_job_t *job, uint64_t *p)
+{
+  uint64_t now  = emu_cycles();
+  uint64_t wait = p[VPERF_STALLA] + p[VPERF_STALLB] + p[VPERF_BLOCKC];
+  p[VPERF_ACTIVE]  = (now - p[VPERF_CYCLES] > wait) ? now - p[VPERF_CYCLES] - wait : 0;
+  p[VPERF_XBARIN]  = (job->srcA != 0 ? p[VPERF_WORDSA] : 0) + (job->srcB != 0 ? p[VPERF_WORDSB] : 0);
+  p[VPERF_XBAROUT] = (job->dst != EMU_OUT_HOST) ? p[VPERF_WORDSC] : 0;
+  pthread_mutex_lock(&n->card->mutex);
+  for (int i = VPERF_ACTIVE; i <= VPERF_XBAROUT; i++) n->perf[i] += p[i];
+  pthread_mutex_unlock(&n->card->mutex);
+  memset(p, 0, sizeof(uint64_t) * VPERF_COUNTERS);
+  p[VPERF_CYCLES] = now;
+}
+
+// SWAP of jit_dispatch.v: an armed slot loads its shadow set when it runs no job, the cycle of DONE
+// or at once when it was idle. The job at the front of jobs is the one running. Called with c->mutex
+// held.
+static void emu_node_swap(emu_node_t *n)
+{
+  if (!n->arm || !n->jobs->empty()) return;
+  n->R1  = n->shadow.size >> 16;
+  n->R2  = n->shadow.size & 0xFFFF;
+  n->R3  = n->shadow.arg;
+  n->R4  = n->shadow.tag;
+  n->shadow.t0 = emu_cycles();
+  n->jobs->push_back(n->shadow);
+  n->arm = 0;
+  pthread_cond_broadcast(&n->card->cond);
+}
+
+// jit_cq.v: the held records go out round robin from cq_ptr while the fifo of stream 50 out has
+// room for one. The counter records are not held back, the host reads them as it asks for them.
+// Called with c->mutex held.
+static void emu_cq_send(emu_card_t *c)
+{
+  int k;
+  while (emu_fifo_level(&c->rsp) + VCQ_WORDS <= EMU_CQ_WORDS) {
+    for (k = 0; k < EMU_MAX_NODES && !c->node[(c->cq_ptr + k) % EMU_MAX_NODES].cq_pend; k++);
+    if (k == EMU_MAX_NODES) return;
+    emu_node_t *n = &c->node[(c->cq_ptr + k) % EMU_MAX_NODES];
+    emu_fifo_push(&c->rsp, n->cq_rec, VCQ_WORDS);
+    n->cq_pend = 0;
+    c->cq_ptr  = (n->id + 1) % EMU_MAX_NODES;
+  }
+}
+
+// Reader (1) or writer (2) DMA node of jit_dma.v, the PR reader (3), 0 for a slot
+static int emu_dma_node(int id)
+{
+  if (id == VPR_NODE) return 3;
+  if (id < NUM_ACCs || id >= NUM_ACCs + VDMA_NODES) return 0;
+  return (id < NUM_ACCs + VDMA_RDS) ? 1 : 2;
+}
+
+// Port k of arbiter a is reader k (a = 0) or writer k (a = 1)
+static emu_node_t * emu_arb_node(emu_card_t *c, int a, int k)
+{
+  return &c->node[NUM_ACCs + a * VDMA_RDS + k];
+}
+
+// One AR / AW cycle of jit_mux.v: the port keeps its turn while it has bursts and rleft, else the
+// next one after it with a burst starts a turn of its weight. Called with c->mutex held.
+static void emu_arb_step(emu_card_t *c, int a)
+{
+  emu_arb_t *r     = &c->arb[a];
+  int        ports = a ? VDMA_WRS : VDMA_RDS;
+  int        p     = -1, k;
+
+  if (r->rleft > 0 && r->left[r->rgnt] > 0) p = r->rgnt;
+  for (k = 1; k <= ports && p < 0; k++)
+    if (r->left[(r->rgnt + k) % ports] > 0) {
+      p        = (r->rgnt + k) % ports;
+      r->rleft = std::max<uint32_t>(r->weight[p], 1);
+    }
+  if (p < 0) return;
+  r->rgnt = p;
+  r->rleft--;
+  r->left[p]--;
+  r->banked[p]++;
+  emu_arb_node(c, a, p)->grants++;
+  for (k = 0; k < ports; k++)
+    if (k != p && r->left[k] > 0) emu_arb_node(c, a, k)->waits++;
+}
+
+// n bursts for port k, the others granted on the way kept for their nodes
+static void emu_arb_take(emu_card_t *c, int a, int k, uint32_t n)
+{
+  emu_arb_t *r = &c->arb[a];
+  pthread_mutex_lock(&c->mutex);
+  while (r->banked[k] < n && r->left[k] > 0) emu_arb_step(c, a);
+  r->banked[k] -= std::min(r->banked[k], n);
+  pthread_mutex_unlock(&c->mutex);
+}
+
+static size_t emu_card_icap(emu_card_t *c, const uint32_t *w, size_t n);
+static void emu_link_wait(struct timeval *t0, double latency_us, double mbps, size_t bytes);
+static void emu_link_xfer(emu_card_t *c, struct timeval *t0, size_t bytes, int up);
+
+static void emu_dram(emu_card_t *c, uint64_t at, uint32_t *buf, size_t n, int write)
+{
+  pthread_mutex_lock(&c->dram_mutex);
+  if (c->dram->size() < at + n) c->dram->resize(at + n, 0);
+  if (write) std::copy(buf, buf + n, c->dram->begin() + at);
+  else       std::copy(c->dram->begin() + at, c->dram->begin() + at + n, buf);
+  pthread_mutex_unlock(&c->dram_mutex);
+}
+
+static emu_fifo_t * emu_src_fifo(emu_node_t *n, int src, int port)
+{
+  if (src == 0) return (port == EMU_PORT_A) ? &n->inA : &n->inB;
+  return (port == EMU_PORT_A) ? &n->xinA : &n->xinB;
+}
+
+// Output C of a job. The crossbar copy goes to every input whose node is running a job that reads
+// this one, waiting for the first of them to be configured; like jit_fork.v the next words wait
+// for the slowest reader.
+static void emu_out_push(emu_node_t *n, const emu_job_t *job, const uint32_t *buf, size_t k, uint64_t *block)
+{
+  emu_card_t              *c = n->card;
+  std::vector<emu_fifo_t *> to;
+  int                       i;
+
+  if (job->dst != EMU_OUT_XBAR) emu_push_timed(&n->out, buf, k, block);
+  if (job->dst == EMU_OUT_HOST || k == 0) return;
+
+  pthread_mutex_lock(&c->mutex);
+  while (to.empty()) {
+    for (i = 0; i < EMU_MAX_NODES; i++) {
+      emu_node_t *m = &c->node[i];
+      if (m->jobs->empty()) continue;
+      const emu_job_t &r = m->jobs->front();
+      if (r.srcA == n->id + 1)                                  to.push_back(&m->xinA);
+      if (r.srcB == n->id + 1 && emu_op_inputs(r.op) == 2)      to.push_back(&m->xinB);
+    }
+    if (to.empty()) pthread_cond_wait(&c->cond, &c->mutex);
+  }
+  pthread_mutex_unlock(&c->mutex);
+  for (i = 0; i < (int)to.size(); i++) emu_push_timed(to[i], buf, k, block);
+}
+
+// Job of a DMA node: a reader sends whole beats of DRAM to the crossbar, a writer stores the whole
+// beats of its A input, the PR reader sends 32-bit words to the ICAP. Returns the beats, the words
+// of its record as counted by jit_dma.v. The readers and the writers take their bursts from
+// emu_arb_step, the PR reader has an AXI master of its own.
+static uint32_t emu_dma_run(emu_node_t *n, const emu_job_t *job, uint64_t *p)
+{
+  emu_card_t *c     = n->card;
+  int         type  = emu_dma_node(n->id);
+  int         arb   = type - 1, port = n->id - NUM_ACCs - ((type == 2) ? VDMA_RDS : 0);
+  uint32_t    bw    = (type == 3) ? 1 : JIT_BEAT_WORDS;
+  uint32_t    beats = (job->size + bw - 1) / bw;
+  uint32_t    left  = beats * bw, k;
+  uint64_t    at    = job->addr / 4;
+  uint32_t    bb    = bw * 4, a = job->addr, l, got = 0, need;
+  uint64_t    done  = 0, granted = 0, w;
+  std::vector<uint32_t> b(EMU_CHUNK_WORDS), len;
+  struct timeval t0;
+
+  // bursts of jit_dma.v: up to 16 beats, never across 4 KB, in words
+  for (left = beats; left > 0; left -= l, a += l * bb) {
+    l = std::min<uint32_t>(std::min<uint32_t>(left, 16), (4096 - a % 4096) / bb);
+    len.push_back(l * bw);
+  }
+  pthread_mutex_lock(&c->mutex);
+  if (type == 3) {
+    n->grants += len.size();
+  } else {
+    c->arb[arb].left[port]   = len.size();
+    c->arb[arb].banked[port] = 0;
+    c->arb[arb].weight[port] = job->arg & 0xF;
+  }
+  pthread_mutex_unlock(&c->mutex);
+  left = beats * bw;
+
+  while (left > 0) {
+    k = std::min<uint32_t>(left, EMU_CHUNK_WORDS);
+    // the bursts holding these words
+    for (need = 0, w = granted; w < done + k; w += len[got + need], need++);
+    if (type == 3) {
+      gettimeofday(&t0, NULL);
+      emu_dram(c, at, b.data(), k, 0);
+      emu_link_wait(&t0, 0, c->link.icap_mbps, emu_card_icap(c, b.data(), k) * 4);
+    } else if (type == 1) {
+      emu_arb_take(c, arb, port, need);
+      emu_dram(c, at, b.data(), k, 0);
+      emu_out_push(n, job, b.data(), k, &p[VPERF_BLOCKC]);
+      p[VPERF_WORDSC] += k;
+    } else {
+      emu_pop_timed(&n->xinA, b.data(), k, &p[VPERF_STALLA]);
+      emu_arb_take(c, arb, port, need);
+      emu_dram(c, at, b.data(), k, 1);
+      p[VPERF_WORDSA] += k;
+    }
+    got     += need;
+    granted  = w;
+    done    += k;
+    at      += k;
+    left    -= k;
+  }
+  return beats;
+}
+
+static void * emu_node_Threads_Call(void *pk)
+{
+  emu_node_t *n = (emu_node_t *)pk;
+  emu_card_t *c = n->card;
+  std::vector<uint32_t> a, b, o;
+  uint64_t    done = 0;
+
+  while (1) {
+    pthread_mutex_lock(&c->mutex);
+    while (n->jobs->empty())
+      pthread_cond_wait(&c->cond, &c->mutex);
+    emu_job_t job = n->jobs->front();
+    pthread_mutex_unlock(&c->mutex);
+
+    emu_fifo_t *fa  = emu_src_fifo(n, job.srcA, EMU_PORT_A);
+    emu_fifo_t *fb  = emu_src_fifo(n, job.srcB, EMU_PORT_B);
+    int         two = emu_op_inputs(job.op) == 2;
+    uint32_t    outw;
+    uint64_t    p[VPERF_COUNTERS] = {0};
+
+    // the job counts from its load, or from the end of the one before it in jobs
+    p[VPERF_CYCLES] = std::max(job.t0, done);
+    #ifdef VERBOSE_EMU
+      printf("[DEBUG->EMU] card %d node %d op %d size %u srcA %d srcB %d dst %d\r\n", c->id, n->id, job.op, job.size, job.srcA, job.srcB, job.dst);
+    #endif
+
+    if (emu_dma_node(n->id)) {
+      outw = emu_dma_run(n, &job, p);
+    } else if (emu_op_streaming(job.op)) {
+      uint32_t left = job.size;
+      a.resize(EMU_CHUNK_WORDS);
+      b.resize(EMU_CHUNK_WORDS);
+      o.resize(EMU_CHUNK_WORDS);
+      while (left > 0) {
+        uint32_t k = std::min<uint32_t>(left, EMU_CHUNK_WORDS);
+        emu_pop_timed(fa, a.data(), k, &p[VPERF_STALLA]);
+        if (two) emu_pop_timed(fb, b.data(), k, &p[VPERF_STALLB]);
+        emu_op_run(job.op, a.data(), b.data(), o.data(), k, job.arg);
+        p[VPERF_WORDSA] += k;
+        p[VPERF_WORDSB] += two ? k : 0;
+        p[VPERF_WORDSC] += k;
+        if (left == k) emu_perf_add(n, &job, p);
+        emu_out_push(n, &job, o.data(), k, &p[VPERF_BLOCKC]);
+        left -= k;
+      }
+      outw = job.size;
+    } else if (emu_op_reducing(job.op)) {
+      uint32_t left = job.size, beat[4] = {0, 0, 0, 0}, part;
+      a.resize(EMU_CHUNK_WORDS);
+      b.resize(EMU_CHUNK_WORDS);
+      while (left > 0) {
+        uint32_t k = std::min<uint32_t>(left, EMU_CHUNK_WORDS);
+        emu_pop_timed(fa, a.data(), k, &p[VPERF_STALLA]);
+        if (two) emu_pop_timed(fb, b.data(), k, &p[VPERF_STALLB]);
+        emu_op_run(job.op, a.data(), b.data(), &part, k, job.arg);
+        beat[0] += part;
+        left    -= k;
+      }
+      p[VPERF_WORDSA] = job.size;
+      p[VPERF_WORDSB] = two ? job.size : 0;
+      p[VPERF_WORDSC] = 4;
+      emu_perf_add(n, &job, p);
+      emu_out_push(n, &job, beat, 4, &p[VPERF_BLOCKC]);
+      outw = 4;
+    } else {
+      a.resize(job.size);
+      b.resize(two ? job.size : 0);
+      o.resize(std::max<uint32_t>(vcpu_out_size(job.op, job.size), job.size));
+      emu_pop_timed(fa, a.data(), job.size, &p[VPERF_STALLA]);
+      if (two) emu_pop_timed(fb, b.data(), job.size, &p[VPERF_STALLB]);
+      uint32_t k = emu_op_run(job.op, a.data(), b.data(), o.data(), job.size, job.arg);
+      p[VPERF_WORDSA] = job.size;
+      p[VPERF_WORDSB] = two ? job.size : 0;
+      p[VPERF_WORDSC] = k;
+      emu_perf_add(n, &job, p);
+      emu_out_push(n, &job, o.data(), k, &p[VPERF_BLOCKC]);
+      outw = k;
+    }
+
+    // the width converters of a DW-bit card: the rest of the last input beat is dropped, the last
+    // output beat is filled with zeros
+    if (JIT_BEAT_WORDS > 1 && !emu_dma_node(n->id)) {
+      uint32_t pad[JIT_BEAT_WORDS] = {0};
+      uint32_t in  = (JIT_BEAT_WORDS - job.size % JIT_BEAT_WORDS) % JIT_BEAT_WORDS;
+      uint32_t out = (JIT_BEAT_WORDS - outw     % JIT_BEAT_WORDS) % JIT_BEAT_WORDS;
+      emu_fifo_pop(fa, pad, in);
+      if (two) emu_fifo_pop(fb, pad, in);
+      memset(pad, 0, sizeof(pad));
+      emu_out_push(n, &job, pad, out, &p[VPERF_BLOCKC]);
+    }
+
+    emu_perf_add(n, &job, p);
+    pthread_mutex_lock(&c->mutex);
+    // DONE: one record held per node, one not sent yet is overwritten and the new one says so
+    n->cq_rec[0] = VCQ_MAGIC | (uint32_t)(n->id + 1);
+    n->cq_rec[1] = job.tag;
+    n->cq_rec[2] = outw;
+    n->cq_rec[3] = ((job.dst != EMU_OUT_HOST) ? VCQ_XBAR : 0u) | (n->cq_pend ? VCQ_LOST : 0u);
+    n->cq_pend   = 1;
+    emu_cq_send(c);
+    n->jobs->pop_front();
+    done = emu_cycles();
+    emu_node_swap(n);
+    pthread_mutex_unlock(&c->mutex);
+  }
+  return NULL;
+}
+
+//==================================================================================================
+//  Card
+//==================================================================================================
+static double emu_env(const char *name, double def)
+{
+  const char *v = getenv(name);
+  return (v != NULL) ? atof(v) : def;
+}
+
+static emu_card_t * emu_card_new(void)
+{
+  static int cards = 0;
+  int i;
+  emu_card_t *c = new emu_card_t;
+  size_t depth  = (size_t)emu_env("JIT_EMU_FIFO_WORDS", EMU_FIFO_WORDS);
+
+  c->id              = cards++;
+  c->pr_node         = -1;
+  c->pr_words        = 0;
+  c->rle_state       = 4;
+  c->rle_cnt         = 0;
+  c->link.mbps       = emu_env("JIT_EMU_MBPS",       0) * JIT_BEAT_WORDS;
+  c->link.latency_us = emu_env("JIT_EMU_LATENCY_US", 0);
+  c->link.cmd_us     = emu_env("JIT_EMU_CMD_US",     0);
+  c->link.icap_mbps  = emu_env("JIT_EMU_ICAP_MBPS",  0);
+  c->link.link_mbps  = emu_env("JIT_EMU_LINK_MBPS",  0);
+  c->link.busy_us[0] = c->link.busy_us[1] = 0;
+  pthread_mutex_init(&c->link.mutex, NULL);
+  pthread_mutex_init(&c->mutex, NULL);
+  pthread_cond_init(&c->cond, NULL);
+  pthread_mutex_init(&c->dram_mutex, NULL);
+  c->dram = new std::vector<uint32_t>;
+  emu_fifo_init(&c->rsp, 0);
+  c->cq_ptr          = 0;
+  memset(c->arb, 0, sizeof(c->arb));
+
+  for (i = 0; i < EMU_MAX_NODES; i++) {
+    emu_node_t *n = &c->node[i];
+    n->id   = i;
+    n->card = c;
+    n->R1   = 0;
+    n->R2   = 0;
+    n->R3   = 0;
+    n->R4   = 0;
+    n->S1   = n->S2 = n->S3 = n->S4 = 0;
+    n->arm  = 0;
+    n->R5   = n->R6 = 0;
+    n->op   = NOP;
+    memset(n->perf, 0, sizeof(n->perf));
+    n->perf_t0 = emu_cycles();
+    n->prid    = 0;
+    n->grants  = 0;
+    n->waits   = 0;
+    n->cq_pend = 0;
+    n->jobs = new std::deque<emu_job_t>;
+    emu_fifo_init(&n->inA,  depth);
+    emu_fifo_init(&n->inB,  depth);
+    emu_fifo_init(&n->out,  depth);
+    emu_fifo_init(&n->xinA, depth);
+    emu_fifo_init(&n->xinB, depth);
+    pthread_create(&n->thread, NULL, emu_node_Threads_Call, (void *)n);
+    pthread_detach(n->thread);
+  }
+  return c;
+}
+
+// One word of stream 50, decoded as in jit_dispatch.v and prctrl.v. Called with c->mutex held.
+static void emu_card_cmd(emu_card_t *c, uint32_t w)
+{
+  int op   = (w >> 28) & 0xF;
+  int accn = VCMD_SLOTOF(w);
+  int regn = (w >> 20) & 0xF;
+
+  if (w == 0xDEADBEEF || w == 0xBABEFACE) return;     // fillers of the 4-word command packets
+  if (accn == 0 || accn > EMU_MAX_NODES) return;
+  emu_node_t *n = &c->node[accn - 1];
+
+  switch (op) {
+    case 0xC: {
+      if (w & VCMD_SHADOW) {
+        if (regn == 1) n->S1 = w & 0xFFFF;
+        if (regn == 2) n->S2 = w & 0xFFFF;
+        if (regn == 3) n->S3 = w & 0xFFFF;
+        if (regn == 4) n->S4 = w & 0xFFFF;
+      } else {
+        if (regn == 1) n->R1 = w & 0xFFFF;
+        if (regn == 2) n->R2 = w & 0xFFFF;
+        if (regn == 3) n->R3 = w & 0xFFFF;
+        if (regn == 4) n->R4 = w & 0xFFFF;
+        if (regn == 5) n->R5 = w & 0xFFFF;
+        if (regn == 6) n->R6 = w & 0xFFFF;
+      }
+    }break;
+
+    case 0xB: {
+      emu_job_t job;
+      int       shadow = (w & VCMD_SHADOW) != 0;
+      job.op   = n->op;
+      job.size = shadow ? (n->S1 << 16 | n->S2) : (n->R1 << 16 | n->R2);
+      job.arg  = shadow ? n->S3 : n->R3;
+      job.tag  = shadow ? n->S4 : n->R4;
+      job.srcA = VCMD_SRCAOF(w);
+      job.srcB = VCMD_SRCBOF(w);
+      job.dst  = (((w >> 8) & 0xF) == 0xF) ? EMU_OUT_XBAR : (((w >> 8) & 0xF) == 0xE) ? EMU_OUT_BOTH : EMU_OUT_HOST;
+      job.addr = n->R5 << 16 | n->R6;
+      // one shadow job per slot: a second one before the SWAP replaces the first, as the set does
+      if (shadow) {
+        n->shadow = job;
+        n->arm    = 1;
+        emu_node_swap(n);
+        break;
+      }
+      job.t0   = emu_cycles();
+      n->jobs->push_back(job);
+      pthread_cond_broadcast(&c->cond);
+    }break;
+
+    case 0xE: {
+      emu_fifo_t *f[5] = {&n->inA, &n->inB, &n->out, &n->xinA, &n->xinB};
+      uint32_t    rec[VPERF_WORDS];
+      size_t      hw[5];
+      uint64_t    now = emu_cycles();
+      int         i;
+      if (regn == 1) n->prid = w & 0xFFFF;
+      if (regn != 0) break;
+      // jit_dma.v: cycles, bursts and the cycles another node of the arbiter got the burst
+      if (emu_dma_node(accn - 1)) {
+        memset(rec, 0, sizeof(rec));
+        rec[0]                = 0xE0000000 | VCMD_SLOT(accn) | VPERF_COUNTERS;
+        rec[VPERF_CYCLES + 1] = (uint32_t)(now - n->perf_t0);
+        rec[VPERF_GRANTS + 1] = (uint32_t)n->grants;
+        rec[VPERF_WAITS  + 1] = (uint32_t)n->waits;
+        rec[VPERF_PRID]       = VPERF_PRID_TAG;
+        rec[VPERF_WORDS - 1]  = 0xBABEFACE;
+        if (w & 1) {
+          n->grants  = 0;
+          n->waits   = 0;
+          n->perf_t0 = now;
+        }
+        emu_fifo_push(&c->rsp, rec, VPERF_WORDS);
+        break;
+      }
+      for (i = 0; i < 5; i++) {
+        pthread_mutex_lock(&f[i]->mutex);
+        hw[i] = f[i]->hw;
+        if (w & 1) f[i]->hw = f[i]->q->size();
+        pthread_mutex_unlock(&f[i]->mutex);
+      }
+      rec[0] = 0xE0000000 | VCMD_SLOT(accn) | VPERF_COUNTERS;
+      for (i = 0; i < VPERF_COUNTERS; i++) rec[i + 1] = (uint32_t)n->perf[i];
+      rec[VPERF_CYCLES + 1] = (uint32_t)(now - n->perf_t0);
+      rec[VPERF_HWA    + 1] = (uint32_t)(std::max(hw[0], hw[3]) / JIT_BEAT_WORDS);
+      rec[VPERF_HWB    + 1] = (uint32_t)(std::max(hw[1], hw[4]) / JIT_BEAT_WORDS);
+      rec[VPERF_HWC    + 1] = (uint32_t)(hw[2] / JIT_BEAT_WORDS);
+      rec[VPERF_PRID]       = VPERF_PRID_TAG | n->prid;
+      rec[VPERF_WORDS - 1]  = 0xBABEFACE;
+      if (w & 1) {
+        memset(n->perf, 0, sizeof(n->perf));
+        n->perf_t0 = now;
+      }
+      emu_fifo_push(&c->rsp, rec, VPERF_WORDS);
+    }break;
+
+    case 0xD: {
+      if ((w & 0x00F9FFFF) == 0x0000BEEF) {
+        c->pr_node   = accn - 1;
+        c->pr_words  = 0;
+        n->prid      = 0;
+        c->rle_state = 4;   // RESTART of jit_rle.v
+        c->rle_cnt   = 0;
+      }
+      if ((w & 0x00F9FFFF) == 0x0000DEAD && c->pr_node == accn - 1) {
+        c->pr_node  = -1;
+      }
+    }break;
+
+    default: break;
+  }
+}
+
+// Only the tag word of an emulated bitstream matters, a real one leaves the node as NOP.
+static void emu_card_icap_word(emu_card_t *c, uint32_t w, size_t n)
+{
+  if (c->pr_node < 0 || n == 0) return;
+  if (c->pr_words == 0) {
+    int op = ((w & EMU_BIT_MASK) == EMU_BIT_MAGIC) ? (int)(w & 0xFFFF) : NOP;
+    if (op == NOP)
+      fprintf(stderr, "[EMU] card %d node %d: bitstream has no emulator tag, node left as NOP\n", c->id, c->pr_node);
+    c->node[c->pr_node].op = op;
+  }
+  c->pr_words += n;
+}
+
+// Expands the packets of jit_rle.v, returns the words the ICAP took. EMU_RLE_MAGIC starts a
+// compressed image only as the first word after a PR start, anywhere else it is a bitstream word.
+static size_t emu_card_icap(emu_card_t *c, const uint32_t *w, size_t n)
+{
+  size_t   i, icap = 0;
+  uint32_t cnt;
+
+  for (i = 0; i < n; i++) {
+    cnt = w[i] & 0x0FFFFFFF;
+    switch (c->rle_state) {
+      case 4:
+        if (w[i] == EMU_RLE_MAGIC) { c->rle_state = 1; break; }
+        c->rle_state = 0;
+        // fall through
+      case 0:
+        emu_card_icap_word(c, w[i], 1); icap++;
+        break;
+      case 1:
+        c->rle_cnt = cnt;
+        switch (w[i] >> 28) {
+          case 0x0: if (cnt > 0) c->rle_state = 2;                                  break;
+          case 0x1: emu_card_icap_word(c, 0x00000000, cnt); icap += cnt;             break;
+          case 0x2: emu_card_icap_word(c, 0xFFFFFFFF, cnt); icap += cnt;             break;
+          case 0x3: c->rle_state = 3;                                                break;
+          case 0xF: c->rle_state = 0;                                                break;
+          default:                                                                   break;
+        }
+        break;
+      case 2:
+        emu_card_icap_word(c, w[i], 1); icap++;
+        if (--c->rle_cnt == 0) c->rle_state = 1;
+        break;
+      case 3:
+        emu_card_icap_word(c, w[i], c->rle_cnt); icap += c->rle_cnt;
+        c->rle_state = 1;
+        break;
+    }
+  }
+  return icap;
+}
+
+static void emu_link_wait(struct timeval *t0, double latency_us, double mbps, size_t bytes)
+{
+  struct timeval t1;
+  double target = latency_us + ((mbps > 0) ? bytes / mbps : 0); // 1 MB/s moves 1 byte per us
+  gettimeofday(&t1, NULL);
+  double spent  = 1000000.0 * (t1.tv_sec - t0->tv_sec) + (t1.tv_usec - t0->tv_usec);
+  if (target > spent) usleep((useconds_t)(target - spent));
+}
+
+// A data transfer started at t0: the stream bandwidth, and its turn on the shared link when it is
+// modelled, whichever ends last, plus the latency
+static void emu_link_xfer(emu_card_t *c, struct timeval *t0, size_t bytes, int up)
+{
+  double us = (c->link.mbps > 0) ? bytes / c->link.mbps : 0;
+  if (c->link.link_mbps > 0) {
+    double at = 1000000.0 * t0->tv_sec + t0->tv_usec, end;
+    pthread_mutex_lock(&c->link.mutex);
+    end = std::max(at, c->link.busy_us[up]) + bytes / c->link.link_mbps;
+    c->link.busy_us[up] = end;
+    pthread_mutex_unlock(&c->link.mutex);
+    us = std::max(us, end - at);
+  }
+  emu_link_wait(t0, c->link.latency_us + us, 0, bytes);
+}
+
+static int emu_stream_node(int stream, int *port)
+{
+  if (stream < 11 || (stream - 11) % 10 > 2) return -1;
+  *port = (stream - 11) % 10;
+  return ((stream - 11) / 10 < EMU_MAX_NODES) ? (stream - 11) / 10 : -1;
+}
+
+static int emu_card_write(emu_card_t *c, int stream, const void *buf, int size)
+{
+  struct timeval  t0;
+  const uint32_t *w = (const uint32_t *)buf;
+  int             port, node, i, err = size;
+
+  if (size % 4 != 0) return PICO_ERR_BAD_SIZE;
+  gettimeofday(&t0, NULL);
+
+  if (stream == EMU_STREAM_CMD) {
+    // the words reach the dispatcher when the transfer is done
+    emu_link_wait(&t0, c->link.cmd_us, 0, size);
+    pthread_mutex_lock(&c->mutex);
+    for (i = 0; i < size / 4; i++) emu_card_cmd(c, w[i]);
+    pthread_mutex_unlock(&c->mutex);
+  } else if (stream == EMU_STREAM_ICAP) {
+    emu_link_wait(&t0, 0, c->link.icap_mbps, emu_card_icap(c, w, size / 4) * 4);
+  } else if ((node = emu_stream_node(stream, &port)) >= 0 && port != EMU_PORT_C) {
+    if (size % JIT_BEAT_BYTES != 0) return PICO_ERR_BAD_SIZE;
+    err = emu_fifo_push(port == EMU_PORT_A ? &c->node[node].inA : &c->node[node].inB, w, size / 4);
+    emu_link_xfer(c, &t0, size, 0);
+  } else {
+    return PICO_ERR_BAD_STREAM;
+  }
+  return (err < 0) ? err : size;
+}
+
+static int emu_card_read(emu_card_t *c, int stream, void *buf, int size)
+{
+  struct timeval t0;
+  int            port, node, err;
+
+  if (size % 4 != 0) return PICO_ERR_BAD_SIZE;
+  gettimeofday(&t0, NULL);
+
+  if (stream == EMU_STREAM_CMD) {
+    err = emu_fifo_pop(&c->rsp, (uint32_t *)buf, size / 4);
+    pthread_mutex_lock(&c->mutex);
+    emu_cq_send(c);
+    pthread_mutex_unlock(&c->mutex);
+    emu_link_wait(&t0, c->link.cmd_us, 0, size);
+  } else if ((node = emu_stream_node(stream, &port)) >= 0 && port == EMU_PORT_C) {
+    if (size % JIT_BEAT_BYTES != 0) return PICO_ERR_BAD_SIZE;
+    err = emu_fifo_pop(&c->node[node].out, (uint32_t *)buf, size / 4);
+    emu_link_xfer(c, &t0, size, 1);
+  } else {
+    return PICO_ERR_BAD_STREAM;
+  }
+  return (err < 0) ? err : size;
+}
+
+// PicoDrv::WriteRam / ReadRam, at the data stream bandwidth and through the link
+static int emu_card_ram(emu_card_t *c, uint64_t addr, void *buf, int size, int write)
+{
+  struct timeval t0;
+  if (size % 4 != 0 || addr % 4 != 0) return PICO_ERR_BAD_SIZE;
+  gettimeofday(&t0, NULL);
+  emu_dram(c, addr / 4, (uint32_t *)buf, size / 4, write);
+  emu_link_xfer(c, &t0, size, !write);
+  return size;
+}
+
+static int emu_card_available(emu_card_t *c, int stream, bool reading)
+{
+  int port, node;
+  if (stream == EMU_STREAM_CMD) return (int)emu_fifo_level(&c->rsp) * 4;
+  if ((node = emu_stream_node(stream, &port)) < 0) return PICO_ERR_BAD_STREAM;
+  if (reading) return (port == EMU_PORT_C) ? (int)emu_fifo_level(&c->node[node].out) * 4 : 0;
+  emu_fifo_t *f = (port == EMU_PORT_A) ? &c->node[node].inA : &c->node[node].inB;
+  return (port == EMU_PORT_C) ? 0 : (int)(f->cap - emu_fifo_level(f)) * 4;
+}
+
+#endif
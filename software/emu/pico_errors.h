@@ -0,0 +1,32 @@
+#ifndef PICO_ERRORS_H
+#define PICO_ERRORS_H
+//==================================================================================================
+// Software stand-in for the Pico error helpers, see picodrv.h in this directory.
+//==================================================================================================
+#include <stdio.h>
+
+#define PICO_SUCCESS              0
+#define PICO_ERR_NO_CARD         -1
+#define PICO_ERR_BAD_STREAM      -2
+#define PICO_ERR_BAD_SIZE        -3
+#define PICO_ERR_STREAM_CLOSED   -4
+
+static inline const char * PicoErrors_String(int err)
+{
+  switch (err) {
+    case PICO_SUCCESS            : return "Success";
+    case PICO_ERR_NO_CARD        : return "No emulated card available";
+    case PICO_ERR_BAD_STREAM     : return "Stream is not implemented by the emulated overlay";
+    case PICO_ERR_BAD_SIZE       : return "Transfer size is not a multiple of the stream width";
+    case PICO_ERR_STREAM_CLOSED  : return "Stream was closed during the transfer";
+    default                      : return "Unknown error";
+  }
+}
+
+static inline char * PicoErrors_FullError(int err, char *buf, int size)
+{
+  snprintf(buf, size, "[EMU] error %d: %s", err, PicoErrors_String(err));
+  return buf;
+}
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef PICODRV_H
+#define PICODRV_H
+//==================================================================================================
+// Software stand-in for the Pico driver. Build the host code with -Iemu (see Makefile.emu) and it
+// runs against the functional card model of jit_emu.h instead of an M-505 board.
+//==================================================================================================
+#include <unistd.h>
+#include "pico_errors.h"
+#include "jit_emu.h"
+
+typedef struct {
+  int model;
+}PICO_CONFIG;
+
+class PicoDrv {
+public:
+  PicoDrv() { card = emu_card_new(); }
+
+  int CreateStream(int stream)                             { return stream; }
+  void CloseStream(int stream)                             { (void)stream; }
+  int WriteStream(int stream, const void *buf, int size)   { return emu_card_write(card, stream, buf, size); }
+  int ReadStream(int stream, void *buf, int size)          { return emu_card_read(card, stream, buf, size); }
+  int GetBytesAvailable(int stream, bool reading)          { return emu_card_available(card, stream, reading); }
+  int WriteRam(uint64_t addr, void *buf, int size, int flags = 0) { (void)flags; return emu_card_ram(card, addr, buf, size, 1); }
+  int ReadRam(uint64_t addr, void *buf, int size, int flags = 0)  { (void)flags; return emu_card_ram(card, addr, buf, size, 0); }
+
+  emu_card_t *card;
+};
+
+static inline int FindPico(PICO_CONFIG *cfg, PicoDrv **drv)
+{
+  (void)cfg;
+  #ifdef VERBOSE_EMU
+    printf("[DEBUG->EMU] FindPico model 0x%x\r\n", cfg->model);
+  #endif
+  *drv = new PicoDrv();
+  return PICO_SUCCESS;
+}
+
+static inline int FindPico(int model, PicoDrv **drv)
+{
+  PICO_CONFIG cfg;
+  cfg.model = model;
+  return FindPico(&cfg, drv);
+}
+
+// The static bitstream is not parsed, every card comes up with the overlay of jit.v.
+static inline int RunBitFile(const char *bitFileName, PicoDrv **drv)
+{
+  #ifdef VERBOSE_EMU
+    printf("[DEBUG->EMU] RunBitFile '%s'\r\n", bitFileName);
+  #endif
+  (void)bitFileName;
+  *drv = new PicoDrv();
+  return PICO_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,680 @@
+#ifndef JIT_CPU_H
+#define JIT_CPU_H
+//==================================================================================================
+// CPU kernels behind the overlay operator IDs of jit_op.h, bit-exact with the accelerators:
+//
+//   VADD/VSUB/VMUL      C[i] = A[i] op B[i], 32-bit wrap-around
+//   A2PB2/VAPBB/VAAPB   C[i] = A[i]^2 + B[i]^2 / A[i] + B[i]^2 / A[i]^2 + B[i]
+//                       arg VPACK_I16/VPACK_I8: the same inside every 16/8-bit lane of the words
+//   VREDUCE             C[0] = sum A[i]            mod 2^32
+//   VADDREDUCE          C[0] = sum (A[i] + B[i])   mod 2^32
+//   VSUBREDUCE          C[0] = sum (A[i] - B[i])   mod 2^32
+//   SQLLESS/SQLLARGE    C[i] = A[i] < K / A[i] > K ? A[i] : VCPU_NULL, K = (int16_t)arg
+//   SQLAVG              C[0..3] = {avg, count, sum low, sum high} over the non VCPU_NULL words
+//   INSERTION           C = A sorted ascending (signed), VCPU_PADDING words kept at the tail
+//   MERGE               C = merge of the sorted runs A and B (size words each), padding at the tail
+//   ACCMM               C = A x B for each pair of VCPU_TILE x VCPU_TILE row-major tiles in A / B
+//   ACCMMM              C[0..TILE^2) = sum over the tile pairs of A x B, 32-bit wrap-around
+//
+// AVX-512 / AVX2 / scalar is picked at run time (JIT_CPU_ISA=avx512|avx2|scalar overrides it) and
+// large jobs are split over VCPU_THREADS pthreads. vcpu() returns the number of words written to C.
+//==================================================================================================
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <immintrin.h>
+#include <algorithm>
+#include <vector>
+#include "jit_op.h"
+
+#define VCPU_NULL         ((int)0x80000000)
+#define VCPU_PADDING      ((int)0xDEADBEEF)
+#define VCPU_MAX_THREADS  64
+#define VCPU_MT_MIN       (1024 * 64)      // words per job below which one thread is used
+#define VCPU_TILE         16               // ACCMM/ACCMMM tile edge
+#define VCPU_SCALAR       0
+#define VCPU_AVX2         1
+#define VCPU_AVX512       2
+
+typedef struct {
+  int         op;
+  const int  *A;
+  const int  *B;
+  int        *C;
+  int         size;
+  int         arg;
+  int64_t     sum;      // partials of the reductions
+  int64_t     count;
+}vcpu_pk_t;
+
+//==================================================================================================
+int    vcpu_isa                   (void);
+int    vcpu_threads               (void);
+int    vcpu_out_size              (int op, int size);
+int    vcpu_inputs                (int op);
+int    vcpu                       (int op, const int *A, const int *B, int *C, int size, int arg);
+int    vcpu_run                   (int op, const int *A, const int *B, int *C, int size, int arg, int threads);
+int    vcpu_pack                  (int lanes, const int *src, int n, int *dst);
+int    vcpu_unpack                (int lanes, const int *src, int n, int *dst);
+void * vcpu_Threads_Call          (void *pk);
+//==================================================================================================
+//   _  __                    _
+//  | |/ /___ _ __ _ __   ___| |
+//  | ' // _ \ '__| '_ \ / _ \ |
+//  | . \  __/ |  | | | |  __/ |
+//  |_|\_\___|_|  |_| |_|\___|_|
+//==================================================================================================
+static inline void vcpu_ew_scalar(int op, const int *A, const int *B, int *C, int n)
+{
+  const uint32_t *a = (const uint32_t *)A, *b = (const uint32_t *)B;
+  uint32_t       *c = (uint32_t *)C;
+  int i;
+  switch (op) {
+    case VADD : for (i = 0; i < n; i++) c[i] = a[i] + b[i];               break;
+    case VSUB : for (i = 0; i < n; i++) c[i] = a[i] - b[i];               break;
+    case VMUL : for (i = 0; i < n; i++) c[i] = a[i] * b[i];               break;
+    case A2PB2: for (i = 0; i < n; i++) c[i] = a[i] * a[i] + b[i] * b[i]; break;
+    case VAPBB: for (i = 0; i < n; i++) c[i] = a[i] + b[i] * b[i];        break;
+    case VAAPB: for (i = 0; i < n; i++) c[i] = a[i] * a[i] + b[i];        break;
+    default   : memmove(c, a, (size_t)n * 4);                             break;
+  }
+}
+
+__attribute__((target("avx2")))
+static inline void vcpu_ew_avx2(int op, const int *A, const int *B, int *C, int n)
+{
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i a = _mm256_loadu_si256((const __m256i *)(A + i));
+    __m256i b = _mm256_loadu_si256((const __m256i *)(B + i));
+    __m256i c;
+    switch (op) {
+      case VADD : c = _mm256_add_epi32(a, b);   break;
+      case VSUB : c = _mm256_sub_epi32(a, b);   break;
+      case A2PB2: c = _mm256_add_epi32(_mm256_mullo_epi32(a, a), _mm256_mullo_epi32(b, b)); break;
+      case VAPBB: c = _mm256_add_epi32(a, _mm256_mullo_epi32(b, b));                        break;
+      case VAAPB: c = _mm256_add_epi32(_mm256_mullo_epi32(a, a), b);                        break;
+      default   : c = _mm256_mullo_epi32(a, b); break;
+    }
+    _mm256_storeu_si256((__m256i *)(C + i), c);
+  }
+  vcpu_ew_scalar(op, A + i, B + i, C + i, n - i);
+}
+
+__attribute__((target("avx512f")))
+static inline void vcpu_ew_avx512(int op, const int *A, const int *B, int *C, int n)
+{
+  int i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m512i a = _mm512_loadu_si512((const void *)(A + i));
+    __m512i b = _mm512_loadu_si512((const void *)(B + i));
+    __m512i c;
+    switch (op) {
+      case VADD : c = _mm512_add_epi32(a, b);   break;
+      case VSUB : c = _mm512_sub_epi32(a, b);   break;
+      case A2PB2: c = _mm512_add_epi32(_mm512_mullo_epi32(a, a), _mm512_mullo_epi32(b, b)); break;
+      case VAPBB: c = _mm512_add_epi32(a, _mm512_mullo_epi32(b, b));                        break;
+      case VAAPB: c = _mm512_add_epi32(_mm512_mullo_epi32(a, a), b);                        break;
+      default   : c = _mm512_mullo_epi32(a, b); break;
+    }
+    _mm512_storeu_si512((void *)(C + i), c);
+  }
+  vcpu_ew_scalar(op, A + i, B + i, C + i, n - i);
+}
+
+// Packed lanes, n counts words. Every lane wraps at its own width; AVX-512 machines take the AVX2
+// loop, the byte/word instructions of AVX-512BW are not part of the ISA check.
+template <typename T> static inline T vcpu_ew_lane(int op, T a, T b)
+{
+  uint32_t x = a, y = b;
+  switch (op) {
+    case VADD : return (T)(x + y);
+    case VSUB : return (T)(x - y);
+    case VMUL : return (T)(x * y);
+    case A2PB2: return (T)(x * x + y * y);
+    case VAPBB: return (T)(x + y * y);
+    case VAAPB: return (T)(x * x + y);
+    default   : return a;
+  }
+}
+
+static inline void vcpu_ewp_scalar(int op, int lanes, const int *A, const int *B, int *C, int n)
+{
+  int i;
+  if (lanes == VPACK_I16) {
+    const uint16_t *a = (const uint16_t *)A, *b = (const uint16_t *)B;
+    uint16_t       *c = (uint16_t *)C;
+    for (i = 0; i < n * 2; i++) c[i] = vcpu_ew_lane<uint16_t>(op, a[i], b[i]);
+  } else {
+    const uint8_t  *a = (const uint8_t *)A,  *b = (const uint8_t *)B;
+    uint8_t        *c = (uint8_t *)C;
+    for (i = 0; i < n * 4; i++) c[i] = vcpu_ew_lane<uint8_t>(op, a[i], b[i]);
+  }
+}
+
+__attribute__((target("avx2")))
+static inline __m256i vcpu_padd_avx2(int lanes, __m256i a, __m256i b)
+{
+  return (lanes == VPACK_I16) ? _mm256_add_epi16(a, b) : _mm256_add_epi8(a, b);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i vcpu_psub_avx2(int lanes, __m256i a, __m256i b)
+{
+  return (lanes == VPACK_I16) ? _mm256_sub_epi16(a, b) : _mm256_sub_epi8(a, b);
+}
+
+// no 8-bit multiply: even bytes from the 16-bit product, odd bytes from the product of the high bytes
+__attribute__((target("avx2")))
+static inline __m256i vcpu_pmul_avx2(int lanes, __m256i a, __m256i b)
+{
+  if (lanes == VPACK_I16) return _mm256_mullo_epi16(a, b);
+  __m256i even = _mm256_mullo_epi16(a, b);
+  __m256i odd  = _mm256_mullo_epi16(_mm256_srli_epi16(a, 8), _mm256_srli_epi16(b, 8));
+  return _mm256_or_si256(_mm256_and_si256(even, _mm256_set1_epi16(0xFF)), _mm256_slli_epi16(odd, 8));
+}
+
+__attribute__((target("avx2")))
+static inline void vcpu_ewp_avx2(int op, int lanes, const int *A, const int *B, int *C, int n)
+{
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i a = _mm256_loadu_si256((const __m256i *)(A + i));
+    __m256i b = _mm256_loadu_si256((const __m256i *)(B + i));
+    __m256i c;
+    switch (op) {
+      case VADD : c = vcpu_padd_avx2(lanes, a, b); break;
+      case VSUB : c = vcpu_psub_avx2(lanes, a, b); break;
+      case A2PB2: c = vcpu_padd_avx2(lanes, vcpu_pmul_avx2(lanes, a, a), vcpu_pmul_avx2(lanes, b, b)); break;
+      case VAPBB: c = vcpu_padd_avx2(lanes, a, vcpu_pmul_avx2(lanes, b, b));                           break;
+      case VAAPB: c = vcpu_padd_avx2(lanes, vcpu_pmul_avx2(lanes, a, a), b);                           break;
+      default   : c = vcpu_pmul_avx2(lanes, a, b); break;
+    }
+    _mm256_storeu_si256((__m256i *)(C + i), c);
+  }
+  vcpu_ewp_scalar(op, lanes, A + i, B + i, C + i, n - i);
+}
+
+// int32 elements to lanes: the low 16/8 bits of each, the last word zero filled.
+static inline void vcpu_pack_scalar(int lanes, const int *src, int n, int *dst)
+{
+  int i;
+  if (n % lanes) dst[n / lanes] = 0;
+  if (lanes == VPACK_I16) for (i = 0; i < n; i++) ((int16_t *)dst)[i] = (int16_t)src[i];
+  else                    for (i = 0; i < n; i++) ((int8_t  *)dst)[i] = (int8_t) src[i];
+}
+
+__attribute__((target("avx2")))
+static inline void vcpu_pack_avx2(int lanes, const int *src, int n, int *dst)
+{
+  const __m256i w16 = _mm256_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1,
+                                       0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1);
+  const __m256i w8  = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                       0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+  const __m256i q8  = _mm256_setr_epi32(0, 4, 1, 1, 1, 1, 1, 1);
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i x = _mm256_loadu_si256((const __m256i *)(src + i));
+    if (lanes == VPACK_I16) {
+      x = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(x, w16), 0x08);
+      _mm_storeu_si128((__m128i *)((int16_t *)dst + i), _mm256_castsi256_si128(x));
+    } else {
+      x = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(x, w8), q8);
+      _mm_storel_epi64((__m128i *)((int8_t *)dst + i), _mm256_castsi256_si128(x));
+    }
+  }
+  vcpu_pack_scalar(lanes, src + i, n - i, dst + i / lanes);
+}
+
+// lanes to int32 elements, sign extended
+static inline void vcpu_unpack_scalar(int lanes, const int *src, int n, int *dst)
+{
+  int i;
+  if (lanes == VPACK_I16) for (i = 0; i < n; i++) dst[i] = ((const int16_t *)src)[i];
+  else                    for (i = 0; i < n; i++) dst[i] = ((const int8_t  *)src)[i];
+}
+
+__attribute__((target("avx2")))
+static inline void vcpu_unpack_avx2(int lanes, const int *src, int n, int *dst)
+{
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i x = (lanes == VPACK_I16) ? _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)((const int16_t *)src + i)))
+                                     : _mm256_cvtepi8_epi32 (_mm_loadl_epi64((const __m128i *)((const int8_t  *)src + i)));
+    _mm256_storeu_si256((__m256i *)(dst + i), x);
+  }
+  vcpu_unpack_scalar(lanes, src + i / lanes, n - i, dst + i);
+}
+
+// sign = +1 / -1 folds B into the sum, 0 ignores it. The sum is kept in 32 bits like the hardware.
+static inline uint32_t vcpu_reduce_scalar(const int *A, const int *B, int sign, int n)
+{
+  uint32_t s = 0;
+  int i;
+  for (i = 0; i < n; i++) {
+    s += (uint32_t)A[i];
+    if (sign > 0) s += (uint32_t)B[i];
+    if (sign < 0) s -= (uint32_t)B[i];
+  }
+  return s;
+}
+
+__attribute__((target("avx2")))
+static inline uint32_t vcpu_reduce_avx2(const int *A, const int *B, int sign, int n)
+{
+  __m256i s = _mm256_setzero_si256();
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    s = _mm256_add_epi32(s, _mm256_loadu_si256((const __m256i *)(A + i)));
+    if (sign > 0) s = _mm256_add_epi32(s, _mm256_loadu_si256((const __m256i *)(B + i)));
+    if (sign < 0) s = _mm256_sub_epi32(s, _mm256_loadu_si256((const __m256i *)(B + i)));
+  }
+  uint32_t l[8];
+  _mm256_storeu_si256((__m256i *)l, s);
+  return l[0] + l[1] + l[2] + l[3] + l[4] + l[5] + l[6] + l[7] + vcpu_reduce_scalar(A + i, B ? B + i : NULL, sign, n - i);
+}
+
+__attribute__((target("avx512f")))
+static inline uint32_t vcpu_reduce_avx512(const int *A, const int *B, int sign, int n)
+{
+  __m512i s = _mm512_setzero_si512();
+  int i = 0;
+  for (; i + 16 <= n; i += 16) {
+    s = _mm512_add_epi32(s, _mm512_loadu_si512((const void *)(A + i)));
+    if (sign > 0) s = _mm512_add_epi32(s, _mm512_loadu_si512((const void *)(B + i)));
+    if (sign < 0) s = _mm512_sub_epi32(s, _mm512_loadu_si512((const void *)(B + i)));
+  }
+  return (uint32_t)_mm512_reduce_add_epi32(s) + vcpu_reduce_scalar(A + i, B ? B + i : NULL, sign, n - i);
+}
+
+static inline void vcpu_filter_scalar(int op, const int *A, int *C, int k, int n)
+{
+  int i;
+  if (op == SQLLESS) for (i = 0; i < n; i++) C[i] = (A[i] < k) ? A[i] : VCPU_NULL;
+  else               for (i = 0; i < n; i++) C[i] = (A[i] > k) ? A[i] : VCPU_NULL;
+}
+
+__attribute__((target("avx2")))
+static inline void vcpu_filter_avx2(int op, const int *A, int *C, int k, int n)
+{
+  __m256i vk = _mm256_set1_epi32(k), vn = _mm256_set1_epi32(VCPU_NULL);
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i a = _mm256_loadu_si256((const __m256i *)(A + i));
+    __m256i m = (op == SQLLESS) ? _mm256_cmpgt_epi32(vk, a) : _mm256_cmpgt_epi32(a, vk);
+    _mm256_storeu_si256((__m256i *)(C + i), _mm256_blendv_epi8(vn, a, m));
+  }
+  vcpu_filter_scalar(op, A + i, C + i, k, n - i);
+}
+
+__attribute__((target("avx512f")))
+static inline void vcpu_filter_avx512(int op, const int *A, int *C, int k, int n)
+{
+  __m512i vk = _mm512_set1_epi32(k), vn = _mm512_set1_epi32(VCPU_NULL);
+  int i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m512i   a = _mm512_loadu_si512((const void *)(A + i));
+    __mmask16 m = (op == SQLLESS) ? _mm512_cmplt_epi32_mask(a, vk) : _mm512_cmpgt_epi32_mask(a, vk);
+    _mm512_storeu_si512((void *)(C + i), _mm512_mask_blend_epi32(m, vn, a));
+  }
+  vcpu_filter_scalar(op, A + i, C + i, k, n - i);
+}
+
+static inline void vcpu_avg_scalar(const int *A, int n, int64_t *sum, int64_t *count)
+{
+  int i;
+  for (i = 0; i < n; i++) {
+    if (A[i] == VCPU_NULL) continue;
+    *sum += A[i];
+    (*count)++;
+  }
+}
+
+__attribute__((target("avx2")))
+static inline void vcpu_avg_avx2(const int *A, int n, int64_t *sum, int64_t *count)
+{
+  __m256i vn = _mm256_set1_epi32(VCPU_NULL), s = _mm256_setzero_si256();
+  int64_t c = 0;
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i a = _mm256_loadu_si256((const __m256i *)(A + i));
+    __m256i m = _mm256_cmpeq_epi32(a, vn);
+    a  = _mm256_andnot_si256(m, a);
+    c += 8 - __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(m)));
+    s  = _mm256_add_epi64(s, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(a)));
+    s  = _mm256_add_epi64(s, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(a, 1)));
+  }
+  int64_t l[4];
+  _mm256_storeu_si256((__m256i *)l, s);
+  *sum   += l[0] + l[1] + l[2] + l[3];
+  *count += c;
+  vcpu_avg_scalar(A + i, n - i, sum, count);
+}
+
+__attribute__((target("avx512f")))
+static inline void vcpu_avg_avx512(const int *A, int n, int64_t *sum, int64_t *count)
+{
+  __m512i vn = _mm512_set1_epi32(VCPU_NULL), s = _mm512_setzero_si512();
+  int64_t c = 0;
+  int i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m512i   a = _mm512_loadu_si512((const void *)(A + i));
+    __mmask16 m = _mm512_cmpneq_epi32_mask(a, vn);
+    a  = _mm512_maskz_mov_epi32(m, a);
+    c += __builtin_popcount(m);
+    s  = _mm512_add_epi64(s, _mm512_cvtepi32_epi64(_mm512_castsi512_si256(a)));
+    s  = _mm512_add_epi64(s, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(a, 1)));
+  }
+  *sum   += _mm512_reduce_add_epi64(s);
+  *count += c;
+  vcpu_avg_scalar(A + i, n - i, sum, count);
+}
+
+//==================================================================================================
+//  Dispatch
+//==================================================================================================
+int vcpu_isa(void)
+{
+  static int isa = -1;
+  if (isa >= 0) return isa;
+
+  const char *env = getenv("JIT_CPU_ISA");
+  __builtin_cpu_init();
+  isa = VCPU_SCALAR;
+  if (__builtin_cpu_supports("avx2"))    isa = VCPU_AVX2;
+  if (__builtin_cpu_supports("avx512f")) isa = VCPU_AVX512;
+  if (env != NULL && strcmp(env, "scalar") == 0)                       isa = VCPU_SCALAR;
+  if (env != NULL && strcmp(env, "avx2")   == 0 && isa >= VCPU_AVX2)   isa = VCPU_AVX2;
+  return isa;
+}
+
+int vcpu_threads(void)
+{
+  static int threads = 0;
+  if (threads > 0) return threads;
+
+  const char *env = getenv("JIT_CPU_THREADS");
+  threads = (env != NULL) ? atoi(env) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+  threads = std::max(1, std::min(threads, VCPU_MAX_THREADS));
+  return threads;
+}
+
+int vcpu_inputs(int op)
+{
+  switch (op) {
+    case VADD: case VSUB: case VMUL: case VADDREDUCE: case VSUBREDUCE: case MERGE: return 2;
+    case A2PB2: case VAPBB: case VAAPB:                                          return 2;
+    case ACCMM: case ACCMMM:                                                     return 2;
+    default:                                                                     return 1;
+  }
+}
+
+int vcpu_out_size(int op, int size)
+{
+  switch (op) {
+    case VREDUCE: case VADDREDUCE: case VSUBREDUCE: return 1;
+    case SQLAVG:                                    return 4;
+    case ACCMMM:                                    return VCPU_TILE * VCPU_TILE;
+    case MERGE:                                     return 2 * size;
+    default:                                        return size;
+  }
+}
+
+static bool vcpu_less(int x, int y) { return x < y; }
+
+// One slice of a job, the reductions leave their partials in the package.
+static void vcpu_slice(vcpu_pk_t *p)
+{
+  int isa = vcpu_isa();
+  int n   = p->size;
+
+  switch (p->op) {
+    case VADD: case VSUB: case VMUL: case A2PB2: case VAPBB: case VAAPB: {
+      if (p->arg == VPACK_I16 || p->arg == VPACK_I8) {
+        if (isa != VCPU_SCALAR)    vcpu_ewp_avx2  (p->op, p->arg, p->A, p->B, p->C, n);
+        else                       vcpu_ewp_scalar(p->op, p->arg, p->A, p->B, p->C, n);
+      }
+      else if (isa == VCPU_AVX512) vcpu_ew_avx512(p->op, p->A, p->B, p->C, n);
+      else if (isa == VCPU_AVX2)   vcpu_ew_avx2  (p->op, p->A, p->B, p->C, n);
+      else                         vcpu_ew_scalar(p->op, p->A, p->B, p->C, n);
+    }break;
+
+    case VREDUCE: case VADDREDUCE: case VSUBREDUCE: {
+      int sign = (p->op == VADDREDUCE) ? 1 : (p->op == VSUBREDUCE) ? -1 : 0;
+      const int *B = sign ? p->B : NULL;
+      if      (isa == VCPU_AVX512) p->sum = vcpu_reduce_avx512(p->A, B, sign, n);
+      else if (isa == VCPU_AVX2)   p->sum = vcpu_reduce_avx2  (p->A, B, sign, n);
+      else                         p->sum = vcpu_reduce_scalar(p->A, B, sign, n);
+    }break;
+
+    case SQLLESS: case SQLLARGE: {
+      int k = (int16_t)p->arg;
+      if      (isa == VCPU_AVX512) vcpu_filter_avx512(p->op, p->A, p->C, k, n);
+      else if (isa == VCPU_AVX2)   vcpu_filter_avx2  (p->op, p->A, p->C, k, n);
+      else                         vcpu_filter_scalar(p->op, p->A, p->C, k, n);
+    }break;
+
+    case SQLAVG: {
+      p->sum   = 0;
+      p->count = 0;
+      if      (isa == VCPU_AVX512) vcpu_avg_avx512(p->A, n, &p->sum, &p->count);
+      else if (isa == VCPU_AVX2)   vcpu_avg_avx2  (p->A, n, &p->sum, &p->count);
+      else                         vcpu_avg_scalar(p->A, n, &p->sum, &p->count);
+    }break;
+
+    case INSERTION: {   // C already holds the data words of this slice
+      std::sort(p->C, p->C + n, vcpu_less);
+    }break;
+
+    case MERGE: {       // A / B are the two sub-runs of this slice found by vcpu_merge_path()
+      std::merge(p->A, p->A + p->count, p->B, p->B + (int)p->sum, p->C, vcpu_less);
+    }break;
+
+    default: {
+      memmove(p->C, p->A, (size_t)n * 4);
+    }break;
+  }
+}
+
+void * vcpu_Threads_Call(void *pk)
+{
+  vcpu_slice((vcpu_pk_t *)pk);
+  return NULL;
+}
+
+static void vcpu_fork(vcpu_pk_t *pk, int threads)
+{
+  pthread_t thread[VCPU_MAX_THREADS];
+  int i;
+  for (i = 1; i < threads; i++) pthread_create(&thread[i], NULL, vcpu_Threads_Call, (void *)&pk[i]);
+  vcpu_slice(&pk[0]);
+  for (i = 1; i < threads; i++) pthread_join(thread[i], NULL);
+}
+
+// First index of A taken by output position d of the merge of A[0..na) and B[0..nb).
+static int vcpu_merge_path(const int *A, int na, const int *B, int nb, int d)
+{
+  int lo = std::max(0, d - nb), hi = std::min(d, na);
+  while (lo < hi) {
+    int i = (lo + hi) / 2;
+    if (vcpu_less(B[d - i - 1], A[i])) hi = i;
+    else                               lo = i + 1;
+  }
+  return lo;
+}
+
+static int vcpu_valid(const int *A, int size)
+{
+  return (int)(std::find(A, A + size, VCPU_PADDING) - A);
+}
+
+static void vcpu_merge(const int *A, int na, const int *B, int nb, int *C, int threads)
+{
+  vcpu_pk_t pk[VCPU_MAX_THREADS];
+  int n = na + nb, i;
+  if (n < VCPU_MT_MIN) threads = 1;
+  for (i = 0; i < threads; i++) {
+    int d0 = (int)((int64_t)n * i / threads), d1 = (int)((int64_t)n * (i + 1) / threads);
+    int a0 = vcpu_merge_path(A, na, B, nb, d0), a1 = vcpu_merge_path(A, na, B, nb, d1);
+    pk[i].op    = MERGE;
+    pk[i].A     = A + a0;
+    pk[i].count = a1 - a0;
+    pk[i].B     = B + (d0 - a0);
+    pk[i].sum   = (d1 - a1) - (d0 - a0);
+    pk[i].C     = C + d0;
+    pk[i].size  = d1 - d0;
+  }
+  vcpu_fork(pk, threads);
+}
+
+static int vcpu_sort(const int *A, int *C, int size, int threads)
+{
+  vcpu_pk_t pk[VCPU_MAX_THREADS];
+  int i, n;
+
+  if (C != A) memmove(C, A, (size_t)size * 4);
+  n = (int)(std::stable_partition(C, C + size, [](int w) { return w != VCPU_PADDING; }) - C);
+  if (n < VCPU_MT_MIN) threads = 1;
+
+  std::vector<int> bound(threads + 1);
+  for (i = 0; i <= threads; i++) bound[i] = (int)((int64_t)n * i / threads);
+  for (i = 0; i < threads; i++) {
+    pk[i].op   = INSERTION;
+    pk[i].C    = C + bound[i];
+    pk[i].size = bound[i + 1] - bound[i];
+  }
+  vcpu_fork(pk, threads);
+
+  // merge the sorted slices pairwise, each round with all threads
+  std::vector<int> tmp(threads > 1 ? n : 0);
+  int *src = C, *dst = tmp.data();
+  int  runs = threads;
+  while (runs > 1) {
+    int r;
+    for (r = 0; r + 1 < runs; r += 2) {
+      int a = bound[r], m = bound[r + 1], b = bound[r + 2];
+      vcpu_merge(src + a, m - a, src + m, b - m, dst + a, threads);
+    }
+    if (runs % 2) memcpy(dst + bound[runs - 1], src + bound[runs - 1], (size_t)(bound[runs] - bound[runs - 1]) * 4);
+    for (r = 0; r <= (runs + 1) / 2; r++) bound[r] = bound[std::min(2 * r, runs)];
+    runs = (runs + 1) / 2;
+    std::swap(src, dst);
+  }
+  if (src != C) memcpy(C, src, (size_t)n * 4);
+  return size;
+}
+
+// c += a x b on one tile, the j loop is left to the vectorizer
+static void vcpu_tile_mac(const int *a, const int *b, int *c)
+{
+  const uint32_t *ua = (const uint32_t *)a, *ub = (const uint32_t *)b;
+  uint32_t       *uc = (uint32_t *)c;
+  int i, k, j;
+  for (i = 0; i < VCPU_TILE; i++)
+    for (k = 0; k < VCPU_TILE; k++) {
+      uint32_t x = ua[i * VCPU_TILE + k];
+      for (j = 0; j < VCPU_TILE; j++) uc[i * VCPU_TILE + j] += x * ub[k * VCPU_TILE + j];
+    }
+}
+
+static int vcpu_mm(int op, const int *A, const int *B, int *C, int size)
+{
+  const int tt = VCPU_TILE * VCPU_TILE;
+  int t, n = size / tt;
+
+  if (op == ACCMMM) {
+    memset(C, 0, tt * 4);
+    for (t = 0; t < n; t++) vcpu_tile_mac(A + t * tt, B + t * tt, C);
+    return tt;
+  }
+  memset(C, 0, (size_t)n * tt * 4);
+  for (t = 0; t < n; t++) vcpu_tile_mac(A + t * tt, B + t * tt, C + t * tt);
+  return size;
+}
+
+//==================================================================================================
+//  Entry points
+//==================================================================================================
+int vcpu_run(int op, const int *A, const int *B, int *C, int size, int arg, int threads)
+{
+  vcpu_pk_t pk[VCPU_MAX_THREADS];
+  int i;
+
+  threads = std::max(1, std::min(threads, VCPU_MAX_THREADS));
+  if (size < VCPU_MT_MIN) threads = 1;
+
+  switch (op) {
+    case INSERTION: return vcpu_sort(A, C, size, threads);
+
+    case ACCMM: case ACCMMM: return vcpu_mm(op, A, B, C, size);
+
+    case MERGE: {
+      int na = vcpu_valid(A, size), nb = vcpu_valid(B, size);
+      vcpu_merge(A, na, B, nb, C, threads);
+      std::fill(C + na + nb, C + 2 * size, VCPU_PADDING);
+      return 2 * size;
+    }
+
+    default: {
+      for (i = 0; i < threads; i++) {
+        int lo = (int)((int64_t)size * i / threads), hi = (int)((int64_t)size * (i + 1) / threads);
+        pk[i].op    = op;
+        pk[i].A     = A + lo;
+        pk[i].B     = (B != NULL) ? B + lo : NULL;
+        pk[i].C     = C + lo;
+        pk[i].size  = hi - lo;
+        pk[i].arg   = arg;
+        pk[i].sum   = 0;
+        pk[i].count = 0;
+      }
+      vcpu_fork(pk, threads);
+    }break;
+  }
+
+  switch (op) {
+    case VREDUCE: case VADDREDUCE: case VSUBREDUCE: {
+      uint32_t s = 0;
+      for (i = 0; i < threads; i++) s += (uint32_t)pk[i].sum;
+      C[0] = (int)s;
+    }break;
+
+    case SQLAVG: {
+      int64_t s = 0, c = 0;
+      for (i = 0; i < threads; i++) { s += pk[i].sum; c += pk[i].count; }
+      C[0] = (c != 0) ? (int)(s / c) : 0;
+      C[1] = (int)c;
+      C[2] = (int)(uint32_t)s;
+      C[3] = (int)(s >> 32);
+    }break;
+
+    default: break;
+  }
+  return vcpu_out_size(op, size);
+}
+
+int vcpu(int op, const int *A, const int *B, int *C, int size, int arg)
+{
+  return vcpu_run(op, A, B, C, size, arg, vcpu_threads());
+}
+
+// n int32 elements into (n + lanes - 1) / lanes words of VPACK_I16/VPACK_I8 lanes, returns the words
+int vcpu_pack(int lanes, const int *src, int n, int *dst)
+{
+  if (lanes != VPACK_I16 && lanes != VPACK_I8) return -1;
+  if (vcpu_isa() != VCPU_SCALAR) vcpu_pack_avx2  (lanes, src, n, dst);
+  else                           vcpu_pack_scalar(lanes, src, n, dst);
+  return (n + lanes - 1) / lanes;
+}
+
+// n lanes back to int32 elements, returns n
+int vcpu_unpack(int lanes, const int *src, int n, int *dst)
+{
+  if (lanes != VPACK_I16 && lanes != VPACK_I8) return -1;
+  if (vcpu_isa() != VCPU_SCALAR) vcpu_unpack_avx2  (lanes, src, n, dst);
+  else                           vcpu_unpack_scalar(lanes, src, n, dst);
+  return n;
+}
+
+#endif
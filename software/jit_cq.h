@@ -0,0 +1,321 @@
+#ifndef JIT_CQ_H
+#define JIT_CQ_H
+//==================================================================================================
+// Completion queue of the overlay. firmware/jit_cq.v sends a 4-word record on stream 50 when a
+// node finishes a job: {0xBABE000n, tag, words sent on C, status}, the tag being the R4 of the node
+// when the job started (vsettag, before its vtieio). VCQ_INIT starts a thread which reads them off
+// stream 50 of every card, stamps them with the host time and hands them to vcq_wait / vcq_poll,
+// by node and tag.
+//
+// vlaunch runs vstart in a thread and returns at once, the host is free until vjoin, which it
+// needs before using the output buffers; the completions say when each node, inner nodes of a
+// chain too, was done:
+//
+//   VCQ_INIT(VM);
+//   vsettag(VM, nPR[0], 7);
+//   vtieio (VM, nPR[0], A, n, B, n, C, n);
+//   vlaunch(VM, &nPR, &L);
+//   ...                                   // host work
+//   vcq_wait(VM, nPR[0], 7, &e, 0);        // e.words, e.us - L.us
+//   vjoin(&L);
+//   VCQ_CLEAN(VM);
+//
+// vqueue is vlaunch for a job queued behind a running one: its vtieio / vsettag go between
+// vshadow_begin and vshadow_end (jit_isa.h) while the first one streams, the dispatcher loads them
+// when it is done, and its streams follow those of the first one:
+//
+//   vlaunch(VM, &nPR, &L0);
+//   vshadow_begin(VM);
+//   vsettag(VM, nPR[0], 8);
+//   vtieio (VM, nPR[0], A1, n, B1, n, C1, n);
+//   vshadow_end(VM);
+//   vqueue (VM, &nPR, &L0, &L1);           // L0 is joined by L1
+//   vjoin(&L1);
+//
+// The thread only reads stream 50 when bytes are there, under vm_mutex; vperf_node (jit_perf.h)
+// passes on the records it finds in front of its counters. vend reads the same records, do not use
+// it with the queue open.
+//==================================================================================================
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <deque>
+#include <vector>
+#include "jit_isa.h"
+
+#define VCQ_DEPTH       4096     // records kept for waiters, the oldest dropped past it
+#define VCQ_POLL_US     20       // sleep of the thread when no card had a record
+#define VCQ_ANY         -1       // tag of vcq_wait / vcq_poll matching any job of the node
+
+typedef struct {
+  int       nPR;
+  uint32_t  tag;
+  uint32_t  words;               // words the node sent on C
+  uint32_t  status;              // VCQ_XBAR | VCQ_LOST of jit_op.h
+  double    us;                  // host time it was read, vcq_us()
+}vcq_entry_t;
+
+struct vcq_t {
+  vam_vm_t                 *VM;
+  pthread_t                 thread;
+  pthread_mutex_t           mutex;
+  pthread_cond_t            cond;
+  int                       stop;
+  std::deque<vcq_entry_t>  *done;
+};
+
+typedef struct vlaunch_t {
+  vam_vm_t            vm;        // the VM of vstart, on a copy of the node table
+  vector<vam_node_t>  table;
+  vector<int>         nPR;
+  struct vlaunch_t   *prev;      // launch whose streams go first, vqueue
+  pthread_t           thread;
+  int                 err;
+  double              us;        // vcq_us() at vlaunch
+}vlaunch_t;
+
+//==================================================================================================
+ int   VCQ_INIT                   (vam_vm_t *VM);
+void   VCQ_CLEAN                  (vam_vm_t *VM);
+double vcq_us                     (void);
+void   vcq_post                   (struct vcq_t *CQ, int card, const uint32_t *rec);
+void * vcq_Threads_Call           (void *pk);
+ int   vsettag                    (vam_vm_t *VM, int nPR, int tag);
+ int   vcq_poll                   (vam_vm_t *VM, int nPR, int tag, vcq_entry_t *e);
+ int   vcq_wait                   (vam_vm_t *VM, int nPR, int tag, vcq_entry_t *e, int timeout_ms);
+ int   vlaunch                    (vam_vm_t *VM, vector<int> *nPR, vlaunch_t *L);
+ int   vqueue                     (vam_vm_t *VM, vector<int> *nPR, vlaunch_t *prev, vlaunch_t *L);
+void * vlaunch_Threads_Call       (void *pk);
+ int   vjoin                      (vlaunch_t *L);
+//==================================================================================================
+double vcq_us(void)
+{
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return 1000000.0 * t.tv_sec + t.tv_nsec / 1000.0;
+}
+
+int VCQ_INIT(vam_vm_t *VM)
+{
+  uint32_t rec[VPERF_WORDS];
+  int      card, cmd_stream;
+
+  if (VM->CQ != NULL) return 0;
+  struct vcq_t *CQ = new struct vcq_t;
+  CQ->VM   = VM;
+  CQ->stop = 0;
+  CQ->done = new std::deque<vcq_entry_t>;
+  pthread_mutex_init(&CQ->mutex, NULL);
+  pthread_cond_init(&CQ->cond, NULL);
+
+  // records of jobs run before the queue are nobody's
+  pthread_mutex_lock(&VM->vm_mutex);
+  for (card = 0; card < CARD; card++) {
+    cmd_stream = VM->pico[card]->CreateStream(50);
+    while (VM->pico[card]->GetBytesAvailable(cmd_stream, true) >= VCQ_WORDS * 4)
+      if (VM->pico[card]->ReadStream(cmd_stream, rec, VCQ_WORDS * 4) < 0) break;
+    VM->pico[card]->CloseStream(cmd_stream);
+  }
+  pthread_mutex_unlock(&VM->vm_mutex);
+
+  VM->CQ = CQ;
+  if (pthread_create(&CQ->thread, NULL, vcq_Threads_Call, (void *)CQ) != 0) {
+    VM->CQ = NULL;
+    delete CQ->done;
+    delete CQ;
+    return -1;
+  }
+  #ifdef VERBOSE
+    printf("[DEBUG->VCQ_INIT] completion thread started\r\n");
+  #endif
+  return 0;
+}
+
+void VCQ_CLEAN(vam_vm_t *VM)
+{
+  struct vcq_t *CQ = VM->CQ;
+  if (CQ == NULL) return;
+  pthread_mutex_lock(&CQ->mutex);
+  CQ->stop = 1;
+  pthread_mutex_unlock(&CQ->mutex);
+  pthread_join(CQ->thread, NULL);
+  VM->CQ = NULL;
+  pthread_mutex_destroy(&CQ->mutex);
+  pthread_cond_destroy(&CQ->cond);
+  delete CQ->done;
+  delete CQ;
+}
+
+void vcq_post(struct vcq_t *CQ, int card, const uint32_t *rec)
+{
+  vcq_entry_t e;
+  e.nPR    = VNPR(card, (int)((rec[0] & 0xFF) - 1));
+  e.tag    = rec[1];
+  e.words  = rec[2];
+  e.status = rec[3];
+  e.us     = vcq_us();
+  #ifdef VERBOSE
+    printf("[DEBUG->vcq_post] nPR:0x%02x tag:%u words:%u status:0x%x\r\n", e.nPR, e.tag, e.words, e.status);
+  #endif
+
+  pthread_mutex_lock(&CQ->mutex);
+  if (CQ->done->size() >= VCQ_DEPTH) CQ->done->pop_front();
+  CQ->done->push_back(e);
+  pthread_cond_broadcast(&CQ->cond);
+  pthread_mutex_unlock(&CQ->mutex);
+}
+
+void * vcq_Threads_Call(void *pk)
+{
+  struct vcq_t *CQ = (struct vcq_t *)pk;
+  vam_vm_t     *VM = CQ->VM;
+  uint32_t      rec[VPERF_WORDS];
+  int           card, cmd_stream, got, stop;
+
+  while (1) {
+    got = 0;
+    for (card = 0; card < CARD; card++) {
+      pthread_mutex_lock(&VM->vm_mutex);
+      cmd_stream = VM->pico[card]->CreateStream(50);
+      if (VM->pico[card]->GetBytesAvailable(cmd_stream, true) >= VCQ_WORDS * 4 &&
+          VM->pico[card]->ReadStream(cmd_stream, rec, VCQ_WORDS * 4) >= 0) {
+        got++;
+        // counter records are read by vperf_node, a stray one is dropped whole
+        if ((rec[0] >> 28) == 0xE)
+          VM->pico[card]->ReadStream(cmd_stream, rec + VCQ_WORDS, (VPERF_WORDS - VCQ_WORDS) * 4);
+      }
+      VM->pico[card]->CloseStream(cmd_stream);
+      pthread_mutex_unlock(&VM->vm_mutex);
+      if (got > 0 && (rec[0] & 0xFFFF0000) == VCQ_MAGIC) vcq_post(CQ, card, rec);
+    }
+
+    pthread_mutex_lock(&CQ->mutex);
+    stop = CQ->stop;
+    pthread_mutex_unlock(&CQ->mutex);
+    if (stop) break;
+    if (got == 0) usleep(VCQ_POLL_US);
+  }
+  return NULL;
+}
+
+// R4 of nPR, the tag of the completion record of the job its next vtieio starts, held in a burst
+// like vtieio
+int vsettag(vam_vm_t *VM, int nPR, int tag)
+{
+  uint32_t  cmd[4] = {0, 0xDEADBEEF, 0xDEADBEEF, 0xDEADBEEF};
+  int       card   = VNPR_CARD(nPR);
+  int       node   = VNPR_NODE(nPR);
+  int       cmd_stream, err;
+
+  if (card >= CARD || node >= ROW) return -1;
+  cmd[0] = 0xC0400000 | VCMD_SLOT(node + 1) | (tag & 0xFFFF);
+  pthread_mutex_lock(&VM->vm_mutex);
+  cmd_stream = VM->pico[card]->CreateStream(50);
+  err = vcmd_write(VM, card, cmd_stream, cmd);
+  VM->pico[card]->CloseStream(cmd_stream);
+  pthread_mutex_unlock(&VM->vm_mutex);
+  #ifdef VERBOSE
+    printf("[DEBUG->vsettag] nPR:0x%02x cmd:0x%08x\r\n", nPR, cmd[0]);
+  #endif
+  return (err < 0) ? -1 : 0;
+}
+
+// Takes the oldest record of nPR with that tag (or VCQ_ANY). 1 when found, 0 if not yet there.
+static int vcq_take(struct vcq_t *CQ, int nPR, int tag, vcq_entry_t *e)
+{
+  std::deque<vcq_entry_t>::iterator it;
+  for (it = CQ->done->begin(); it != CQ->done->end(); it++) {
+    if (it->nPR == nPR && (tag == VCQ_ANY || it->tag == (uint32_t)(tag & 0xFFFF))) {
+      if (e != NULL) *e = *it;
+      CQ->done->erase(it);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+int vcq_poll(vam_vm_t *VM, int nPR, int tag, vcq_entry_t *e)
+{
+  int found;
+  if (VM->CQ == NULL) return -1;
+  pthread_mutex_lock(&VM->CQ->mutex);
+  found = vcq_take(VM->CQ, nPR, tag, e);
+  pthread_mutex_unlock(&VM->CQ->mutex);
+  return found;
+}
+
+// Blocks until the record is there, or timeout_ms (0: no limit) passed. 0, or -1 on timeout.
+int vcq_wait(vam_vm_t *VM, int nPR, int tag, vcq_entry_t *e, int timeout_ms)
+{
+  struct vcq_t    *CQ = VM->CQ;
+  struct timespec  until;
+  int              found, err = 0;
+
+  if (CQ == NULL) return -1;
+  clock_gettime(CLOCK_REALTIME, &until);
+  until.tv_sec  += timeout_ms / 1000;
+  until.tv_nsec += (long)(timeout_ms % 1000) * 1000000;
+  if (until.tv_nsec >= 1000000000) { until.tv_sec++; until.tv_nsec -= 1000000000; }
+
+  pthread_mutex_lock(&CQ->mutex);
+  while (!(found = vcq_take(CQ, nPR, tag, e)) && err == 0) {
+    if (timeout_ms > 0) err = pthread_cond_timedwait(&CQ->cond, &CQ->mutex, &until);
+    else                err = pthread_cond_wait(&CQ->cond, &CQ->mutex);
+  }
+  pthread_mutex_unlock(&CQ->mutex);
+  return found ? 0 : -1;
+}
+
+int vlaunch(vam_vm_t *VM, vector<int> *nPR, vlaunch_t *L)
+{
+  return vqueue(VM, nPR, NULL, L);
+}
+
+// vstart of nPR once prev (NULL: none) is joined. The node table is copied here, the vtieio of the
+// next job can follow at once.
+int vqueue(vam_vm_t *VM, vector<int> *nPR, vlaunch_t *prev, vlaunch_t *L)
+{
+  int card;
+  pthread_mutex_lock(&VM->vm_mutex);
+  L->table = *VM->VAM_TABLE;
+  pthread_mutex_unlock(&VM->vm_mutex);
+  pthread_mutex_init(&L->vm.vm_mutex, NULL);
+  for (card = 0; card < CARD; card++) L->vm.pico[card] = VM->pico[card];
+  L->vm.VAM_TABLE       = &L->table;
+  L->vm.BITSTREAM_TABLE = VM->BITSTREAM_TABLE;
+  L->vm.CQ              = VM->CQ;
+  L->vm.DEV             = VM->DEV;
+  L->nPR  = *nPR;
+  L->prev = prev;
+  if (VM->DEV != NULL && vdev_started(VM, nPR) < 0) return -1;
+  L->err  = 0;
+  L->us   = vcq_us();
+  if (pthread_create(&L->thread, NULL, vlaunch_Threads_Call, (void *)L) != 0) {
+    pthread_mutex_destroy(&L->vm.vm_mutex);
+    return -1;
+  }
+  #ifdef VERBOSE
+    printf("[DEBUG->vqueue] %d nodes launched%s\r\n", (int)nPR->size(), (prev != NULL) ? " behind a launch" : "");
+  #endif
+  return 0;
+}
+
+void * vlaunch_Threads_Call(void *pk)
+{
+  vlaunch_t *L = (vlaunch_t *)pk;
+  if (L->prev != NULL) L->err = vjoin(L->prev);
+  if (L->err == 0)     L->err = vstart(&L->vm, &L->nPR);
+  return NULL;
+}
+
+// Waits for the streams of a vlaunch, the output buffers are complete after it
+int vjoin(vlaunch_t *L)
+{
+  pthread_join(L->thread, NULL);
+  pthread_mutex_destroy(&L->vm.vm_mutex);
+  return L->err;
+}
+
+#endif
@@ -0,0 +1,588 @@
+#ifndef JIT_DEV_H
+#define JIT_DEV_H
+//==================================================================================================
+// Device buffers: blocks of the on-board DRAM of a card which a job reads or writes through the DMA
+// nodes of firmware/jit_dma.v, so that data made by one job stays on the card for the next one
+// instead of coming back to the host. A vdev_t is a third kind of vtieio endpoint next to a host
+// buffer (int *) and a node (nPR): as an input a DMA reader streams it to the node through the
+// crossbar, as an output a DMA writer stores what the node sends to the crossbar.
+//
+//   VDEV_INIT(VM);
+//   vdevnew  (VM, 0, n, &X);
+//   vtieio   (VM, nPR[0], A, n, B, n, &X, n);    // X = A + B, kept on the card
+//   vstart   (VM, &first);
+//   vtieio   (VM, nPR[1], &X, n, C, n, D, n);    // D = X * C
+//   vstart   (VM, &second);
+//   vdevread (VM, &X, buf, n);                   // waits for the writer of X
+//   vdevdel  (VM, &X);
+//   VDEV_CLEAN(VM);
+//
+// A card has VDMA_RDS readers and VDMA_WRS writers (jit_op.h), one job each. Nodes reading the same
+// buffer in one job share a reader, the crossbar multicasts it; the reader only starts with the
+// vstart, once all of them are tied. vtieio claims the nodes: one whose job was started by a vstart
+// (or vlaunch) is taken back once its completion record is there, one tied for a job not started
+// yet is busy. The host waits the same way before it reads, writes or frees a buffer a started job
+// is writing, and before it writes or frees one a job is reading. The records are taken from the
+// queue of jit_cq.h when it is open, read off stream 50 otherwise; do not use vend at the same time
+// then. Device endpoints cannot be queued with vshadow_begin.
+//
+// The readers of a card share one AXI master, the writers too, in weighted round robin: vdevprio
+// gives the buffer of a latency-sensitive job a weight up to VDMA_PRIO_MAX, its node then issues as
+// many bursts in a row while the others wait. vperf_node on a DMA node returns its grants and waits.
+//
+// The same DRAM holds a bitstream cache: after vpcache_on, vlpr of an operator new to a node sends
+// the bitstream of that region to the card once (WriteRam), then has the PR reader of jit.v
+// (VPR_NODE) stream it to the ICAP from there, between the BEEF / DEAD words of prctrl.v, and waits
+// for its record. vpcache_on(VM, 1) loads every registered bitstream that fits at once. When
+// vdevnew or a new bitstream finds no room, the least recently loaded bitstreams are dropped; a
+// bitstream larger than the DRAM still goes through stream 100.
+//==================================================================================================
+#include <stdio.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <vector>
+#include "jit_isa.h"
+#include "jit_cq.h"
+
+#define VDEV_BYTES      (1ull << 32)   // card DRAM within the 32-bit byte address of jit_dma.v
+#define VDEV_ALIGN      4096           // blocks start on a 4 KB boundary, a beat boundary too
+
+typedef struct {
+  int       card;
+  uint64_t  addr;                      // byte address in the DRAM of the card
+  int       size;                      // words
+  int       prio;                      // weight of its DMA node, 1 .. VDMA_PRIO_MAX
+}vdev_t;
+
+//==================================================================================================
+ int   VDEV_INIT                  (vam_vm_t *VM);
+void   VDEV_CLEAN                 (vam_vm_t *VM);
+ int   vdevnew                    (vam_vm_t *VM, int card, int size, vdev_t *D);
+ int   vdevdel                    (vam_vm_t *VM, vdev_t *D);
+ int   vdevwrite                  (vam_vm_t *VM, vdev_t *D, int *buf, int size);
+ int   vdevread                   (vam_vm_t *VM, vdev_t *D, int *buf, int size);
+ int   vdevsync                   (vam_vm_t *VM, vdev_t *D);
+ int   vdevtie                    (vam_vm_t *VM, int nPR, vdev_t *D, int size, int wr);
+ int   vdevprio                   (vam_vm_t *VM, vdev_t *D, int prio);
+ int   vpcache_on                 (vam_vm_t *VM, int preload);
+void   vpcache_off                (vam_vm_t *VM);
+ int   vpcache_lpr                (vam_vm_t *VM, int nPR, int PR_NAME);
+static int vpcache_evict          (vam_vm_t *VM, int card);
+//==================================================================================================
+int VDEV_INIT(vam_vm_t *VM)
+{
+  int card, k;
+  if (VM->DEV != NULL) return 0;
+  struct vdev_pool_t *DEV = new struct vdev_pool_t;
+  pthread_mutex_init(&DEV->mutex, NULL);
+  for (card = 0; card < CARD; card++) {
+    DEV->block[card] = new vector<vdev_block_t>;
+    DEV->seen[card]  = new vector<uint32_t>;
+    DEV->bits[card]  = new vector<vdev_bit_t>;
+    for (k = 0; k < VDMA_NODES; k++) {
+      DEV->dma[card][k].owner = -1;
+      DEV->dma[card][k].run   = 0;
+      DEV->dma[card][k].tag   = 0;
+      DEV->dma[card][k].addr  = 0;
+      DEV->dma[card][k].size  = 0;
+    }
+  }
+  DEV->tag  = 0;
+  DEV->tick = 0;
+  DEV->lpr  = NULL;
+  pthread_mutex_init(&DEV->pr_mutex, NULL);
+  VM->DEV   = DEV;
+  #ifdef VERBOSE
+    printf("[DEBUG->VDEV_INIT] %d readers, %d writers per card\r\n", VDMA_RDS, VDMA_WRS);
+  #endif
+  return 0;
+}
+
+void VDEV_CLEAN(vam_vm_t *VM)
+{
+  struct vdev_pool_t *DEV = VM->DEV;
+  int card;
+  if (DEV == NULL) return;
+  vpcache_off(VM);
+  VM->DEV = NULL;
+  for (card = 0; card < CARD; card++) {
+    delete DEV->block[card];
+    delete DEV->seen[card];
+    delete DEV->bits[card];
+  }
+  pthread_mutex_destroy(&DEV->pr_mutex);
+  pthread_mutex_destroy(&DEV->mutex);
+  delete DEV;
+}
+
+// Waits for the completion record of DMA node k of a card (VDMA_NODES: the PR reader), job tag, and
+// frees the node if it still runs that job. Called without DEV->mutex, the record may belong to a vlaunch still ending.
+static int vdev_wait(vam_vm_t *VM, int card, int k, uint32_t tag)
+{
+  struct vdev_pool_t *DEV  = VM->DEV;
+  int                 node = NUM_ACCs + k;
+  uint32_t            key  = (uint32_t)(node + 1) << 16 | tag, rec[VPERF_WORDS];
+  int                 cmd_stream, err = 0, found = 0, i;
+
+  #ifdef VERBOSE
+    printf("[DEBUG->vdev_wait] card %d DMA node %d tag %u\r\n", card, node, tag);
+  #endif
+  if (VM->CQ != NULL) {
+    err = vcq_wait(VM, VNPR(card, node), tag, NULL, 0);
+  } else {
+    // records of the other DMA nodes are kept for their waiters, those of the slots dropped
+    pthread_mutex_lock(&VM->vm_mutex);
+    pthread_mutex_lock(&DEV->mutex);
+    for (i = 0; i < (int)DEV->seen[card]->size(); i++)
+      if (DEV->seen[card]->at(i) == key) {
+        DEV->seen[card]->erase(DEV->seen[card]->begin() + i);
+        found = 1;
+        break;
+      }
+    pthread_mutex_unlock(&DEV->mutex);
+    cmd_stream = VM->pico[card]->CreateStream(50);
+    while (!found && err >= 0) {
+      err = VM->pico[card]->ReadStream(cmd_stream, rec, VCQ_WORDS * 4);
+      if (err >= 0 && (rec[0] >> 28) == 0xE)
+        err = VM->pico[card]->ReadStream(cmd_stream, rec + VCQ_WORDS, (VPERF_WORDS - VCQ_WORDS) * 4);
+      else if (err >= 0 && rec[0] == (VCQ_MAGIC | (uint32_t)(node + 1)) && rec[1] == tag)
+        found = 1;
+      else if (err >= 0 && (rec[0] & 0xFFFF0000) == VCQ_MAGIC && (int)(rec[0] & 0xFF) > NUM_ACCs) {
+        pthread_mutex_lock(&DEV->mutex);
+        DEV->seen[card]->push_back((rec[0] & 0xFF) << 16 | (rec[1] & 0xFFFF));
+        pthread_mutex_unlock(&DEV->mutex);
+      }
+    }
+    VM->pico[card]->CloseStream(cmd_stream);
+    pthread_mutex_unlock(&VM->vm_mutex);
+  }
+  if (err < 0) return -1;
+
+  pthread_mutex_lock(&DEV->mutex);
+  if (k < VDMA_NODES && DEV->dma[card][k].owner != -1 && DEV->dma[card][k].tag == tag) {
+    DEV->dma[card][k].owner = -1;
+    DEV->dma[card][k].run   = 0;
+  }
+  pthread_mutex_unlock(&DEV->mutex);
+  return 0;
+}
+
+// Waits for the started jobs on the DRAM of D: the writers only, or the readers too. -1 when a job
+// on it is tied but not started, it would never finish.
+static int vdev_fence(vam_vm_t *VM, vdev_t *D, int readers)
+{
+  struct vdev_pool_t *DEV = VM->DEV;
+  vdev_dma_t         *m;
+  int                 k, run;
+  uint32_t            tag;
+
+  while (1) {
+    pthread_mutex_lock(&DEV->mutex);
+    for (k = (readers ? 0 : VDMA_RDS); k < VDMA_NODES; k++) {
+      m = &DEV->dma[D->card][k];
+      if (m->owner != -1 && m->addr < D->addr + (uint64_t)D->size * 4 && D->addr < m->addr + (uint64_t)m->size * 4) break;
+    }
+    if (k == VDMA_NODES) {
+      pthread_mutex_unlock(&DEV->mutex);
+      return 0;
+    }
+    run = m->run;
+    tag = m->tag;
+    pthread_mutex_unlock(&DEV->mutex);
+    if (!run) {
+      printf("[ERROR->vdev] card %d buffer 0x%llx: a job tied on it was not started\r\n", D->card, (unsigned long long)D->addr);
+      return -1;
+    }
+    if (vdev_wait(VM, D->card, k, tag) < 0) return -1;
+  }
+}
+
+// First fit of size words in the DRAM of card, -1 when no gap is large enough
+static int vdev_alloc(struct vdev_pool_t *DEV, int card, int size, vdev_t *D)
+{
+  vector<vdev_block_t>::iterator it;
+  vdev_block_t b;
+  uint64_t     at = 0;
+
+  b.bytes = ((uint64_t)size * 4 + VDEV_ALIGN - 1) / VDEV_ALIGN * VDEV_ALIGN;
+  if (b.bytes == 0) b.bytes = VDEV_ALIGN;
+
+  pthread_mutex_lock(&DEV->mutex);
+  for (it = DEV->block[card]->begin(); it != DEV->block[card]->end(); it++) {
+    if (it->addr - at >= b.bytes) break;
+    at = it->addr + it->bytes;
+  }
+  if (at + b.bytes > VDEV_BYTES) {
+    pthread_mutex_unlock(&DEV->mutex);
+    return -1;
+  }
+  b.addr = at;
+  DEV->block[card]->insert(it, b);
+  pthread_mutex_unlock(&DEV->mutex);
+
+  D->card = card;
+  D->addr = at;
+  D->size = size;
+  return 0;
+}
+
+// Called with DEV->mutex held
+static void vdev_free(struct vdev_pool_t *DEV, int card, uint64_t addr)
+{
+  int i;
+  for (i = 0; i < (int)DEV->block[card]->size(); i++)
+    if (DEV->block[card]->at(i).addr == addr) break;
+  if (i < (int)DEV->block[card]->size()) DEV->block[card]->erase(DEV->block[card]->begin() + i);
+}
+
+int vdevnew(vam_vm_t *VM, int card, int size, vdev_t *D)
+{
+  if (VM->DEV == NULL || card < 0 || card >= CARD || size < 0) return -1;
+  while (vdev_alloc(VM->DEV, card, size, D) < 0) {
+    if (vpcache_evict(VM, card) < 0) {
+      printf("[ERROR->vdevnew] card %d: no %llu bytes of DRAM left\r\n", card, (unsigned long long)size * 4);
+      return -1;
+    }
+  }
+  D->prio = 1;
+  #ifdef VERBOSE
+    printf("[DEBUG->vdevnew] card %d addr 0x%llx, %d words\r\n", card, (unsigned long long)D->addr, size);
+  #endif
+  return 0;
+}
+
+int vdevdel(vam_vm_t *VM, vdev_t *D)
+{
+  struct vdev_pool_t *DEV = VM->DEV;
+  if (DEV == NULL || vdev_fence(VM, D, 1) < 0) return -1;
+  pthread_mutex_lock(&DEV->mutex);
+  vdev_free(DEV, D->card, D->addr);
+  pthread_mutex_unlock(&DEV->mutex);
+  D->size = 0;
+  return 0;
+}
+
+int vdevwrite(vam_vm_t *VM, vdev_t *D, int *buf, int size)
+{
+  int err;
+  if (VM->DEV == NULL || size > D->size || vdev_fence(VM, D, 1) < 0) return -1;
+  err = VM->pico[D->card]->WriteRam(D->addr, buf, size * 4);
+  #ifdef VERBOSE
+    printf("[DEBUG->vdevwrite] card %d addr 0x%llx, %d words: %d\r\n", D->card, (unsigned long long)D->addr, size, err);
+  #endif
+  return (err < 0) ? -1 : 0;
+}
+
+int vdevread(vam_vm_t *VM, vdev_t *D, int *buf, int size)
+{
+  int err;
+  if (VM->DEV == NULL || size > D->size || vdev_fence(VM, D, 0) < 0) return -1;
+  err = VM->pico[D->card]->ReadRam(D->addr, buf, size * 4);
+  #ifdef VERBOSE
+    printf("[DEBUG->vdevread] card %d addr 0x%llx, %d words: %d\r\n", D->card, (unsigned long long)D->addr, size, err);
+  #endif
+  return (err < 0) ? -1 : 0;
+}
+
+// Waits until the jobs writing D are done
+int vdevsync(vam_vm_t *VM, vdev_t *D)
+{
+  if (VM->DEV == NULL) return -1;
+  return vdev_fence(VM, D, 0);
+}
+
+// Weight of the DMA node of the next jobs tied to D: while several readers (or writers) of the card
+// have a burst to issue, the node of D issues up to prio of them in a row, 1 by default
+int vdevprio(vam_vm_t *VM, vdev_t *D, int prio)
+{
+  if (VM->DEV == NULL || prio < 1 || prio > VDMA_PRIO_MAX) {
+    printf("[ERROR->vdevprio] card %d addr 0x%llx, priority %d not in 1 .. %d\r\n", D->card, (unsigned long long)D->addr,
+           prio, VDMA_PRIO_MAX);
+    return -1;
+  }
+  D->prio = prio;
+  return 0;
+}
+
+// Ties a DMA node of the card of nPR to D for the next job of nPR, a reader (wr 0) sending size words
+// of D to the crossbar or a writer (wr 1) storing size words nPR sends to the crossbar. Returns the
+// nPR of the DMA node, for the vtieio of nPR.
+int vdevtie(vam_vm_t *VM, int nPR, vdev_t *D, int size, int wr)
+{
+  struct vdev_pool_t *DEV  = VM->DEV;
+  int                 card = VNPR_CARD(nPR);
+  int                 k, run, shared = 0, cmd_stream, err;
+  uint32_t            cmd[4], tag;
+  vdev_dma_t         *m;
+
+  if (DEV == NULL || card != D->card || size > D->size || vam_shadow == VM) {
+    printf("[ERROR->vdevtie] nPR:0x%08x, buffer of card %d, %d of %d words%s\r\n", nPR, D->card, size, D->size,
+           (vam_shadow == VM) ? ", in vshadow" : "");
+    return -1;
+  }
+  // a writer waits for every started job on its DRAM, a reader for the writers
+  if (vdev_fence(VM, D, wr) < 0) return -1;
+
+  while (1) {
+    pthread_mutex_lock(&DEV->mutex);
+    for (k = 0; k < VDMA_RDS && !wr; k++) {           // several nodes reading D in one job
+      m = &DEV->dma[card][k];
+      if (m->owner != -1 && !m->run && m->addr == D->addr && m->size == size) { shared = 1; break; }
+    }
+    if (!shared) {
+      for (k = (wr ? VDMA_RDS : 0); k < (wr ? VDMA_NODES : VDMA_RDS); k++)
+        if (DEV->dma[card][k].owner == -1) break;
+      if (k == (wr ? VDMA_NODES : VDMA_RDS))
+        for (k = (wr ? VDMA_RDS : 0); k < (wr ? VDMA_NODES : VDMA_RDS); k++)
+          if (DEV->dma[card][k].run) break;
+    }
+    if (shared || k == (wr ? VDMA_NODES : VDMA_RDS) || DEV->dma[card][k].owner == -1) break;
+    run = DEV->dma[card][k].run;
+    tag = DEV->dma[card][k].tag;
+    pthread_mutex_unlock(&DEV->mutex);
+    if (run && vdev_wait(VM, card, k, tag) < 0) return -1;
+  }
+  if (k == (wr ? VDMA_NODES : VDMA_RDS)) {
+    pthread_mutex_unlock(&DEV->mutex);
+    printf("[ERROR->vdevtie] card %d: all %d DMA %s are in the job\r\n", card, wr ? VDMA_WRS : VDMA_RDS, wr ? "writers" : "readers");
+    return -1;
+  }
+  m = &DEV->dma[card][k];
+  if (!shared) {
+    m->owner = nPR;
+    m->run   = 0;
+    m->tag   = DEV->tag++ & 0xFFFF;
+    m->addr  = D->addr;
+    m->size  = size;
+  }
+  tag = m->tag;
+  pthread_mutex_unlock(&DEV->mutex);
+
+  #ifdef VERBOSE
+    printf("[DEBUG->vdevtie] nPR:0x%08x, DMA %s node %d, addr 0x%llx, %d words, tag %u, prio %d%s\r\n", nPR,
+           wr ? "writer" : "reader", NUM_ACCs + k, (unsigned long long)D->addr, size, tag, D->prio, shared ? ", shared" : "");
+  #endif
+  if (shared) return VNPR(card, NUM_ACCs + k);
+
+  pthread_mutex_lock(&VM->vm_mutex);
+  cmd_stream = VM->pico[card]->CreateStream(50);
+  cmd[0] = 0xC0100000 | VCMD_SLOT(NUM_ACCs + k + 1) | ((uint32_t)size >> 16);
+  cmd[1] = 0xC0200000 | VCMD_SLOT(NUM_ACCs + k + 1) | ((uint32_t)size & 0xFFFF);
+  cmd[2] = 0xC0500000 | VCMD_SLOT(NUM_ACCs + k + 1) | (uint32_t)(D->addr >> 16 & 0xFFFF);
+  cmd[3] = 0xC0600000 | VCMD_SLOT(NUM_ACCs + k + 1) | (uint32_t)(D->addr & 0xFFFF);
+  err = vcmd_write(VM, card, cmd_stream, cmd);
+  cmd[0] = 0xC0400000 | VCMD_SLOT(NUM_ACCs + k + 1) | tag;
+  cmd[1] = 0xC0300000 | VCMD_SLOT(NUM_ACCs + k + 1) | (uint32_t)D->prio;
+  cmd[2] = wr ? 0xB0000000 | VCMD_SRCA(VNPR_NODE(nPR) + 1) | VCMD_SLOT(NUM_ACCs + k + 1) : 0xDEADBEEF;  // reader: vstart
+  cmd[3] = 0xDEADBEEF;
+  if (err >= 0) err = vcmd_write(VM, card, cmd_stream, cmd);
+  VM->pico[card]->CloseStream(cmd_stream);
+  pthread_mutex_unlock(&VM->vm_mutex);
+  return (err < 0) ? -1 : VNPR(card, NUM_ACCs + k);
+}
+//==================================================================================================
+// vtieio with device buffers: each vdev_t endpoint becomes the nPR of its DMA node, then the vtieio
+// of jit_isa.h for host buffers and nodes runs as usual.
+static inline int * vdevlink(vam_vm_t *, int, int *buf, int, int, int *)  { return buf; }
+static inline int   vdevlink(vam_vm_t *, int, int node, int, int, int *)  { return node; }
+static inline int   vdevlink(vam_vm_t *VM, int nPR, vdev_t *D, int size, int wr, int *err)
+{
+  int n = vdevtie(VM, nPR, D, size, wr);
+  if (n < 0) *err = -1;
+  return n;
+}
+
+#define VTIEIO_DEV(T1, L1, T2, L2, T3, L3)                                                          \
+int vtieio(vam_vm_t *VM, int nPR, T1 in1, int size_in1, T2 in2, int size_in2, T3 out, int size_out)\
+{                                                                                                   \
+  int err = 0;                                                                                      \
+  L1  l1 = vdevlink(VM, nPR, in1, size_in1, 0, &err);                                               \
+  L2  l2 = (err < 0) ? (L2)0 : vdevlink(VM, nPR, in2, size_in2, 0, &err);                           \
+  L3  l3 = (err < 0) ? (L3)0 : vdevlink(VM, nPR, out, size_out, 1, &err);                           \
+  if (err < 0) return -1;                                                                           \
+  return vtieio(VM, nPR, l1, size_in1, l2, size_in2, l3, size_out);                                 \
+}
+
+VTIEIO_DEV(vdev_t *, int, int *,    int *, int *,    int *)
+VTIEIO_DEV(vdev_t *, int, int *,    int *, int,      int  )
+VTIEIO_DEV(vdev_t *, int, int *,    int *, vdev_t *, int  )
+VTIEIO_DEV(vdev_t *, int, int,      int,   int *,    int *)
+VTIEIO_DEV(vdev_t *, int, int,      int,   int,      int  )
+VTIEIO_DEV(vdev_t *, int, int,      int,   vdev_t *, int  )
+VTIEIO_DEV(vdev_t *, int, vdev_t *, int,   int *,    int *)
+VTIEIO_DEV(vdev_t *, int, vdev_t *, int,   int,      int  )
+VTIEIO_DEV(vdev_t *, int, vdev_t *, int,   vdev_t *, int  )
+VTIEIO_DEV(int *,    int *, vdev_t *, int, int *,    int *)
+VTIEIO_DEV(int *,    int *, vdev_t *, int, int,      int  )
+VTIEIO_DEV(int *,    int *, vdev_t *, int, vdev_t *, int  )
+VTIEIO_DEV(int,      int,   vdev_t *, int, int *,    int *)
+VTIEIO_DEV(int,      int,   vdev_t *, int, int,      int  )
+VTIEIO_DEV(int,      int,   vdev_t *, int, vdev_t *, int  )
+VTIEIO_DEV(int *,    int *, int *,    int *, vdev_t *, int)
+VTIEIO_DEV(int *,    int *, int,      int,   vdev_t *, int)
+VTIEIO_DEV(int,      int,   int *,    int *, vdev_t *, int)
+VTIEIO_DEV(int,      int,   int,      int,   vdev_t *, int)
+
+//==================================================================================================
+// Bitstream cache
+//==================================================================================================
+// Drops the least recently loaded bitstream of card not being loaded, -1 if there is none
+static int vpcache_evict(vam_vm_t *VM, int card)
+{
+  struct vdev_pool_t *DEV = VM->DEV;
+  int i, lru = -1;
+  pthread_mutex_lock(&DEV->mutex);
+  for (i = 0; i < (int)DEV->bits[card]->size(); i++)
+    if (!DEV->bits[card]->at(i).busy && (lru < 0 || DEV->bits[card]->at(i).used < DEV->bits[card]->at(lru).used)) lru = i;
+  if (lru >= 0) {
+    #ifdef VERBOSE
+      printf("[DEBUG->vpcache_evict] card %d: PR_NAME %d of node %d, %d words\r\n", card, DEV->bits[card]->at(lru).PR_NAME,
+             DEV->bits[card]->at(lru).node, DEV->bits[card]->at(lru).size);
+    #endif
+    vdev_free(DEV, card, DEV->bits[card]->at(lru).addr);
+    DEV->bits[card]->erase(DEV->bits[card]->begin() + lru);
+  }
+  pthread_mutex_unlock(&DEV->mutex);
+  return (lru < 0) ? -1 : 0;
+}
+
+// Copies the bitstream of PR_NAME for region node into the DRAM of card. For vlpr (lpr 1) older
+// bitstreams make room and the entry is held busy, a preload only takes free DRAM. -1 if it does
+// not fit.
+static int vpcache_load(vam_vm_t *VM, int card, int node, int PR_NAME, int lpr, vdev_bit_t *e)
+{
+  struct vdev_pool_t *DEV  = VM->DEV;
+  int                 size = (int)VM->BITSTREAM_TABLE->item[PR_NAME].BitSize[node];
+  vdev_t              D;
+
+  if (size == 0) return -1;
+  while (vdev_alloc(DEV, card, size, &D) < 0)
+    if (!lpr || vpcache_evict(VM, card) < 0) return -1;
+  if (VM->pico[card]->WriteRam(D.addr, VM->BITSTREAM_TABLE->item[PR_NAME].BitAddr[node], size * 4) < 0) {
+    pthread_mutex_lock(&DEV->mutex);
+    vdev_free(DEV, card, D.addr);
+    pthread_mutex_unlock(&DEV->mutex);
+    return -1;
+  }
+  e->PR_NAME = PR_NAME;
+  e->node    = node;
+  e->addr    = D.addr;
+  e->size    = size;
+  e->busy    = lpr;
+  pthread_mutex_lock(&DEV->mutex);
+  e->used    = ++DEV->tick;
+  DEV->bits[card]->push_back(*e);
+  pthread_mutex_unlock(&DEV->mutex);
+  #ifdef VERBOSE
+    printf("[DEBUG->vpcache_load] card %d: PR_NAME %d of node %d at 0x%llx, %d words\r\n", card, PR_NAME, node,
+           (unsigned long long)D.addr, size);
+  #endif
+  return 0;
+}
+
+// vlpr takes its bitstreams from the card DRAM from now on; preload 1 copies every registered one
+// there first, as long as they fit. Needs VDEV_INIT.
+int vpcache_on(vam_vm_t *VM, int preload)
+{
+  vdev_bit_t e;
+  int        card, node, PR_NAME, i, cached;
+
+  if (VM->DEV == NULL) return -1;
+  for (card = 0; card < CARD && preload; card++)
+    for (PR_NAME = 1; PR_NAME < MAX_NUM_MODULES; PR_NAME++) {
+      if (!vhasbit(VM, PR_NAME)) continue;
+      for (node = 0; node < ROW; node++) {
+        pthread_mutex_lock(&VM->DEV->mutex);
+        for (i = 0, cached = 0; i < (int)VM->DEV->bits[card]->size(); i++)
+          if (VM->DEV->bits[card]->at(i).PR_NAME == PR_NAME && VM->DEV->bits[card]->at(i).node == node) cached = 1;
+        pthread_mutex_unlock(&VM->DEV->mutex);
+        if (!cached) vpcache_load(VM, card, node, PR_NAME, 0, &e);
+      }
+    }
+  VM->DEV->lpr = vpcache_lpr;
+  return 0;
+}
+
+// Back to stream 100, the cached bitstreams are dropped
+void vpcache_off(vam_vm_t *VM)
+{
+  int card;
+  if (VM->DEV == NULL) return;
+  pthread_mutex_lock(&VM->DEV->pr_mutex);
+  VM->DEV->lpr = NULL;
+  for (card = 0; card < CARD; card++)
+    while (vpcache_evict(VM, card) == 0);
+  pthread_mutex_unlock(&VM->DEV->pr_mutex);
+}
+
+// vlpr of PR_NAME on nPR through the PR reader, called by vlpr with pr_mutex held. 1 when the
+// bitstream cannot be cached, vlpr then sends it on stream 100.
+int vpcache_lpr(vam_vm_t *VM, int nPR, int PR_NAME)
+{
+  struct vdev_pool_t *DEV  = VM->DEV;
+  int                 card = VNPR_CARD(nPR);
+  int                 node = VNPR_NODE(nPR);
+  int                 i, cmd_stream, err, hit = 0;
+  uint32_t            cmd[4] = {0, 0xDEADBEEF, 0xDEADBEEF, 0xBABEFACE}, tag;
+  vdev_bit_t          e;
+
+  pthread_mutex_lock(&DEV->mutex);
+  for (i = 0; i < (int)DEV->bits[card]->size(); i++) {
+    vdev_bit_t *b = &DEV->bits[card]->at(i);
+    if (b->PR_NAME == PR_NAME && b->node == node) {
+      b->busy++;
+      b->used = ++DEV->tick;
+      e   = *b;
+      hit = 1;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&DEV->mutex);
+  if (!hit && vpcache_load(VM, card, node, PR_NAME, 1, &e) < 0) return 1;
+  pthread_mutex_lock(&DEV->mutex);
+  tag = DEV->tag++ & 0xFFFF;
+  pthread_mutex_unlock(&DEV->mutex);
+  #ifdef VERBOSE
+    printf("[DEBUG->vpcache_lpr] nPR:0x%08x, PR_NAME %d %s, 0x%llx, %d words, tag %u\r\n", nPR, PR_NAME, hit ? "cached" : "loaded",
+           (unsigned long long)e.addr, e.size, tag);
+  #endif
+
+  // PR start, the PR reader job, its record, PR end
+  pthread_mutex_lock(&VM->vm_mutex);
+  cmd_stream = VM->pico[card]->CreateStream(50);
+  cmd[0] = 0xD000BEEF | VCMD_SLOT(node + 1);
+  err = VM->pico[card]->WriteStream(cmd_stream, cmd, 16);
+  cmd[0] = 0xC0100000 | VCMD_SLOT(VPR_NODE + 1) | ((uint32_t)e.size >> 16);
+  cmd[1] = 0xC0200000 | VCMD_SLOT(VPR_NODE + 1) | ((uint32_t)e.size & 0xFFFF);
+  cmd[2] = 0xC0500000 | VCMD_SLOT(VPR_NODE + 1) | (uint32_t)(e.addr >> 16 & 0xFFFF);
+  cmd[3] = 0xC0600000 | VCMD_SLOT(VPR_NODE + 1) | (uint32_t)(e.addr & 0xFFFF);
+  if (err >= 0) err = VM->pico[card]->WriteStream(cmd_stream, cmd, 16);
+  cmd[0] = 0xC0400000 | VCMD_SLOT(VPR_NODE + 1) | tag;
+  cmd[1] = 0xB0000000 | VCMD_SLOT(VPR_NODE + 1);
+  cmd[2] = 0xDEADBEEF;
+  cmd[3] = 0xDEADBEEF;
+  if (err >= 0) err = VM->pico[card]->WriteStream(cmd_stream, cmd, 16);
+  VM->pico[card]->CloseStream(cmd_stream);
+  pthread_mutex_unlock(&VM->vm_mutex);
+
+  if (err >= 0) err = vdev_wait(VM, card, VDMA_NODES, tag);
+
+  pthread_mutex_lock(&VM->vm_mutex);
+  cmd_stream = VM->pico[card]->CreateStream(50);
+  cmd[0] = 0xD000DEAD | VCMD_SLOT(node + 1);
+  cmd[1] = (err >= 0) ? VCMD_PRID | VCMD_SLOT(node + 1) | (PR_NAME & 0xFFFF) : 0xDEADBEEF;
+  cmd[3] = 0xBABEFACE;
+  if (VM->pico[card]->WriteStream(cmd_stream, cmd, 16) < 0) err = -1;
+  VM->pico[card]->CloseStream(cmd_stream);
+  if (err >= 0) VM->VAM_TABLE->at(VNPR_INDEX(nPR)).PR_key = PR_NAME;
+  pthread_mutex_unlock(&VM->vm_mutex);
+
+  pthread_mutex_lock(&DEV->mutex);
+  for (i = 0; i < (int)DEV->bits[card]->size(); i++)
+    if (DEV->bits[card]->at(i).PR_NAME == PR_NAME && DEV->bits[card]->at(i).node == node) DEV->bits[card]->at(i).busy--;
+  pthread_mutex_unlock(&DEV->mutex);
+  if (err < 0) printf("[ERROR->vpcache_lpr] nPR:0x%08x, PR_NAME %d\r\n", nPR, PR_NAME);
+  return (err < 0) ? -1 : 0;
+}
+
+#endif
@@ -0,0 +1,424 @@
+#ifndef JIT_EXPR_H
+#define JIT_EXPR_H
+//==================================================================================================
+// Element-wise expressions over host vectors, compiled onto chained nodes.
+//
+// An expression is built bottom-up with vexpr_leaf / vexpr_add / vexpr_sub / vexpr_mul. Building
+// hash-conses the nodes, so a subexpression written twice is one node (A+B and B+A as well).
+// vexpr_run then
+//
+//   fuses       x*x + y*y -> A2PB2(x, y), x + y*y -> VAPBB(x, y), x*x + y -> VAAPB(x, y) for the
+//               fused kernels the overlay has
+//   cuts        every node used more than once, the operators without a bitstream (run on the CPU)
+//               and their inputs are written to host buffers; the rest only feeds one consumer and
+//               is linked to it by a Reg edge, like the hand written shapes of NewJit06
+//   splits      the chains larger than the claimed nodes at their largest subtree, which then goes
+//               through a host buffer too
+//   shares      a node used more than once joins the chain of its card consumers when they fit:
+//               the crossbar sends its result to all of them (x*x reads one stream on A and B),
+//               and to the host as well when a later chain or the CPU also needs it
+//   schedules   the chains level by level in waves that fit the nodes, the CPU operators of a
+//               level run while the card streams
+//
+//   vexpr_t E;
+//   VEXPR_INIT(&E);
+//   int a = vexpr_leaf(&E, A), b = vexpr_leaf(&E, B);
+//   int r = vexpr_add(&E, vexpr_mul(&E, a, a), vexpr_mul(&E, b, b));   // A2PB2 when present
+//   err = vexpr_run(VM, &E, r, C, size, 8, NULL);
+//   VEXPR_CLEAN(&E);
+//==================================================================================================
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <vector>
+#include <algorithm>
+#include "jit_isa.h"
+#include "jit_split.h"
+
+#define VEXPR_MIN       4096         // shorter vectors are evaluated on the CPU
+
+typedef struct {
+  int   op;         // NOP for a leaf
+  int   a, b;       // operands, node ids
+  int  *buf;        // leaf: host vector
+}vexpr_node_t;
+
+typedef struct {
+  vector<vexpr_node_t>  node;
+}vexpr_t;
+
+typedef struct {
+  int   nodes;      // nodes claimed
+  int   ops;        // operators after CSE and fusion
+  int   fused;
+  int   cpu;        // operators run on the CPU
+  int   temps;      // host buffers between chains
+  int   shared;     // results read by several nodes through the crossbar
+  int   waves;
+}vexpr_stat_t;
+
+// Compiled form, one entry per expression node
+typedef struct {
+  vector<int>   op, a, b;
+  vector<int>   order;      // operators in topological order
+  vector<int>   uses, cons; // number of uses, consumer when used once or in its chain
+  vector<int>   mat;        // result goes through a host buffer
+  vector<int>   cast;       // and to its consumers in the chain through the crossbar
+  vector<int>   cpu;
+  vector<int>   unit;       // chain (its root node) of every operator
+  vector<int>   size;       // nodes of a chain, at its root
+  vector<int>   level;      // of a chain, at its root
+  vector<int>   nPR;
+  vector<int *> buf;
+}vexpr_plan_t;
+
+typedef struct {
+  vam_vm_t      *VM;
+  vector<int>   *nPR;
+}vexpr_pk_t;
+
+//==================================================================================================
+void   VEXPR_INIT                 (vexpr_t *E);
+void   VEXPR_CLEAN                (vexpr_t *E);
+ int   vexpr_leaf                 (vexpr_t *E, int *buf);
+ int   vexpr_op                   (vexpr_t *E, int op, int a, int b);
+ int   vexpr_add                  (vexpr_t *E, int a, int b);
+ int   vexpr_sub                  (vexpr_t *E, int a, int b);
+ int   vexpr_mul                  (vexpr_t *E, int a, int b);
+ int   vexpr_compile              (vam_vm_t *VM, vexpr_t *E, int root, int nodes, vexpr_plan_t *P);
+ int   vexpr_run                  (vam_vm_t *VM, vexpr_t *E, int root, int *C, int size, int nodes, vexpr_stat_t *stat);
+void * vexpr_Threads_Call         (void *pk);
+//==================================================================================================
+void VEXPR_INIT(vexpr_t *E)
+{
+  E->node.clear();
+}
+
+void VEXPR_CLEAN(vexpr_t *E)
+{
+  E->node.clear();
+}
+
+int vexpr_leaf(vexpr_t *E, int *buf)
+{
+  int i;
+  for (i = 0; i < (int)E->node.size(); i++)
+    if (E->node[i].op == NOP && E->node[i].buf == buf) return i;
+
+  vexpr_node_t n = {NOP, -1, -1, buf};
+  E->node.push_back(n);
+  return E->node.size() - 1;
+}
+
+// Returns the existing node for (op, a, b) if there is one, operands of VADD/VMUL in order.
+int vexpr_op(vexpr_t *E, int op, int a, int b)
+{
+  int i;
+  if (a < 0 || b < 0 || a >= (int)E->node.size() || b >= (int)E->node.size()) return -1;
+  if ((op == VADD || op == VMUL) && a > b) std::swap(a, b);
+  for (i = 0; i < (int)E->node.size(); i++)
+    if (E->node[i].op == op && E->node[i].a == a && E->node[i].b == b) return i;
+
+  vexpr_node_t n = {op, a, b, NULL};
+  E->node.push_back(n);
+  return E->node.size() - 1;
+}
+
+int vexpr_add(vexpr_t *E, int a, int b) { return vexpr_op(E, VADD, a, b); }
+int vexpr_sub(vexpr_t *E, int a, int b) { return vexpr_op(E, VSUB, a, b); }
+int vexpr_mul(vexpr_t *E, int a, int b) { return vexpr_op(E, VMUL, a, b); }
+//==================================================================================================
+//    ___                _ _
+//   / __|___ _ __  _ __(_) |___
+//  | (__/ _ \ '  \| '_ \ | / -_)
+//   \___\___/_|_|_| .__/_|_\___|
+//                 |_|
+//==================================================================================================
+static void vexpr_order(vexpr_plan_t *P, int n, vector<int> *seen)
+{
+  if (P->op[n] == NOP || seen->at(n)) return;
+  seen->at(n) = 1;
+  vexpr_order(P, P->a[n], seen);
+  vexpr_order(P, P->b[n], seen);
+  P->order.push_back(n);
+}
+
+// n reaches its consumer m through a host buffer, not through the crossbar of their chain
+static int vexpr_buffered(vexpr_plan_t *P, int n, int m)
+{
+  return P->op[n] != NOP && P->mat[n] && !(P->cast[n] && P->unit[n] == P->unit[m]);
+}
+
+// Level of every chain, one above the chains of its buffered inputs. -1 when the chains read each
+// other's buffers (a shared node joined a chain which a reader of its buffer feeds)
+static int vexpr_levels(vexpr_plan_t *P)
+{
+  int i, j, n, pass, moved = 1;
+  P->level.assign(P->level.size(), 0);
+  for (pass = 0; moved && pass <= (int)P->order.size(); pass++) {
+    moved = 0;
+    for (i = 0; i < (int)P->order.size(); i++) {
+      n = P->order[i];
+      int in[2] = {P->a[n], P->b[n]};
+      for (j = 0; j < 2; j++) {
+        if (!vexpr_buffered(P, in[j], n) || P->level[P->unit[n]] > P->level[P->unit[in[j]]]) continue;
+        P->level[P->unit[n]] = P->level[P->unit[in[j]]] + 1;
+        moved = 1;
+      }
+    }
+  }
+  return moved ? -1 : 0;
+}
+
+// nodes = 0 compiles for the CPU only
+int vexpr_compile(vam_vm_t *VM, vexpr_t *E, int root, int nodes, vexpr_plan_t *P)
+{
+  int total = E->node.size(), i, j, n;
+
+  if (root < 0 || root >= total) return -1;
+  P->op.resize(total); P->a.resize(total); P->b.resize(total);
+  for (i = 0; i < total; i++) {
+    P->op[i] = E->node[i].op;
+    P->a[i]  = E->node[i].a;
+    P->b[i]  = E->node[i].b;
+  }
+
+  // fusion, the operands are older than the node
+  for (i = 0; i < total && nodes > 0; i++) {
+    if (P->op[i] != VADD) continue;
+    int x = P->a[i], y = P->b[i];
+    int sx = (P->op[x] == VMUL && P->a[x] == P->b[x]), sy = (P->op[y] == VMUL && P->a[y] == P->b[y]);
+    if      (sx && sy && vhasbit(VM, A2PB2)) { P->op[i] = A2PB2; P->a[i] = P->a[x]; P->b[i] = P->a[y]; }
+    else if (sy && vhasbit(VM, VAPBB))       { P->op[i] = VAPBB; P->a[i] = x;       P->b[i] = P->a[y]; }
+    else if (sx && vhasbit(VM, VAPBB))       { P->op[i] = VAPBB; P->a[i] = y;       P->b[i] = P->a[x]; }
+    else if (sx && vhasbit(VM, VAAPB))       { P->op[i] = VAAPB; P->a[i] = P->a[x]; P->b[i] = y;       }
+    else if (sy && vhasbit(VM, VAAPB))       { P->op[i] = VAAPB; P->a[i] = P->a[y]; P->b[i] = x;       }
+  }
+
+  vector<int> seen(total, 0);
+  P->order.clear();
+  vexpr_order(P, root, &seen);
+
+  P->uses.assign(total, 0);  P->cons.assign(total, -1);
+  P->mat.assign(total, 0);   P->cpu.assign(total, 0);
+  P->cast.assign(total, 0);
+  P->unit.assign(total, -1); P->size.assign(total, 0);
+  P->level.assign(total, 0); P->nPR.assign(total, -1);
+  P->buf.assign(total, (int *)NULL);
+  for (i = 0; i < (int)P->order.size(); i++) {
+    n = P->order[i];
+    P->uses[P->a[n]]++; P->cons[P->a[n]] = n;
+    P->uses[P->b[n]]++; P->cons[P->b[n]] = n;
+    P->cpu[n] = (nodes == 0) || !vhasbit(VM, P->op[n]);
+  }
+  for (i = 0; i < (int)P->order.size(); i++) {
+    n = P->order[i];
+    if (n == root || P->uses[n] > 1 || P->cpu[n]) P->mat[n] = 1;
+    if (P->cpu[n]) P->mat[P->a[n]] = P->mat[P->b[n]] = 1;
+  }
+
+  // chains of at most nodes operators: cut the largest linked subtree until it fits
+  for (i = 0; i < (int)P->order.size(); i++) {
+    n = P->order[i];
+    if (P->cpu[n]) continue;
+    int ca = (P->op[P->a[n]] != NOP && !P->mat[P->a[n]]) ? P->size[P->a[n]] : 0;
+    int cb = (P->op[P->b[n]] != NOP && !P->mat[P->b[n]]) ? P->size[P->b[n]] : 0;
+    while (1 + ca + cb > nodes) {
+      if (ca >= cb) { P->mat[P->a[n]] = 1; ca = 0; }
+      else          { P->mat[P->b[n]] = 1; cb = 0; }
+    }
+    P->size[n] = 1 + ca + cb;
+  }
+
+  // chain of every operator, from the roots down
+  for (i = (int)P->order.size() - 1; i >= 0; i--) {
+    n = P->order[i];
+    P->unit[n] = P->mat[n] ? n : P->unit[P->cons[n]];
+  }
+  vexpr_levels(P);
+
+  // shared nodes into the chain of their first card consumer, when that fits and keeps the levels
+  for (i = 0; i < (int)P->order.size() && nodes > 0; i++) {
+    n = P->order[i];
+    if (n == root || P->uses[n] < 2 || P->cpu[n]) continue;
+    int u = -1, other = 0, size = 0;
+    for (j = 0; j < (int)P->order.size(); j++) {
+      int m = P->order[j];
+      if (P->a[m] != n && P->b[m] != n) continue;
+      if (u < 0 && !P->cpu[m]) { u = P->unit[m]; P->cons[n] = m; }
+      else other |= P->cpu[m] || P->unit[m] != u;
+    }
+    for (j = 0; j < (int)P->order.size(); j++) {
+      int m = P->order[j];
+      size += !P->cpu[m] && (P->unit[m] == u || P->unit[m] == n);
+    }
+    if (u < 0 || size > nodes) continue;
+
+    vector<int> unit = P->unit;
+    for (j = 0; j < (int)P->order.size(); j++)
+      if (P->unit[P->order[j]] == n) P->unit[P->order[j]] = u;
+    P->mat[n]  = other;
+    P->cast[n] = other;
+    if (vexpr_levels(P) < 0) {
+      P->unit    = unit;
+      P->mat[n]  = 1;
+      P->cast[n] = 0;
+      vexpr_levels(P);
+    }
+  }
+  for (i = 0; i < (int)P->order.size(); i++) {
+    n = P->order[i];
+    P->size[n] = 0;
+  }
+  for (i = 0; i < (int)P->order.size(); i++) {
+    n = P->order[i];
+    P->size[P->unit[n]] += !P->cpu[n];
+  }
+  return 0;
+}
+//==================================================================================================
+//   ___
+//  | _ \_  _ _ _  ___
+//  |   / || | ' \(_-<
+//  |_|_\\_,_|_||_/__/
+//==================================================================================================
+void * vexpr_Threads_Call(void *pk)
+{
+  vexpr_pk_t *p = (vexpr_pk_t *) pk;
+  int err = vstart(p->VM, p->nPR);                                                                  errCheck(err, FUN_VSTART);
+  return NULL;
+}
+
+// vtieio for any mix of host buffers (b*) and nodes (r*) on the three ports
+static int vexpr_tie(vam_vm_t *VM, int nPR, int *b1, int r1, int *b2, int r2, int *bo, int ro, int size)
+{
+  if ( b1 &&  b2 &&  bo) return vtieio(VM, nPR, b1, size, b2, size, bo, size);
+  if ( b1 &&  b2 && !bo) return vtieio(VM, nPR, b1, size, b2, size, ro, size);
+  if ( b1 && !b2 &&  bo) return vtieio(VM, nPR, b1, size, r2, size, bo, size);
+  if ( b1 && !b2 && !bo) return vtieio(VM, nPR, b1, size, r2, size, ro, size);
+  if (!b1 &&  b2 &&  bo) return vtieio(VM, nPR, r1, size, b2, size, bo, size);
+  if (!b1 &&  b2 && !bo) return vtieio(VM, nPR, r1, size, b2, size, ro, size);
+  if (!b1 && !b2 &&  bo) return vtieio(VM, nPR, r1, size, r2, size, bo, size);
+  return                        vtieio(VM, nPR, r1, size, r2, size, ro, size);
+}
+
+// Host vector of input n of m, NULL for a Reg edge
+static int * vexpr_in(vexpr_t *E, vexpr_plan_t *P, int n, int m)
+{
+  return (P->op[n] == NOP) ? E->node[n].buf : vexpr_buffered(P, n, m) ? P->buf[n] : NULL;
+}
+
+int vexpr_run(vam_vm_t *VM, vexpr_t *E, int root, int *C, int size, int nodes, vexpr_stat_t *stat)
+{
+  vexpr_plan_t P;
+  vexpr_stat_t st;
+  vector<int>  nPR, cards;
+  int          i, j, n, lvl, top = 0, err, card = -1;
+  int          threads = (size < VCPU_MT_MIN) ? 1 : vcpu_threads();
+
+  if (root < 0 || root >= (int)E->node.size()) return -1;
+  memset(&st, 0, sizeof(st));
+  if (E->node[root].op == NOP) {
+    memmove(C, E->node[root].buf, (size_t)size * 4);
+    if (stat != NULL) *stat = st;
+    return 0;
+  }
+
+  // nodes of the card with the most free ones, Reg edges stay inside a card
+  if (size >= VEXPR_MIN && nodes > 0) {
+    vsplit_claim(VM, VADD, &nPR, nodes);
+    vector<int> count(CARD, 0), spare;
+    for (i = 0; i < (int)nPR.size(); i++) count[VNPR_CARD(nPR[i])]++;
+    card = (int)(std::max_element(count.begin(), count.end()) - count.begin());
+    for (i = 0; i < (int)nPR.size(); i++) {
+      if (VNPR_CARD(nPR[i]) != card) { spare.push_back(nPR[i]); nPR.erase(nPR.begin() + i--); }
+    }
+    if (!spare.empty()) vdel(VM, &spare);
+  }
+  vexpr_compile(VM, E, root, nPR.size(), &P);
+
+  for (i = 0; i < (int)P.order.size(); i++) {
+    n = P.order[i];
+    st.ops   += 1;
+    st.fused += (P.op[n] == A2PB2 || P.op[n] == VAPBB || P.op[n] == VAAPB);
+    st.cpu   += P.cpu[n];
+    st.shared += (P.uses[n] > 1 && !P.cpu[n] && P.unit[n] != n);
+    if (P.mat[n]) {
+      P.buf[n] = (n == root) ? C : new int[size];
+      st.temps += (n != root);
+    }
+    if (P.mat[n]) top = std::max(top, P.level[n]);
+  }
+  #ifdef VERBOSE
+    printf("[DEBUG->vexpr_run] size:%d nodes:%d ops:%d fused:%d cpu:%d temps:%d shared:%d levels:%d\r\n", size, (int)nPR.size(), st.ops, st.fused, st.cpu, st.temps, st.shared, top + 1);
+    for (i = 0; i < (int)P.order.size(); i++) {
+      n = P.order[i];
+      printf("[DEBUG->vexpr_run]   n%d = op%d(n%d, n%d) %s%s chain n%d level %d\r\n", n, P.op[n], P.a[n], P.b[n], P.cpu[n] ? "cpu " : "", P.mat[n] ? (P.cast[n] ? "buf+xbar" : "buf") : "reg", P.unit[n], P.level[P.unit[n]]);
+    }
+  #endif
+
+  for (lvl = 0; lvl <= top; lvl++) {
+    vector<int> chain;
+    for (i = 0; i < (int)P.order.size(); i++) {
+      n = P.order[i];
+      if (P.unit[n] == n && P.level[n] == lvl) chain.push_back(n);
+    }
+
+    // the card chains of the level in waves of nPR.size() nodes, the CPU ones next to the first
+    int first = 1, c = 0;
+    while (first || c < (int)chain.size()) {
+      vector<int> wave;
+      int         used = 0;
+      for (; c < (int)chain.size(); c++) {
+        if (P.cpu[chain[c]]) continue;
+        if (used + P.size[chain[c]] > (int)nPR.size()) break;
+        for (i = 0; i < (int)P.order.size(); i++) {
+          n = P.order[i];
+          if (P.unit[n] == chain[c] && !P.cpu[n]) { P.nPR[n] = nPR[used++]; wave.push_back(n); }
+        }
+      }
+      // the routing of the whole wave in one burst, none for a CPU only level (VM may be NULL)
+      for (i = 0; i < (int)wave.size(); i++) {
+        err = vlpr(VM, P.nPR[wave[i]], P.op[wave[i]]);                                              errCheck(err, FUN_VLPR);
+      }
+      if (!wave.empty()) {
+        vburst_begin(VM);
+        for (i = 0; i < (int)wave.size(); i++) {
+          n   = wave[i];
+          if (P.cast[n]) vsetcast(VM, P.nPR[n]);
+          err = vexpr_tie(VM, P.nPR[n], vexpr_in(E, &P, P.a[n], n), P.nPR[P.a[n]], vexpr_in(E, &P, P.b[n], n), P.nPR[P.b[n]],
+                          P.mat[n] ? P.buf[n] : NULL, P.mat[n] ? -1 : P.nPR[P.cons[n]], size);      errCheck(err, FUN_VTIEIO);
+        }
+        err = vburst_end(VM);                                                                       errCheck(err, FUN_VTIEIO);
+      }
+
+      vector<int> node;
+      pthread_t   thread;
+      vexpr_pk_t  pk;
+      for (i = 0; i < (int)wave.size(); i++) node.push_back(P.nPR[wave[i]]);
+      pk.VM = VM; pk.nPR = &node;
+      if (!wave.empty()) pthread_create(&thread, NULL, vexpr_Threads_Call, (void*) &pk);
+      if (first) {
+        for (j = 0; j < (int)chain.size(); j++) {
+          n = chain[j];
+          if (P.cpu[n]) vcpu_run(P.op[n], vexpr_in(E, &P, P.a[n], n), vexpr_in(E, &P, P.b[n], n), P.buf[n], size, 0, threads);
+        }
+      }
+      if (!wave.empty()) {
+        pthread_join(thread, NULL);
+        st.waves++;
+      }
+      first = 0;
+    }
+  }
+
+  if (!nPR.empty()) vdel(VM, &nPR);
+  for (i = 0; i < (int)P.order.size(); i++)
+    if (P.buf[P.order[i]] != NULL && P.order[i] != root) delete[] P.buf[P.order[i]];
+
+  st.nodes = nPR.size();
+  if (stat != NULL) *stat = st;
+  return 0;
+}
+
+#endif
@@ -0,0 +1,376 @@
+#ifndef JIT_GEMM_H
+#define JIT_GEMM_H
+//==================================================================================================
+// Tiled int32 GEMM on ACCMM / ACCMMM, C[M x N] = A[M x K] x B[K x N], row-major, 32-bit wrap-around.
+//
+// A and B are packed once in VGEMM_TILE x VGEMM_TILE tiles, the tiles of a row panel of A and of a
+// column panel of B next to each other, so the inputs of an output tile are two contiguous streams.
+// The claimed nodes are cut in lanes inside each card, every lane takes the next output tile of a
+// shared counter, so the lanes of all the cards stream at the same time and one lane is tied while
+// the others transfer. A lane is
+//
+//   1 ACCMMM node                                      the K loop is accumulated in the node
+//   s ACCMMM legs + (s - 1) VADD nodes                 few output tiles and a long K: the legs take
+//                                                      a share of K, their tiles are added on the
+//                                                      card and one tile comes back
+//   1 ACCMM node                                       overlay without ACCMMM: one product per tile
+//                                                      pair, the host adds them up
+//
+// Small products and overlays without ACCMM/ACCMMM run on the blocked CPU GEMM.
+//
+//   vgemm_stat_t st;
+//   err = vgemm(VM, A, B, C, M, N, K, 8, &st);    // st.gflops: 2*M*N*K / time
+//==================================================================================================
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <sys/time.h>
+#include <pthread.h>
+#include <immintrin.h>
+#include <vector>
+#include <algorithm>
+#include "jit_isa.h"
+#include "jit_split.h"
+
+#define VGEMM_TILE      VCPU_TILE
+#define VGEMM_TT        (VGEMM_TILE * VGEMM_TILE)
+#define VGEMM_BLOCK     64                 // CPU blocking, rows/columns/depth
+#define VGEMM_MIN       (64 * 64 * 64)     // M*N*K below which the CPU is used
+#define VGEMM_MAX_LEGS  4
+
+#define VGEMM_CPU       0
+#define VGEMM_FPGA      1
+
+typedef struct {
+  int        target;   // VGEMM_CPU / VGEMM_FPGA
+  int        nodes;
+  int        lanes;
+  int        legs;     // ACCMMM nodes per lane
+  int        tiles;    // output tiles
+  double     us;
+  double     gflops;   // 2*M*N*K / us, int32 operations
+}vgemm_stat_t;
+
+typedef struct {
+  pthread_mutex_t  mutex;
+  int              next;     // next output tile
+  int              tiles;
+  int              MT, NT, KT;
+  const int       *Ap;       // MT x KT tiles
+  const int       *Bp;       // NT x KT tiles, column panels
+  int             *C;
+  int              M, N;
+}vgemm_job_t;
+
+typedef struct {
+  vam_vm_t     *VM;
+  vgemm_job_t  *job;
+  vector<int>   nPR;       // legs first, then the VADD nodes
+  int           op;        // ACCMMM or ACCMM
+  int           legs;
+}vgemm_lane_t;
+
+typedef struct {
+  const int    *A, *B;
+  int          *C;
+  int           M0, M1, N, K;
+}vgemm_cpu_pk_t;
+
+//==================================================================================================
+ int   vgemm                      (vam_vm_t *VM, const int *A, const int *B, int *C, int M, int N, int K, int nodes, vgemm_stat_t *stat);
+ int   vgemm_cpu                  (const int *A, const int *B, int *C, int M, int N, int K, int threads);
+void * vgemm_cpu_Threads_Call     (void *pk);
+void * vgemm_lane_Threads_Call    (void *pk);
+//==================================================================================================
+//    ___ ___ _   _
+//   / __| _ \ | | |
+//  | (__|  _/ |_| |
+//   \___|_|  \___/
+//==================================================================================================
+// c[j] += x * b[j], the inner loop of the CPU GEMM
+static inline void vgemm_axpy_scalar(uint32_t *c, const uint32_t *b, uint32_t x, int n)
+{
+  int j;
+  for (j = 0; j < n; j++) c[j] += x * b[j];
+}
+
+__attribute__((target("avx2")))
+static inline void vgemm_axpy_avx2(uint32_t *c, const uint32_t *b, uint32_t x, int n)
+{
+  __m256i vx = _mm256_set1_epi32((int)x);
+  int j = 0;
+  for (; j + 8 <= n; j += 8) {
+    __m256i vb = _mm256_loadu_si256((const __m256i *)(b + j));
+    __m256i vc = _mm256_loadu_si256((const __m256i *)(c + j));
+    _mm256_storeu_si256((__m256i *)(c + j), _mm256_add_epi32(vc, _mm256_mullo_epi32(vx, vb)));
+  }
+  vgemm_axpy_scalar(c + j, b + j, x, n - j);
+}
+
+__attribute__((target("avx512f")))
+static inline void vgemm_axpy_avx512(uint32_t *c, const uint32_t *b, uint32_t x, int n)
+{
+  __m512i vx = _mm512_set1_epi32((int)x);
+  int j = 0;
+  for (; j + 16 <= n; j += 16) {
+    __m512i vb = _mm512_loadu_si512((const void *)(b + j));
+    __m512i vc = _mm512_loadu_si512((const void *)(c + j));
+    _mm512_storeu_si512((void *)(c + j), _mm512_add_epi32(vc, _mm512_mullo_epi32(vx, vb)));
+  }
+  vgemm_axpy_scalar(c + j, b + j, x, n - j);
+}
+
+// Rows [M0, M1) of C, blocked on rows, depth and columns.
+void * vgemm_cpu_Threads_Call(void *pk)
+{
+  vgemm_cpu_pk_t *p  = (vgemm_cpu_pk_t *) pk;
+  const uint32_t *ua = (const uint32_t *)p->A, *ub = (const uint32_t *)p->B;
+  uint32_t       *uc = (uint32_t *)p->C;
+  int N = p->N, K = p->K, isa = vcpu_isa();
+  int ii, kk, jj, i, k;
+
+  for (i = p->M0; i < p->M1; i++) memset(uc + (int64_t)i * N, 0, (size_t)N * 4);
+  for (ii = p->M0; ii < p->M1; ii += VGEMM_BLOCK)
+    for (kk = 0; kk < K; kk += VGEMM_BLOCK)
+      for (jj = 0; jj < N; jj += VGEMM_BLOCK) {
+        int i1 = std::min(ii + VGEMM_BLOCK, p->M1), k1 = std::min(kk + VGEMM_BLOCK, K), n = std::min(VGEMM_BLOCK, N - jj);
+        for (i = ii; i < i1; i++)
+          for (k = kk; k < k1; k++) {
+            uint32_t        x = ua[(int64_t)i * K + k];
+            const uint32_t *b = ub + (int64_t)k * N + jj;
+            uint32_t       *c = uc + (int64_t)i * N + jj;
+            if      (isa == VCPU_AVX512) vgemm_axpy_avx512(c, b, x, n);
+            else if (isa == VCPU_AVX2)   vgemm_axpy_avx2  (c, b, x, n);
+            else                         vgemm_axpy_scalar(c, b, x, n);
+          }
+      }
+  return NULL;
+}
+
+int vgemm_cpu(const int *A, const int *B, int *C, int M, int N, int K, int threads)
+{
+  vector<vgemm_cpu_pk_t> pk;
+  vector<pthread_t>      thread;
+  int i;
+
+  threads = std::max(1, std::min(threads, (M + VGEMM_BLOCK - 1) / VGEMM_BLOCK));
+  pk.resize(threads);
+  thread.resize(threads);
+  for (i = 0; i < threads; i++) {
+    pk[i].A  = A; pk[i].B = B; pk[i].C = C;
+    pk[i].M0 = (int)((int64_t)M * i / threads);
+    pk[i].M1 = (int)((int64_t)M * (i + 1) / threads);
+    pk[i].N  = N; pk[i].K = K;
+  }
+  for (i = 1; i < threads; i++) pthread_create(&thread[i], NULL, vgemm_cpu_Threads_Call, (void*) &pk[i]);
+  vgemm_cpu_Threads_Call(&pk[0]);
+  for (i = 1; i < threads; i++) pthread_join(thread[i], NULL);
+  return 0;
+}
+//==================================================================================================
+//   ___             _
+//  / __|__ _ _ _ __| |
+// | (__/ _` | '_/ _` |
+//  \___\__,_|_| \__,_|
+//==================================================================================================
+// Tile (r, c) of the rows x cols matrix X into T, zero outside of X.
+static void vgemm_pack(const int *X, int rows, int cols, int r, int c, int *T)
+{
+  int i, n = std::min(VGEMM_TILE, cols - c * VGEMM_TILE);
+  for (i = 0; i < VGEMM_TILE; i++) {
+    int row = r * VGEMM_TILE + i;
+    if (row < rows && n > 0) {
+      memcpy(T + i * VGEMM_TILE, X + (int64_t)row * cols + c * VGEMM_TILE, (size_t)n * 4);
+      memset(T + i * VGEMM_TILE + n, 0, (size_t)(VGEMM_TILE - n) * 4);
+    } else {
+      memset(T + i * VGEMM_TILE, 0, VGEMM_TILE * 4);
+    }
+  }
+}
+
+static void vgemm_unpack(const int *T, int *C, int M, int N, int r, int c)
+{
+  int i, n = std::min(VGEMM_TILE, N - c * VGEMM_TILE);
+  for (i = 0; i < VGEMM_TILE && r * VGEMM_TILE + i < M; i++)
+    memcpy(C + (int64_t)(r * VGEMM_TILE + i) * N + c * VGEMM_TILE, T + i * VGEMM_TILE, (size_t)n * 4);
+}
+
+// Ties one output tile on the lane: legs over their share of K, VADD nodes pairwise above them.
+static int vgemm_tie(vgemm_lane_t *L, int t, int *out)
+{
+  vgemm_job_t *J   = L->job;
+  int          i   = t / J->NT, j = t % J->NT;
+  const int   *Ap  = J->Ap + (int64_t)i * J->KT * VGEMM_TT;
+  const int   *Bp  = J->Bp + (int64_t)j * J->KT * VGEMM_TT;
+  vector<int>  q;
+  int          l, h = 0, k = L->legs, err;
+
+  if (L->op == ACCMM)
+    return vtieio(L->VM, L->nPR[0], (int*)Ap, J->KT * VGEMM_TT, (int*)Bp, J->KT * VGEMM_TT, out, J->KT * VGEMM_TT);
+
+  for (l = 0; l < L->legs; l++) q.push_back(l);
+  // consumer of every node, -1 for the host
+  vector<int> cons(2 * L->legs - 1, -1), in1(2 * L->legs - 1), in2(2 * L->legs - 1);
+  while ((int)q.size() - h > 1) {
+    in1[k] = q[h]; in2[k] = q[h + 1];
+    cons[q[h]] = cons[q[h + 1]] = k;
+    h += 2;
+    q.push_back(k++);
+  }
+  for (l = 0; l < L->legs; l++) {
+    int k0 = J->KT * l / L->legs, k1 = J->KT * (l + 1) / L->legs;
+    int sz = (k1 - k0) * VGEMM_TT;
+    if (cons[l] < 0) err = vtieio(L->VM, L->nPR[l], (int*)Ap + k0 * VGEMM_TT, sz, (int*)Bp + k0 * VGEMM_TT, sz, out, VGEMM_TT);
+    else             err = vtieio(L->VM, L->nPR[l], (int*)Ap + k0 * VGEMM_TT, sz, (int*)Bp + k0 * VGEMM_TT, sz, L->nPR[cons[l]], VGEMM_TT);
+    if (err < 0) return err;
+  }
+  for (l = L->legs; l < 2 * L->legs - 1; l++) {
+    if (cons[l] < 0) err = vtieio(L->VM, L->nPR[l], L->nPR[in1[l]], VGEMM_TT, L->nPR[in2[l]], VGEMM_TT, out, VGEMM_TT);
+    else             err = vtieio(L->VM, L->nPR[l], L->nPR[in1[l]], VGEMM_TT, L->nPR[in2[l]], VGEMM_TT, L->nPR[cons[l]], VGEMM_TT);
+    if (err < 0) return err;
+  }
+  return 0;
+}
+
+void * vgemm_lane_Threads_Call(void *pk)
+{
+  vgemm_lane_t *L   = (vgemm_lane_t *) pk;
+  vgemm_job_t  *J   = L->job;
+  int           out = (L->op == ACCMM) ? J->KT * VGEMM_TT : VGEMM_TT;
+  int          *T   = new int[out];
+  int          *S   = new int[VGEMM_TT];
+  int           l, t, k, x, err;
+
+  for (l = 0; l < (int)L->nPR.size(); l++) {
+    err = vlpr(L->VM, L->nPR[l], (l < L->legs) ? L->op : VADD);                                     errCheck(err, FUN_VLPR);
+  }
+  while (1) {
+    pthread_mutex_lock(&J->mutex);
+    t = J->next++;
+    pthread_mutex_unlock(&J->mutex);
+    if (t >= J->tiles) break;
+
+    err = vgemm_tie(L, t, T);                                                                       errCheck(err, FUN_VTIEIO);
+    err = vstart(L->VM, &L->nPR);                                                                   errCheck(err, FUN_VSTART);
+    if (L->op == ACCMM) {   // one product per tile pair, summed here
+      uint32_t *us = (uint32_t *)S;
+      memset(S, 0, VGEMM_TT * 4);
+      for (k = 0; k < J->KT; k++)
+        for (x = 0; x < VGEMM_TT; x++) us[x] += (uint32_t)T[k * VGEMM_TT + x];
+      vgemm_unpack(S, J->C, J->M, J->N, t / J->NT, t % J->NT);
+    } else {
+      vgemm_unpack(T, J->C, J->M, J->N, t / J->NT, t % J->NT);
+    }
+  }
+  delete[] T;
+  delete[] S;
+  return NULL;
+}
+
+// Legs per lane: the fewest rounds of tiles times the share of K of a leg.
+static int vgemm_legs(int tiles, int KT, int nodes, int wide)
+{
+  int    s, best = 1;
+  double cost, low = HUGE_VAL;
+  for (s = 1; s <= VGEMM_MAX_LEGS && s <= KT && 2 * s - 1 <= nodes; s *= 2) {
+    if (s > 1 && !wide) break;
+    int lanes = nodes / (2 * s - 1);
+    cost = (double)((tiles + lanes - 1) / lanes) * ((KT + s - 1) / s);
+    if (cost < low) { low = cost; best = s; }
+  }
+  return best;
+}
+
+static inline double vgemm_us(void)
+{
+  struct timeval t;
+  gettimeofday(&t, NULL);
+  return 1000000.0 * t.tv_sec + t.tv_usec;
+}
+
+int vgemm(vam_vm_t *VM, const int *A, const int *B, int *C, int M, int N, int K, int nodes, vgemm_stat_t *stat)
+{
+  vector<int>   nPR, cards, spare;
+  vgemm_stat_t  st;
+  vgemm_job_t   job;
+  int           op, i, j, c, got = 0;
+  double        t0 = vgemm_us();
+
+  if (M <= 0 || N <= 0 || K <= 0) return -1;
+  memset(&st, 0, sizeof(st));
+
+  op = vhasbit(VM, ACCMMM) ? ACCMMM : vhasbit(VM, ACCMM) ? ACCMM : NOP;
+  if (op != NOP && (int64_t)M * N * K >= VGEMM_MIN)
+    got = vsplit_claim(VM, op, &nPR, nodes);
+
+  if (got == 0) {
+    vgemm_cpu(A, B, C, M, N, K, vcpu_threads());
+  } else {
+    job.MT = (M + VGEMM_TILE - 1) / VGEMM_TILE;
+    job.NT = (N + VGEMM_TILE - 1) / VGEMM_TILE;
+    job.KT = (K + VGEMM_TILE - 1) / VGEMM_TILE;
+    job.tiles = job.MT * job.NT;
+    job.next  = 0;
+    job.C = C; job.M = M; job.N = N;
+    pthread_mutex_init(&job.mutex, NULL);
+
+    int *Ap = new int[(int64_t)job.MT * job.KT * VGEMM_TT];
+    int *Bp = new int[(int64_t)job.NT * job.KT * VGEMM_TT];
+    for (i = 0; i < job.MT; i++)
+      for (j = 0; j < job.KT; j++) vgemm_pack(A, M, K, i, j, Ap + ((int64_t)i * job.KT + j) * VGEMM_TT);
+    for (i = 0; i < job.NT; i++)
+      for (j = 0; j < job.KT; j++) vgemm_pack(B, K, N, j, i, Bp + ((int64_t)i * job.KT + j) * VGEMM_TT);
+    job.Ap = Ap;
+    job.Bp = Bp;
+
+    // lanes inside each card, the VADD trees cannot cross cards
+    for (i = 0; i < got; i++)
+      if (std::find(cards.begin(), cards.end(), VNPR_CARD(nPR[i])) == cards.end()) cards.push_back(VNPR_CARD(nPR[i]));
+    st.legs = (op == ACCMMM) ? vgemm_legs(job.tiles, job.KT, got / (int)cards.size(), vhasbit(VM, VADD)) : 1;
+
+    vector<vgemm_lane_t *> lane;
+    for (c = 0; c < (int)cards.size(); c++) {
+      vector<int> ids;
+      for (i = 0; i < got; i++)
+        if (VNPR_CARD(nPR[i]) == cards[c]) ids.push_back(nPR[i]);
+      for (i = 0; i + 2 * st.legs - 1 <= (int)ids.size() && (int)lane.size() < job.tiles; i += 2 * st.legs - 1) {
+        vgemm_lane_t *L = new vgemm_lane_t;
+        L->VM   = VM;
+        L->job  = &job;
+        L->op   = op;
+        L->legs = st.legs;
+        L->nPR.assign(ids.begin() + i, ids.begin() + i + 2 * st.legs - 1);
+        lane.push_back(L);
+      }
+      spare.insert(spare.end(), ids.begin() + std::min((int)ids.size(), i), ids.end());
+    }
+    if (!spare.empty()) vdel(VM, &spare);
+    #ifdef VERBOSE
+      printf("[DEBUG->vgemm] %dx%dx%d op:%d tiles:%d lanes:%d legs:%d\r\n", M, N, K, op, job.tiles, (int)lane.size(), st.legs);
+    #endif
+
+    vector<pthread_t> thread(lane.size());
+    for (i = 0; i < (int)lane.size(); i++) pthread_create(&thread[i], NULL, vgemm_lane_Threads_Call, (void*) lane[i]);
+    for (i = 0; i < (int)lane.size(); i++) {
+      pthread_join(thread[i], NULL);
+      vdel(VM, &lane[i]->nPR);
+      delete lane[i];
+    }
+    pthread_mutex_destroy(&job.mutex);
+    delete[] Ap;
+    delete[] Bp;
+
+    st.target = VGEMM_FPGA;
+    st.nodes  = got - (int)spare.size();
+    st.lanes  = (int)lane.size();
+    st.tiles  = job.tiles;
+  }
+
+  st.us     = vgemm_us() - t0;
+  st.gflops = 2.0 * M * N * K / std::max(st.us, 1.0) / 1000.0;
+  if (stat != NULL) *stat = st;
+  return 0;
+}
+
+#endif
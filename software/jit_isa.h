@@ -1,7 +1,15 @@
+#ifndef JIT_ISA_H
+#define JIT_ISA_H
+#include "jit_op.h"
+#include "jit_cpu.h"
 #include "jit_bit.h"
 
-#define CARD            1
-#define NUM_ACCs        8
+#ifndef CARD
+#define CARD            1            // cards driven by the host, -DCARD=2 for two
+#endif
+#if NUM_ACCs > 32
+#error "jit.v has 32 ACC slots at most"
+#endif
 #define PR
 
 #define MAX_NUM_MODULES 50
@@ -13,28 +21,16 @@
 
 #define MAX_BUF_SIZE    1024 * 8
 #define MAX_CARD        24
+
+// nPR: {card, node}, node 0 .. NUM_ACCs-1 in the low NODE_BITS
+#define NODE_BITS       8
+#define VNPR(card, node) ((card) << NODE_BITS | (node))
+#define VNPR_CARD(n)    ((n) >> NODE_BITS)
+#define VNPR_NODE(n)    ((n) & ((1 << NODE_BITS) - 1))
+#define VNPR_INDEX(n)   (VNPR_CARD(n) * ROW + VNPR_NODE(n))
 #define PRFREE          0
 #define PRBUSY          1
 
-#define NOP             0
-#define VADD            1
-#define VSUB            2
-#define VREDUCE         3
-#define VMUL            4
-#define VADDREDUCE      5
-#define VSUBREDUCE      6
-#define ACCMM           7
-#define ACCMMM          8
-#define MERGE           9
-#define INSERTION       10
-#define SQLAVG          11
-#define SQLLESS         12
-#define SQLLARGE        13
-#define A2PB2           14
-#define VAPBB           15
-#define VAAPB           16
-#define BB              17
-
 #define SIN1            0
 #define SIN2            1
 #define MOUT            2
@@ -65,10 +61,17 @@
 #define READ_OUT        2
 #define WS              0
 #define RS              1
+
+#define VBURST_HEADER   0xF0000000  // 0xF000nnnn: the next nnnn words of stream 50 are one burst
+#define VBURST_MAX      0xFFFF
+#define VCMD_FILLER     0xDEADBEEF
+#define VPRID_SYNC_US   100000      // wait of vprid_sync for the counter record of one node
+#define VPRID_POLL_US   20
 //==================================================================================================
 typedef struct{
   uint32_t  BitSize[ROW * COL];
   uint32_t *BitAddr[ROW * COL];
+  uint32_t  Pack;        // VPACK_I16 | VPACK_I8 lanes the bitstream also takes, 0: int32 only
 }vam_Bitstream_table_item;
 
 typedef struct{
@@ -99,13 +102,57 @@ typedef struct{
   int        size_out;
 
   int        cur_cmd;    // Current CMD
+  int        arg;        // R3 sent by the next vtieio, SQL constant or VPACK_ lanes
+  int        cast;       // the next vtieio with a host output sends C to the crossbar as well
 }vam_node_t;
 
+struct vcq_t;
+
+// Device buffers of jit_dev.h: the DMA nodes of each card and the card DRAM handed out
+typedef struct {
+  int       owner;      // nPR of the node it was tied for, -1 free
+  int       run;        // started by a vstart of its owner, its record is still to be read
+  uint32_t  tag;        // R4 of its job
+  uint64_t  addr;       // DRAM bytes of its job
+  int       size;       // words
+}vdev_dma_t;
+
 typedef struct {
+  uint64_t  addr;
+  uint64_t  bytes;
+}vdev_block_t;
+
+// A bitstream of one region kept in the card DRAM for the PR reader
+typedef struct {
+  int       PR_NAME;
+  int       node;
+  uint64_t  addr;       // its block
+  int       size;       // words
+  uint64_t  used;       // tick of its last vlpr, the least recent goes first
+  int       busy;       // vlpr reading it
+}vdev_bit_t;
+
+struct vam_vm_t;
+
+typedef struct vdev_pool_t {
+  pthread_mutex_t       mutex;
+  vdev_dma_t            dma[CARD][VDMA_NODES];
+  vector<vdev_block_t> *block[CARD];  // allocated blocks by address
+  vector<uint32_t>     *seen[CARD];   // records of DMA nodes read for another waiter, node + 1 << 16 | tag
+  uint32_t              tag;
+  vector<vdev_bit_t>   *bits[CARD];   // bitstream cache of jit_dev.h
+  uint64_t              tick;
+  pthread_mutex_t       pr_mutex;     // one vlpr at a time, stream 100 and the PR reader share the ICAP
+  int                 (*lpr)(struct vam_vm_t *VM, int nPR, int PR_NAME);  // vlpr from the cache, NULL when off
+}vdev_pool_t;
+
+typedef struct vam_vm_t {
   pthread_mutex_t       vm_mutex;
   PicoDrv               *pico[CARD];
   vector<vam_node_t>    *VAM_TABLE;
   vam_Bitstream_table_t *BITSTREAM_TABLE;
+  struct vcq_t          *CQ;          // completion queue of jit_cq.h, NULL when not open
+  struct vdev_pool_t    *DEV;         // device buffers of jit_dev.h, NULL when not open
 }vam_vm_t;
 
 typedef struct {
@@ -114,6 +161,17 @@ typedef struct {
   int          PR_NAME; // only for lpr
 }vm_pk_t;
 
+// Command words held by vburst_begin on the calling thread, one burst per card at vburst_end
+typedef struct {
+  vam_vm_t          *VM;
+  vector<uint32_t>   cmd[CARD];
+}vam_burst_t;
+
+static __thread vam_burst_t *vam_burst = NULL;
+
+// VM whose vtieio / vsettag commands this thread sends to the shadow sets, from vshadow_begin
+static __thread vam_vm_t    *vam_shadow = NULL;
+
 typedef struct {
   int       type;
   vam_vm_t *VM;
@@ -125,6 +183,8 @@ typedef struct {
 }vstart_pk_t;
 
 //==================================================================================================
+int    vstream_write              (PicoDrv *pico, uint32_t stream, int *buf, int items);
+int    vstream_read               (PicoDrv *pico, uint32_t stream, int *buf, int items);
 void * WriteStream_Threads_Call   (void *pk);
 void * ReadStream_Threads_Call    (void *pk);
 void * Stream_Threads_Call        (void *pk);
@@ -140,9 +200,74 @@ void * vnew_Threads_Call          (void *pk);
 int    vdel                       (vam_vm_t *VM, vector<int> *nPR);
 void * vdel_Threads_Call          (void *pk);
 int    vlpr                       (vam_vm_t *VM, int nPR, int PR_NAME);
+int    vhasbit                    (vam_vm_t *VM, int PR_NAME);
+int    vprid_sync                 (vam_vm_t *VM);
+int    vsetarg                    (vam_vm_t *VM, int nPR, int arg);
+int    vhaspack                   (vam_vm_t *VM, int PR_NAME, int type);
+int    vsettype                   (vam_vm_t *VM, int nPR, int type);
+int    vsetcast                   (vam_vm_t *VM, int nPR);
+int    vwords                     (int type, int n);
+int    vburst_encode              (const uint32_t *words, int n, vector<uint32_t> *pkt);
+int    vburst_begin               (vam_vm_t *VM);
+int    vburst_end                 (vam_vm_t *VM);
+int    vshadow_begin              (vam_vm_t *VM);
+int    vshadow_end                (vam_vm_t *VM);
+int    vcmd_write                 (vam_vm_t *VM, int card, int cmd_stream, uint32_t *cmd);
+int    vdev_started               (vam_vm_t *VM, vector<int> *nPR);
 void * vlpr_Threads_Call          (void *pk);
 int vtieio(vam_vm_t *VM, int nPR, int *in1, int *in2, int *out, int size);
 //==================================================================================================
+// Data stream transfers in whole JIT_BEAT_BYTES beats. The last beat of a size that does not fill it
+// goes through a zeroed temporary one (the firmware drops the padding in front of the accelerator,
+// and pads its results the same way), a buffer not aligned on a beat through an aligned copy. With
+// the 32-bit firmware both are plain WriteStream / ReadStream calls. Returns the bytes of items.
+int vstream_write(PicoDrv *pico, uint32_t stream, int *buf, int items)
+{
+  int   bytes = items * 4, head, rest, err = 0;
+  void *tmp   = NULL;
+
+  if (JIT_BEAT_BYTES == 4 || ((uintptr_t)buf % JIT_BEAT_BYTES == 0 && bytes % JIT_BEAT_BYTES == 0)) {
+    err = pico->WriteStream(stream, buf, bytes);
+    return (err < 0) ? err : bytes;
+  }
+  head = ((uintptr_t)buf % JIT_BEAT_BYTES == 0) ? bytes / JIT_BEAT_BYTES * JIT_BEAT_BYTES : 0;
+  rest = (bytes - head + JIT_BEAT_BYTES - 1) / JIT_BEAT_BYTES * JIT_BEAT_BYTES;
+  #ifdef VERBOSE
+    printf("[DEBUG->vstream_write] %d Bytes to 0x%08x, %d through a padded copy\r\n", bytes, stream, rest);
+  #endif
+  if (head > 0) err = pico->WriteStream(stream, buf, head);
+  if (err < 0) return err;
+  if (posix_memalign(&tmp, JIT_BEAT_BYTES, rest) != 0) return -1;
+  memset(tmp, 0, rest);
+  memcpy(tmp, (char *)buf + head, bytes - head);
+  err = pico->WriteStream(stream, tmp, rest);
+  free(tmp);
+  return (err < 0) ? err : bytes;
+}
+
+int vstream_read(PicoDrv *pico, uint32_t stream, int *buf, int items)
+{
+  int   bytes = items * 4, head, rest, err = 0;
+  void *tmp   = NULL;
+
+  if (JIT_BEAT_BYTES == 4 || ((uintptr_t)buf % JIT_BEAT_BYTES == 0 && bytes % JIT_BEAT_BYTES == 0)) {
+    err = pico->ReadStream(stream, buf, bytes);
+    return (err < 0) ? err : bytes;
+  }
+  head = ((uintptr_t)buf % JIT_BEAT_BYTES == 0) ? bytes / JIT_BEAT_BYTES * JIT_BEAT_BYTES : 0;
+  rest = (bytes - head + JIT_BEAT_BYTES - 1) / JIT_BEAT_BYTES * JIT_BEAT_BYTES;
+  #ifdef VERBOSE
+    printf("[DEBUG->vstream_read] %d Bytes from 0x%08x, %d through a padded copy\r\n", bytes, stream, rest);
+  #endif
+  if (head > 0) err = pico->ReadStream(stream, buf, head);
+  if (err < 0) return err;
+  if (posix_memalign(&tmp, JIT_BEAT_BYTES, rest) != 0) return -1;
+  err = pico->ReadStream(stream, tmp, rest);
+  if (err >= 0) memcpy((char *)buf + head, tmp, bytes - head);
+  free(tmp);
+  return (err < 0) ? err : bytes;
+}
+
 void * WriteStream_Threads_Call(void *pk)
 {
   vstart_pk_t *p = (vstart_pk_t *)pk;
@@ -158,11 +283,12 @@ void * WriteStream_Threads_Call(void *pk)
     printf("[DEBUG->WS_TCALL] Writing %i Bytes to 0x%08x\n", items * 4, stream);
   #endif
 
-  err = p->VM->pico[card]->WriteStream(stream, buf,  items * 4);
+  err = vstream_write(p->VM->pico[card], stream, buf, items);
   if (err < 0) {
     fprintf(stderr, "WriteStream error: %s\n", PicoErrors_FullError(err, ibuf, sizeof(ibuf)));
     return (void *) -1;
   }
+  return NULL;
 }
 
 void * ReadStream_Threads_Call(void *pk)
@@ -180,11 +306,12 @@ void * ReadStream_Threads_Call(void *pk)
     printf("[DEBUG->RS_TCALL] Reading %i Bytes to 0x%08x\n", items * 4, stream);
   #endif
 
-  err = p->VM->pico[card]->ReadStream(stream, buf,  items * 4);
+  err = vstream_read(p->VM->pico[card], stream, buf, items);
   if (err < 0) {
     fprintf(stderr, "ReadingStream error: %s\n", PicoErrors_FullError(err, ibuf, sizeof(ibuf)));
     return (void *) -1;
   }
+  return NULL;
 }
 
 void * Stream_Threads_Call(void *pk)
@@ -207,7 +334,7 @@ void * Stream_Threads_Call(void *pk)
       printf("[DEBUG->WS_TCALL] Writing %i Bytes to 0x%08x\n", items * 4, stream);
     #endif
 
-    err = p->VM->pico[card]->WriteStream(stream, buf,  items * 4);
+    err = vstream_write(p->VM->pico[card], stream, buf, items);
     if (err < 0) {
       fprintf(stderr, "WriteStream error: %s\n", PicoErrors_FullError(err, ibuf, sizeof(ibuf)));
       return (void *) -1;
@@ -221,14 +348,14 @@ void * Stream_Threads_Call(void *pk)
       //     exit(1);
       // }
     #endif
-    err = p->VM->pico[card]->ReadStream(stream, buf,  items * 4);
+    err = vstream_read(p->VM->pico[card], stream, buf, items);
     // err = p->VM->pico[card]->ReadStream(stream, buf,  i);
     if (err < 0) {
       fprintf(stderr, "ReadingStream error: %s\n", PicoErrors_FullError(err, ibuf, sizeof(ibuf)));
       return (void *) -1;
     }
   }
-
+  return NULL;
 }
 
 void errCheck(int err, int fun)
@@ -330,6 +457,7 @@ int VAM_TABLE_INIT(PicoDrv **pico, vector<vam_node_t> *vam_table)
   #endif
 
   int OVERLAY_TOPOlOGY[MAX_CARD][NUM_ACCs][3];
+  // node j on the Pico streams j*10+11 .. j*10+13, 11-13 up to 321-323 (firmware/jit.v)
   for (i = 0; i < CARD; i++) {
     for (j = 0; j < NUM_ACCs; j++) {
       OVERLAY_TOPOlOGY[i][j][SIN1] = j * 10 + 11;
@@ -366,12 +494,15 @@ int VAM_TABLE_INIT(PicoDrv **pico, vector<vam_node_t> *vam_table)
       tmp.tie_out    = 0;
 
       tmp.cur_cmd    = 0x00000000;
+      tmp.arg        = 1;
+      tmp.cast       = 0;
       vam_table->push_back(tmp);
     }
   }
   #ifdef VERBOSE
     printf("[DEBUG->VAM_TABLE_INIT] DONE\r\n");
   #endif
+  return 0;
 }
 
 void VAM_TABLE_CLEAN(vam_vm_t *VM)
@@ -402,8 +533,18 @@ void VAM_TABLE_CLEAN(vam_vm_t *VM)
   #endif
 }
 
+// Row OP of the table from the <NAME>_PR_bit / <NAME>_PR_bit_len arrays of jit_bit.h, one entry per
+// PR region; the regions past the bitstreams built for NAME keep a NULL address and a 0 size.
+#define VAM_BIT_ROW(OP, NAME)                                                                      \
+  for (i = 0; i < ROW * COL && i < (int)(sizeof(NAME##_PR_bit_len) / sizeof(unsigned int)); i++) { \
+    BITSTREAM_TABLE->item[OP].BitAddr[i] = (uint32_t*)NAME##_PR_bit[i];                            \
+    BITSTREAM_TABLE->item[OP].BitSize[i] = (uint32_t) NAME##_PR_bit_len[i];                        \
+  }
+
 void VAM_BITSTREAM_TABLE_INIT(vam_Bitstream_table_t *BITSTREAM_TABLE)
 {
+  int i;
+
   #ifdef VERBOSE
     printf("\r\n");
   #endif
@@ -411,113 +552,55 @@ void VAM_BITSTREAM_TABLE_INIT(vam_Bitstream_table_t *BITSTREAM_TABLE)
   #ifdef VERBOSE
     printf("[DEBUG->VAM_BITSTREAM_TABLE_INIT] INIT\r\n");
   #endif
-     // BITSTREAM_TABLE->item[BB].BitAddr[0]          = (uint32_t*)jit_blackbox_PR1_bit;
-     // BITSTREAM_TABLE->item[BB].BitAddr[1]          = (uint32_t*)jit_blackbox_PR2_bit;
-     // BITSTREAM_TABLE->item[BB].BitAddr[2]          = (uint32_t*)jit_blackbox_PR3_bit;
-     // BITSTREAM_TABLE->item[BB].BitAddr[3]          = (uint32_t*)jit_blackbox_PR4_bit;
-     // BITSTREAM_TABLE->item[BB].BitAddr[4]          = (uint32_t*)jit_blackbox_PR5_bit;
-     // BITSTREAM_TABLE->item[BB].BitAddr[5]          = (uint32_t*)jit_blackbox_PR6_bit;
-     // BITSTREAM_TABLE->item[BB].BitAddr[6]          = (uint32_t*)jit_blackbox_PR7_bit;
-     // BITSTREAM_TABLE->item[BB].BitAddr[7]          = (uint32_t*)jit_blackbox_PR8_bit;
-
-     // BITSTREAM_TABLE->item[BB].BitSize[0]          = (uint32_t) jit_blackbox_PR1_bit_len;
-     // BITSTREAM_TABLE->item[BB].BitSize[1]          = (uint32_t) jit_blackbox_PR2_bit_len;
-     // BITSTREAM_TABLE->item[BB].BitSize[2]          = (uint32_t) jit_blackbox_PR3_bit_len;
-     // BITSTREAM_TABLE->item[BB].BitSize[3]          = (uint32_t) jit_blackbox_PR4_bit_len;
-     // BITSTREAM_TABLE->item[BB].BitSize[4]          = (uint32_t) jit_blackbox_PR5_bit_len;
-     // BITSTREAM_TABLE->item[BB].BitSize[5]          = (uint32_t) jit_blackbox_PR6_bit_len;
-     // BITSTREAM_TABLE->item[BB].BitSize[6]          = (uint32_t) jit_blackbox_PR7_bit_len;
-     // BITSTREAM_TABLE->item[BB].BitSize[7]          = (uint32_t) jit_blackbox_PR8_bit_len;
-////////////////////////////////////////////////////////////////////////////////////////////////////
-     BITSTREAM_TABLE->item[MERGE].BitAddr[0]       = (uint32_t*)MergeUnit_PR1_bit;
-     BITSTREAM_TABLE->item[MERGE].BitAddr[1]       = (uint32_t*)MergeUnit_PR2_bit;
-     BITSTREAM_TABLE->item[MERGE].BitAddr[2]       = (uint32_t*)MergeUnit_PR3_bit;
-     BITSTREAM_TABLE->item[MERGE].BitAddr[3]       = (uint32_t*)MergeUnit_PR4_bit;
-     BITSTREAM_TABLE->item[MERGE].BitAddr[4]       = (uint32_t*)MergeUnit_PR5_bit;
-     BITSTREAM_TABLE->item[MERGE].BitAddr[5]       = (uint32_t*)MergeUnit_PR6_bit;
-     BITSTREAM_TABLE->item[MERGE].BitAddr[6]       = (uint32_t*)MergeUnit_PR7_bit;
-     BITSTREAM_TABLE->item[MERGE].BitAddr[7]       = (uint32_t*)MergeUnit_PR8_bit;
-
-     BITSTREAM_TABLE->item[MERGE].BitSize[0]       = (uint32_t) MergeUnit_PR1_bit_len;
-     BITSTREAM_TABLE->item[MERGE].BitSize[1]       = (uint32_t) MergeUnit_PR2_bit_len;
-     BITSTREAM_TABLE->item[MERGE].BitSize[2]       = (uint32_t) MergeUnit_PR3_bit_len;
-     BITSTREAM_TABLE->item[MERGE].BitSize[3]       = (uint32_t) MergeUnit_PR4_bit_len;
-     BITSTREAM_TABLE->item[MERGE].BitSize[4]       = (uint32_t) MergeUnit_PR5_bit_len;
-     BITSTREAM_TABLE->item[MERGE].BitSize[5]       = (uint32_t) MergeUnit_PR6_bit_len;
-     BITSTREAM_TABLE->item[MERGE].BitSize[6]       = (uint32_t) MergeUnit_PR7_bit_len;
-     BITSTREAM_TABLE->item[MERGE].BitSize[7]       = (uint32_t) MergeUnit_PR8_bit_len;
-////////////////////////////////////////////////////////////////////////////////////////////////////
-     BITSTREAM_TABLE->item[INSERTION].BitAddr[0]   = (uint32_t*)InsertionUnit_PR1_bit;
-     BITSTREAM_TABLE->item[INSERTION].BitAddr[1]   = (uint32_t*)InsertionUnit_PR2_bit;
-     BITSTREAM_TABLE->item[INSERTION].BitAddr[2]   = (uint32_t*)InsertionUnit_PR3_bit;
-     BITSTREAM_TABLE->item[INSERTION].BitAddr[3]   = (uint32_t*)InsertionUnit_PR4_bit;
-     BITSTREAM_TABLE->item[INSERTION].BitAddr[4]   = (uint32_t*)InsertionUnit_PR5_bit;
-     BITSTREAM_TABLE->item[INSERTION].BitAddr[5]   = (uint32_t*)InsertionUnit_PR6_bit;
-     BITSTREAM_TABLE->item[INSERTION].BitAddr[6]   = (uint32_t*)InsertionUnit_PR7_bit;
-     BITSTREAM_TABLE->item[INSERTION].BitAddr[7]   = (uint32_t*)InsertionUnit_PR8_bit;
-
-     BITSTREAM_TABLE->item[INSERTION].BitSize[0]   = (uint32_t) InsertionUnit_PR1_bit_len;
-     BITSTREAM_TABLE->item[INSERTION].BitSize[1]   = (uint32_t) InsertionUnit_PR2_bit_len;
-     BITSTREAM_TABLE->item[INSERTION].BitSize[2]   = (uint32_t) InsertionUnit_PR3_bit_len;
-     BITSTREAM_TABLE->item[INSERTION].BitSize[3]   = (uint32_t) InsertionUnit_PR4_bit_len;
-     BITSTREAM_TABLE->item[INSERTION].BitSize[4]   = (uint32_t) InsertionUnit_PR5_bit_len;
-     BITSTREAM_TABLE->item[INSERTION].BitSize[5]   = (uint32_t) InsertionUnit_PR6_bit_len;
-     BITSTREAM_TABLE->item[INSERTION].BitSize[6]   = (uint32_t) InsertionUnit_PR7_bit_len;
-     BITSTREAM_TABLE->item[INSERTION].BitSize[7]   = (uint32_t) InsertionUnit_PR8_bit_len;
+     // VAM_BIT_ROW(BB,        jit_blackbox);
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-     BITSTREAM_TABLE->item[VADD].BitAddr[0]        = (uint32_t*)acc_vadd_PR1_bit;
-     BITSTREAM_TABLE->item[VADD].BitAddr[1]        = (uint32_t*)acc_vadd_PR2_bit;
-     BITSTREAM_TABLE->item[VADD].BitAddr[2]        = (uint32_t*)acc_vadd_PR3_bit;
-     BITSTREAM_TABLE->item[VADD].BitAddr[3]        = (uint32_t*)acc_vadd_PR4_bit;
-     BITSTREAM_TABLE->item[VADD].BitAddr[4]        = (uint32_t*)acc_vadd_PR5_bit;
-     BITSTREAM_TABLE->item[VADD].BitAddr[5]        = (uint32_t*)acc_vadd_PR6_bit;
-     BITSTREAM_TABLE->item[VADD].BitAddr[6]        = (uint32_t*)acc_vadd_PR7_bit;
-     BITSTREAM_TABLE->item[VADD].BitAddr[7]        = (uint32_t*)acc_vadd_PR8_bit;
-
-     BITSTREAM_TABLE->item[VADD].BitSize[0]        = (uint32_t) acc_vadd_PR1_bit_len;
-     BITSTREAM_TABLE->item[VADD].BitSize[1]        = (uint32_t) acc_vadd_PR2_bit_len;
-     BITSTREAM_TABLE->item[VADD].BitSize[2]        = (uint32_t) acc_vadd_PR3_bit_len;
-     BITSTREAM_TABLE->item[VADD].BitSize[3]        = (uint32_t) acc_vadd_PR4_bit_len;
-     BITSTREAM_TABLE->item[VADD].BitSize[4]        = (uint32_t) acc_vadd_PR5_bit_len;
-     BITSTREAM_TABLE->item[VADD].BitSize[5]        = (uint32_t) acc_vadd_PR6_bit_len;
-     BITSTREAM_TABLE->item[VADD].BitSize[6]        = (uint32_t) acc_vadd_PR7_bit_len;
-     BITSTREAM_TABLE->item[VADD].BitSize[7]        = (uint32_t) acc_vadd_PR8_bit_len;
+     VAM_BIT_ROW(MERGE,     MergeUnit);
+     VAM_BIT_ROW(INSERTION, InsertionUnit);
+     VAM_BIT_ROW(VADD,      acc_vadd);
+     VAM_BIT_ROW(VMUL,      acc_vmul);
+     VAM_BIT_ROW(VREDUCE,   acc_vredu);
   // //////////////////////////////////////////////////////////////////////////////
-     BITSTREAM_TABLE->item[VMUL].BitAddr[0]        = (uint32_t*)acc_vmul_PR1_bit;
-     BITSTREAM_TABLE->item[VMUL].BitAddr[1]        = (uint32_t*)acc_vmul_PR2_bit;
-     BITSTREAM_TABLE->item[VMUL].BitAddr[2]        = (uint32_t*)acc_vmul_PR3_bit;
-     BITSTREAM_TABLE->item[VMUL].BitAddr[3]        = (uint32_t*)acc_vmul_PR4_bit;
-     BITSTREAM_TABLE->item[VMUL].BitAddr[4]        = (uint32_t*)acc_vmul_PR5_bit;
-     BITSTREAM_TABLE->item[VMUL].BitAddr[5]        = (uint32_t*)acc_vmul_PR6_bit;
-     BITSTREAM_TABLE->item[VMUL].BitAddr[6]        = (uint32_t*)acc_vmul_PR7_bit;
-     BITSTREAM_TABLE->item[VMUL].BitAddr[7]        = (uint32_t*)acc_vmul_PR8_bit;
-
-     BITSTREAM_TABLE->item[VMUL].BitSize[0]        = (uint32_t) acc_vmul_PR1_bit_len;
-     BITSTREAM_TABLE->item[VMUL].BitSize[1]        = (uint32_t) acc_vmul_PR2_bit_len;
-     BITSTREAM_TABLE->item[VMUL].BitSize[2]        = (uint32_t) acc_vmul_PR3_bit_len;
-     BITSTREAM_TABLE->item[VMUL].BitSize[3]        = (uint32_t) acc_vmul_PR4_bit_len;
-     BITSTREAM_TABLE->item[VMUL].BitSize[4]        = (uint32_t) acc_vmul_PR5_bit_len;
-     BITSTREAM_TABLE->item[VMUL].BitSize[5]        = (uint32_t) acc_vmul_PR6_bit_len;
-     BITSTREAM_TABLE->item[VMUL].BitSize[6]        = (uint32_t) acc_vmul_PR7_bit_len;
-     BITSTREAM_TABLE->item[VMUL].BitSize[7]        = (uint32_t) acc_vmul_PR8_bit_len;
-  // //////////////////////////////////////////////////////////////////////////////
-  // BITSTREAM_TABLE->item[VREDUCE].BitAddr[0] = (uint32_t*)acc_vredu_PR1_bit;
-  // BITSTREAM_TABLE->item[VREDUCE].BitAddr[1] = (uint32_t*)acc_vredu_PR2_bit;
-  // BITSTREAM_TABLE->item[VREDUCE].BitAddr[2] = (uint32_t*)acc_vredu_PR3_bit;
-  // BITSTREAM_TABLE->item[VREDUCE].BitAddr[3] = (uint32_t*)acc_vredu_PR4_bit;
-  // BITSTREAM_TABLE->item[VREDUCE].BitAddr[4] = (uint32_t*)acc_vredu_PR5_bit;
-  // BITSTREAM_TABLE->item[VREDUCE].BitAddr[5] = (uint32_t*)acc_vredu_PR6_bit;
-  // BITSTREAM_TABLE->item[VREDUCE].BitAddr[6] = (uint32_t*)acc_vredu_PR7_bit;
-  // BITSTREAM_TABLE->item[VREDUCE].BitAddr[7] = (uint32_t*)acc_vredu_PR8_bit;
-
-  // BITSTREAM_TABLE->item[VREDUCE].BitSize[0] = (uint32_t) acc_vredu_PR1_bit_len;
-  // BITSTREAM_TABLE->item[VREDUCE].BitSize[1] = (uint32_t) acc_vredu_PR2_bit_len;
-  // BITSTREAM_TABLE->item[VREDUCE].BitSize[2] = (uint32_t) acc_vredu_PR3_bit_len;
-  // BITSTREAM_TABLE->item[VREDUCE].BitSize[3] = (uint32_t) acc_vredu_PR4_bit_len;
-  // BITSTREAM_TABLE->item[VREDUCE].BitSize[4] = (uint32_t) acc_vredu_PR5_bit_len;
-  // BITSTREAM_TABLE->item[VREDUCE].BitSize[5] = (uint32_t) acc_vredu_PR6_bit_len;
-  // BITSTREAM_TABLE->item[VREDUCE].BitSize[6] = (uint32_t) acc_vredu_PR7_bit_len;
-  // BITSTREAM_TABLE->item[VREDUCE].BitSize[7] = (uint32_t) acc_vredu_PR8_bit_len;
+  #ifdef HAVE_acc_f_avg
+     VAM_BIT_ROW(SQLAVG,    acc_f_avg);
+  #endif
+  #ifdef HAVE_acc_f_less
+     VAM_BIT_ROW(SQLLESS,   acc_f_less);
+  #endif
+  #ifdef HAVE_acc_f_large
+     VAM_BIT_ROW(SQLLARGE,  acc_f_large);
+  #endif
+  #ifdef HAVE_acc_mm
+     VAM_BIT_ROW(ACCMM,     acc_mm);
+  #endif
+  #ifdef HAVE_acc_mmm
+     VAM_BIT_ROW(ACCMMM,    acc_mmm);
+  #endif
+  #ifdef HAVE_acc_a2pb2
+     VAM_BIT_ROW(A2PB2,     acc_a2pb2);
+  #endif
+  #ifdef HAVE_acc_vapbb
+     VAM_BIT_ROW(VAPBB,     acc_vapbb);
+  #endif
+  #ifdef HAVE_acc_vaapb
+     VAM_BIT_ROW(VAAPB,     acc_vaapb);
+  #endif
+  //////////////////////////////////////////////////////////////////////////////
+  // Packed lanes, PACK_<acc> from jit_bit.h
+  #ifdef PACK_acc_vadd
+     BITSTREAM_TABLE->item[VADD].Pack              = PACK_acc_vadd;
+  #endif
+  #ifdef PACK_acc_vmul
+     BITSTREAM_TABLE->item[VMUL].Pack              = PACK_acc_vmul;
+  #endif
+  #ifdef PACK_acc_a2pb2
+     BITSTREAM_TABLE->item[A2PB2].Pack             = PACK_acc_a2pb2;
+  #endif
+  #ifdef PACK_acc_vapbb
+     BITSTREAM_TABLE->item[VAPBB].Pack             = PACK_acc_vapbb;
+  #endif
+  #ifdef PACK_acc_vaapb
+     BITSTREAM_TABLE->item[VAAPB].Pack             = PACK_acc_vaapb;
+  #endif
   //////////////////////////////////////////////////////////////////////////////
 
   #ifdef VERBOSE
@@ -540,8 +623,10 @@ void VAM_VM_INIT(vam_vm_t *VM, int argc, char* argv[])
   #endif
 
   pthread_mutex_init(&VM->vm_mutex, NULL);
+  VM->CQ        = NULL;
+  VM->DEV       = NULL;
   VM->VAM_TABLE = new vector<vam_node_t>;
-  VM->BITSTREAM_TABLE = new vam_Bitstream_table_t;
+  VM->BITSTREAM_TABLE = new vam_Bitstream_table_t();
 
   switch(argc) {
     case 1: {
@@ -578,6 +663,7 @@ void VAM_VM_INIT(vam_vm_t *VM, int argc, char* argv[])
   }
   VAM_BITSTREAM_TABLE_INIT(VM->BITSTREAM_TABLE);
   VAM_TABLE_INIT(VM->pico, VM->VAM_TABLE);
+  vprid_sync(VM);
   #ifdef VERBOSE
     printf("[DEBUG->VAM_VM_INIT] DONE\r\n");
   #endif
@@ -661,7 +747,7 @@ void * vnew_Threads_Call(void *pk)
     vector<vam_node_t>::iterator v = p->VM->VAM_TABLE->begin();
     while( v != p->VM->VAM_TABLE->end()) {
       if(v->status == PRFREE) {
-        p->nPR->at(obtained) = v->card_key << 4 | v->node_key; // 8'h {card_key, node_key} Save the info of both
+        p->nPR->at(obtained) = VNPR(v->card_key, v->node_key); // {card_key, node_key} Save the info of both
         v->status = PRBUSY;
         #ifdef VERBOSE_THREAD
           printf("[DEBUG->vnew_TCALL] vnew thread get id:0x%08x\r\n", p->nPR->at(obtained));
@@ -738,10 +824,12 @@ void * vdel_Threads_Call(void *pk)
   #endif
   size = p->nPR->size();
   for (i = 0; i < size; i++) {
-    card  = p->nPR->at(i) >> 4;
-    node  = p->nPR->at(i) & 0xF;
+    card  = VNPR_CARD(p->nPR->at(i));
+    node  = VNPR_NODE(p->nPR->at(i));
     index = card * ROW + node;
     p->VM->VAM_TABLE->at(index).status     = PRFREE;
+    p->VM->VAM_TABLE->at(index).arg        = 1;
+    p->VM->VAM_TABLE->at(index).cast       = 0;
     p->VM->VAM_TABLE->at(index).in1        = NULL;
     p->VM->VAM_TABLE->at(index).in2        = NULL;
 
@@ -791,6 +879,17 @@ int vlpr(vam_vm_t *VM, int nPR, int PR_NAME)
 
   pthread_t thread;
   vm_pk_t vlpr_package;
+  int     err;
+
+  // a bitstream new to the node from the DRAM cache of jit_dev.h when it is on, 1: not cached. Both
+  // feed the one jit_rle.v of a card, so with jit_dev.h one PR runs at a time
+  if (VM->DEV != NULL) pthread_mutex_lock(&VM->DEV->pr_mutex);
+  if (VM->DEV != NULL && VM->DEV->lpr != NULL && vhasbit(VM, PR_NAME) &&
+      VM->VAM_TABLE->at(VNPR_INDEX(nPR)).PR_key != PR_NAME && (err = VM->DEV->lpr(VM, nPR, PR_NAME)) != 1) {
+    pthread_mutex_unlock(&VM->DEV->pr_mutex);
+    return err;
+  }
+
   // vlpr_package.nPR  = nPR here, is a number
   vlpr_package.VM      = VM;
   vlpr_package.PR_NAME = nPR << 16 | PR_NAME;
@@ -803,9 +902,207 @@ int vlpr(vam_vm_t *VM, int nPR, int PR_NAME)
   #ifdef VERBOSE
     printf("[DEBUG->vlpr] vlpr thread joined\r\n");
   #endif
+  if (VM->DEV != NULL) pthread_mutex_unlock(&VM->DEV->pr_mutex);
   return 0;
 }
 
+// 1 if partial bitstreams are registered for PR_NAME, vlpr of anything else leaves the node as it was
+int vhasbit(vam_vm_t *VM, int PR_NAME)
+{
+  return PR_NAME > 0 && PR_NAME < MAX_NUM_MODULES && VM->BITSTREAM_TABLE->item[PR_NAME].BitSize[0] != 0;
+}
+
+// PR_key of every node from the region ID of its counter record (VPERF_PRID): the regions keep their
+// operators across a restart of the host process, and vlpr of the one a region already holds does
+// not load it again. Records of jobs of an earlier process waiting on stream 50 are dropped.
+// Opt-in with JIT_PRID_SYNC=1: stream 50 is only polled, a firmware without the record leaves every
+// PR_key 0 after VPRID_SYNC_US per card instead of blocking VAM_VM_INIT.
+int vprid_sync(vam_vm_t *VM)
+{
+  uint32_t        cmd[4] = {0, 0xDEADBEEF, 0xDEADBEEF, 0xDEADBEEF};
+  uint32_t        rec[VPERF_WORDS];
+  int             card, node, cmd_stream, id, got, err = 0, ret = 0;
+  double          waited;
+  struct timeval  t0, t1;
+  const char     *env = getenv("JIT_PRID_SYNC");
+
+  if (env == NULL || atoi(env) == 0) return 0;
+  pthread_mutex_lock(&VM->vm_mutex);
+  for (card = 0; card < CARD; card++) {
+    cmd_stream = VM->pico[card]->CreateStream(50);
+    for (node = 0, err = 0; node < ROW && err >= 0; node++) {
+      cmd[0] = 0xE0000000 | VCMD_SLOT(node + 1);
+      err = VM->pico[card]->WriteStream(cmd_stream, cmd, 16);
+      gettimeofday(&t0, NULL);
+      for (got = 0, waited = 0; err >= 0 && got < 2 && waited < VPRID_SYNC_US; ) {
+        if (VM->pico[card]->GetBytesAvailable(cmd_stream, true) >= (got ? VPERF_WORDS - VCQ_WORDS : VCQ_WORDS) * 4) {
+          if (got) {
+            err = VM->pico[card]->ReadStream(cmd_stream, rec + VCQ_WORDS, (VPERF_WORDS - VCQ_WORDS) * 4);
+            got = 2;
+          }
+          else {
+            err = VM->pico[card]->ReadStream(cmd_stream, rec, VCQ_WORDS * 4);
+            got = (err >= 0 && (rec[0] & 0xFF060000) == (0xE0000000 | VCMD_SLOT(node + 1)));
+          }
+        }
+        else usleep(VPRID_POLL_US);
+        gettimeofday(&t1, NULL);
+        waited = 1000000.0 * (t1.tv_sec - t0.tv_sec) + t1.tv_usec - t0.tv_usec;
+      }
+      if (err < 0 || got < 2) {
+        printf("[ERROR->vprid_sync] no counter record of card %d node %d, every region of it reloads\r\n", card, node);
+        err = -1;
+        break;
+      }
+      id = ((rec[VPERF_PRID] & 0xFFFF0000) == VPERF_PRID_TAG) ? (int)(rec[VPERF_PRID] & 0xFFFF) : 0;
+      VM->VAM_TABLE->at(card * ROW + node).PR_key = vhasbit(VM, id) ? id : 0;
+      #ifdef VERBOSE
+        if (id != 0) printf("[DEBUG->vprid_sync] card %d node %d holds PR_NAME %d\r\n", card, node, id);
+      #endif
+    }
+    if (err < 0) {
+      for (node = 0; node < ROW; node++) VM->VAM_TABLE->at(card * ROW + node).PR_key = 0;
+      ret = -1;
+    }
+    VM->pico[card]->CloseStream(cmd_stream);
+  }
+  pthread_mutex_unlock(&VM->vm_mutex);
+  return ret;
+}
+
+// R3 of the next vtieio on nPR (16 bits, the constant of SQLLESS/SQLLARGE), back to 1 at vdel
+int vsetarg(vam_vm_t *VM, int nPR, int arg)
+{
+  int index = VNPR_INDEX(nPR);
+  if (index < 0 || index >= (int)VM->VAM_TABLE->size()) return -1;
+  VM->VAM_TABLE->at(index).arg = arg & 0xFFFF;
+  return 0;
+}
+
+int vhaspack(vam_vm_t *VM, int PR_NAME, int type)
+{
+  if (!vhasbit(VM, PR_NAME)) return 0;
+  return type == VPACK_I32 || ((type == VPACK_I16 || type == VPACK_I8) && (VM->BITSTREAM_TABLE->item[PR_NAME].Pack & type));
+}
+
+// Lanes of the operator loaded on nPR for the next vtieio, whose sizes are then vwords() words
+int vsettype(vam_vm_t *VM, int nPR, int type)
+{
+  int index = VNPR_INDEX(nPR);
+  if (index < 0 || index >= (int)VM->VAM_TABLE->size()) return -1;
+  if (!vhaspack(VM, VM->VAM_TABLE->at(index).PR_key, type)) return -1;
+  VM->VAM_TABLE->at(index).arg = type;
+  return 0;
+}
+
+// The next vtieio of nPR with a host output also sends the result to the crossbar (VOUT_BOTH), where
+// the nodes whose vtieio names nPR as an input read it: one result to the host and to the nodes
+// that need it next, without writing it back in
+int vsetcast(vam_vm_t *VM, int nPR)
+{
+  int index = VNPR_INDEX(nPR);
+  if (index < 0 || index >= (int)VM->VAM_TABLE->size()) return -1;
+  VM->VAM_TABLE->at(index).cast = 1;
+  return 0;
+}
+
+// C field of the 0xB command of a vtieio with a host output, VOUT_BOTH once after vsetcast
+static uint32_t vcast(vam_vm_t *VM, int index)
+{
+  int cast = VM->VAM_TABLE->at(index).cast;
+  VM->VAM_TABLE->at(index).cast = 0;
+  return cast ? VOUT_BOTH : 0;
+}
+
+// Stream words, the unit of the 0xC01/0xC02 sizes, holding n elements of type
+int vwords(int type, int n)
+{
+  return (n + type - 1) / type;
+}
+
+// Command words as 0xF000nnnn bursts, which jit_dispatch.v takes one word per cycle, padded to
+// whole 4-word packets. Returns the number of bursts.
+int vburst_encode(const uint32_t *words, int n, vector<uint32_t> *pkt)
+{
+  int i, k, bursts = 0;
+  pkt->clear();
+  for (i = 0; i < n; i += k, bursts++) {
+    k = std::min(n - i, VBURST_MAX);
+    pkt->push_back(VBURST_HEADER | k);
+    pkt->insert(pkt->end(), words + i, words + i + k);
+  }
+  while (pkt->size() % 4 != 0) pkt->push_back(VCMD_FILLER);
+  return bursts;
+}
+
+// From vburst_begin to vburst_end the vtieio commands of this thread are held, then each card
+// gets them in one stream write. vlpr and vstart are not held: load before, start after.
+int vburst_begin(vam_vm_t *VM)
+{
+  if (vam_burst != NULL) return -1;
+  vam_burst = new vam_burst_t;
+  vam_burst->VM = VM;
+  return 0;
+}
+
+int vburst_end(vam_vm_t *VM)
+{
+  vector<uint32_t> pkt;
+  char             ibuf[1024];
+  int              card, cmd_stream, err = 0;
+
+  if (vam_burst == NULL || vam_burst->VM != VM) return -1;
+  pthread_mutex_lock(&VM->vm_mutex);
+  for (card = 0; card < CARD && err >= 0; card++) {
+    if (vam_burst->cmd[card].empty()) continue;
+    vburst_encode(vam_burst->cmd[card].data(), vam_burst->cmd[card].size(), &pkt);
+    #ifdef VERBOSE
+      printf("[DEBUG->vburst_end] card:%d words:%d packet:%d\r\n", card, (int)vam_burst->cmd[card].size(), (int)pkt.size());
+    #endif
+    cmd_stream = VM->pico[card]->CreateStream(50);
+    err = VM->pico[card]->WriteStream(cmd_stream, pkt.data(), pkt.size() * 4);
+    if (err < 0) fprintf(stderr, "WriteStream error: %s\n", PicoErrors_FullError(err, ibuf, sizeof(ibuf)));
+    VM->pico[card]->CloseStream(cmd_stream);
+  }
+  pthread_mutex_unlock(&VM->vm_mutex);
+  delete vam_burst;
+  vam_burst = NULL;
+  return (err < 0) ? -1 : 0;
+}
+
+// From vshadow_begin to vshadow_end the vtieio / vsettag commands of this thread queue the next job
+// of their nodes: jit_dispatch.v holds them in the shadow set of the node and loads it when the
+// running job is done, at once if the node is idle. One job can be queued per node.
+int vshadow_begin(vam_vm_t *VM)
+{
+  if (vam_shadow != NULL) return -1;
+  vam_shadow = VM;
+  return 0;
+}
+
+int vshadow_end(vam_vm_t *VM)
+{
+  if (vam_shadow != VM) return -1;
+  vam_shadow = NULL;
+  return 0;
+}
+
+// One 4-word command packet of stream 50, held while a burst of this thread is open. Called with
+// vm_mutex held.
+int vcmd_write(vam_vm_t *VM, int card, int cmd_stream, uint32_t *cmd)
+{
+  uint32_t w[4];
+  int      i, op;
+  for (i = 0; i < 4; i++) {
+    op   = cmd[i] >> 28;
+    w[i] = (vam_shadow == VM && (op == 0xB || op == 0xC)) ? cmd[i] | VCMD_SHADOW : cmd[i];
+  }
+  if (vam_burst == NULL || vam_burst->VM != VM) return VM->pico[card]->WriteStream(cmd_stream, w, 16);
+  for (i = 0; i < 4; i++)
+    if (w[i] != VCMD_FILLER) vam_burst->cmd[card].push_back(w[i]);
+  return 16;
+}
+
 void * vlpr_Threads_Call(void *pk)
 {
   #ifdef VERBOSE_THREAD
@@ -814,8 +1111,8 @@ void * vlpr_Threads_Call(void *pk)
   vm_pk_t *p   = (vm_pk_t *) pk;
   int nPR      = p->PR_NAME >> 16;     // Grep nPR, a number
   int PR_NAME  = p->PR_NAME & 0xFFFF;  // Grep PR Type
-  int card     = nPR >> 4;
-  int node     = nPR & 0xF;
+  int card     = VNPR_CARD(nPR);
+  int node     = VNPR_NODE(nPR);
   int index    = card * ROW + node;
   vam_vm_t *VM = p->VM;
 
@@ -845,7 +1142,7 @@ void * vlpr_Threads_Call(void *pk)
   cmd[3] = 0xBABEFACE;
   cmd[2] = 0xDEADBEEF;
   cmd[1] = 0xDEADBEEF;
-  cmd[0] = 0xD000BEEF | (node + 1 << 24); // PR Start CMD
+  cmd[0] = 0xD000BEEF | VCMD_SLOT(node + 1); // PR Start CMD
   #ifdef VERBOSE_THREAD
     printf("[DEBUG->vlpr_TCALL] Opening cmd streams 50\r\n");
     printf("[DEBUG->vlpr_TCALL] Sending Start PR command to JIT, 0x%08x\r\n", cmd[0]);
@@ -866,6 +1163,7 @@ void * vlpr_Threads_Call(void *pk)
       printf("[DEBUG->vlpr_TCALL] Writing %i Bytes to PR%d\n", VM->BITSTREAM_TABLE->item[PR_NAME].BitSize[node] * 4, node);
     #endif
 
+    // the image as pr.c wrote it, run-length compressed: jit_rle.v expands it in front of the ICAP
     #ifdef PR
     err = VM->pico[card]->WriteStream(icap_stream, VM->BITSTREAM_TABLE->item[PR_NAME].BitAddr[node], VM->BITSTREAM_TABLE->item[PR_NAME].BitSize[node] * 4); // Write bytes not words.
     if (err < 0) {
@@ -882,7 +1180,8 @@ void * vlpr_Threads_Call(void *pk)
     VM->pico[card]->CloseStream(icap_stream);
   }
 
-  cmd[0] = 0xD000DEAD | (node + 1 << 24); // PR End CMD
+  cmd[0] = 0xD000DEAD | VCMD_SLOT(node + 1); // PR End CMD
+  cmd[1] = VCMD_PRID  | VCMD_SLOT(node + 1) | (PR_NAME & 0xFFFF); // region ID, PR Start cleared it
   #ifdef VERBOSE_THREAD
     printf("[DEBUG->vlpr_TCALL] Sending End PR command to JIT, 0x%08x\r\n", cmd[0]);
   #endif
@@ -948,12 +1247,12 @@ int vtieio(vam_vm_t *VM, int nPR, int *in1, int size_in1, int *in2, int size_in2
   int       err;
   int       cmd_stream;
 
-  // int       card  = nPR >> 4;
-  // int       node  = nPR & 0xF;
+  // int       card  = VNPR_CARD(nPR);
+  // int       node  = VNPR_NODE(nPR);
   // int       index = card * ROW + node;
 
-  int       nPR_card  = nPR >> 4;
-  int       nPR_node  = nPR & 0xF;
+  int       nPR_card  = VNPR_CARD(nPR);
+  int       nPR_node  = VNPR_NODE(nPR);
   int       nPR_index = nPR_card * ROW + nPR_node;
 
 #ifdef VERBOSE
@@ -974,10 +1273,10 @@ int vtieio(vam_vm_t *VM, int nPR, int *in1, int size_in1, int *in2, int size_in2
   #endif
   cmd_stream = VM->pico[nPR_card]->CreateStream(50);
 
-  cmd[0] = 0xC0100000 | (nPR_node + 1 << 24) | ((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 >> 16)        ;
-  cmd[1] = 0xC0200000 | (nPR_node + 1 << 24) | ((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 & 0x0000FFFF) ;
-  cmd[2] = 0xC0300001 | (nPR_node + 1 << 24)                       ;
-  cmd[3] = 0xB0000000 | (nPR_node + 1 << 24)                       ;
+  cmd[0] = 0xC0100000 | VCMD_SLOT(nPR_node + 1) | (((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1) >> 16)        ;
+  cmd[1] = 0xC0200000 | VCMD_SLOT(nPR_node + 1) | (((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1) & 0x0000FFFF) ;
+  cmd[2] = 0xC0300000 | VCMD_SLOT(nPR_node + 1) | VM->VAM_TABLE->at(nPR_index).arg;
+  cmd[3] = 0xB0000000 | VCMD_SLOT(nPR_node + 1) | vcast(VM, nPR_index)                       ;
 
   VM->VAM_TABLE->at(nPR_index).cur_cmd = cmd[3];
   VM->VAM_TABLE->at(nPR_index).in1     = in1;
@@ -993,7 +1292,7 @@ int vtieio(vam_vm_t *VM, int nPR, int *in1, int size_in1, int *in2, int size_in2
     printf("[DEBUG->vtieio] Sending command : %d, 0x%x, 0x%x\r\n", (size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1, (size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 >> 16, (size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 & 0x0000FFFF);
     printf("[DEBUG->vtieio] Sending command :0x%08x, 0x%08x, 0x%08x, 0x%08x\r\n", cmd[0], cmd[1], cmd[2], cmd[3]);
   #endif
-  err = VM->pico[nPR_card]->WriteStream(cmd_stream, cmd, 16);
+  err = vcmd_write(VM, nPR_card, cmd_stream, cmd);
   if (err < 0) {
     fprintf(stderr, "WriteStream error: %s\n", PicoErrors_FullError(err, ibuf, sizeof(ibuf)));
     return -1;
@@ -1025,12 +1324,12 @@ int vtieio(vam_vm_t *VM, int nPR, int *in1, int size_in1, int *in2, int size_in2
   char      ibuf[1024];
   int       err;
   int       cmd_stream;
-  // int       card  = nPR >> 4;
-  // int       node  = nPR & 0xF;
+  // int       card  = VNPR_CARD(nPR);
+  // int       node  = VNPR_NODE(nPR);
   // int       index = card * ROW + node;
 
-  int       nPR_card  = nPR >> 4;
-  int       nPR_node  = nPR & 0xF;
+  int       nPR_card  = VNPR_CARD(nPR);
+  int       nPR_node  = VNPR_NODE(nPR);
   int       nPR_index = nPR_card * ROW + nPR_node;
 
 #ifdef VERBOSE
@@ -1051,15 +1350,16 @@ int vtieio(vam_vm_t *VM, int nPR, int *in1, int size_in1, int *in2, int size_in2
   #endif
   cmd_stream = VM->pico[nPR_card]->CreateStream(50);
 
-  cmd[0] = 0xC0100000 | (nPR_node + 1 << 24) | ((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 >> 16)        ;
-  cmd[1] = 0xC0200000 | (nPR_node + 1 << 24) | ((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 & 0x0000FFFF) ;
-  cmd[2] = 0xC0300001 | (nPR_node + 1 << 24)                       ;
-  cmd[3] = 0xB0000F00 | (nPR_node + 1 << 24)                       ; // F means the output from crossbar back to crossbar
+  cmd[0] = 0xC0100000 | VCMD_SLOT(nPR_node + 1) | (((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1) >> 16)        ;
+  cmd[1] = 0xC0200000 | VCMD_SLOT(nPR_node + 1) | (((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1) & 0x0000FFFF) ;
+  cmd[2] = 0xC0300000 | VCMD_SLOT(nPR_node + 1) | VM->VAM_TABLE->at(nPR_index).arg;
+  cmd[3] = 0xB0000F00 | VCMD_SLOT(nPR_node + 1)                       ; // F means the output from crossbar back to crossbar
 
   VM->VAM_TABLE->at(nPR_index).cur_cmd = cmd[3];
   VM->VAM_TABLE->at(nPR_index).in1     = in1;
   VM->VAM_TABLE->at(nPR_index).in2     = in2;
   VM->VAM_TABLE->at(nPR_index).tie_out = out;
+  VM->VAM_TABLE->at(nPR_index).out     = NULL;
 
   VM->VAM_TABLE->at(nPR_index).size_in1 = size_in1;
   VM->VAM_TABLE->at(nPR_index).size_in2 = size_in2;
@@ -1070,7 +1370,7 @@ int vtieio(vam_vm_t *VM, int nPR, int *in1, int size_in1, int *in2, int size_in2
     printf("[DEBUG->vtieio] Sending command : %d, 0x%x, 0x%x\r\n", (size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1, (size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 >> 16, (size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 & 0x0000FFFF);
     printf("[DEBUG->vtieio] Sending command :0x%08x, 0x%08x, 0x%08x, 0x%08x\r\n", cmd[0], cmd[1], cmd[2], cmd[3]);
   #endif
-  err = VM->pico[nPR_card]->WriteStream(cmd_stream, cmd, 16);
+  err = vcmd_write(VM, nPR_card, cmd_stream, cmd);
   if (err < 0) {
     fprintf(stderr, "WriteStream error: %s\n", PicoErrors_FullError(err, ibuf, sizeof(ibuf)));
     return -1;
@@ -1102,20 +1402,20 @@ int vtieio(vam_vm_t *VM, int nPR, int in1, int size_in1, int in2, int size_in2,
   char      ibuf[1024];
   int       err;
   int       cmd_stream;
-  // int       card  = nPR >> 4;
-  // int       node  = nPR & 0xF;
+  // int       card  = VNPR_CARD(nPR);
+  // int       node  = VNPR_NODE(nPR);
   // int       index = card * ROW + node;
 
-  int       nPR_card  = nPR >> 4;
-  int       nPR_node  = nPR & 0xF;
+  int       nPR_card  = VNPR_CARD(nPR);
+  int       nPR_node  = VNPR_NODE(nPR);
   int       nPR_index = nPR_card * ROW + nPR_node;
 
-  int       in1_card  = in1 >> 4;
-  int       in1_node  = in1 & 0xF;
+  int       in1_card  = VNPR_CARD(in1);
+  int       in1_node  = VNPR_NODE(in1);
   int       in1_index = in1_card * ROW + in1_node;
 
-  int       in2_card  = in2 >> 4;
-  int       in2_node  = in2 & 0xF;
+  int       in2_card  = VNPR_CARD(in2);
+  int       in2_node  = VNPR_NODE(in2);
   int       in2_index = in2_card * ROW + in2_node;
 
 
@@ -1139,10 +1439,10 @@ int vtieio(vam_vm_t *VM, int nPR, int in1, int size_in1, int in2, int size_in2,
   #endif
   cmd_stream = VM->pico[nPR_card]->CreateStream(50);
   // find first not 0 in size_in1, size_in2 and size_out
-  cmd[0] = 0xC0100000 | (nPR_node + 1 << 24) | ((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 >> 16)                 ;
-  cmd[1] = 0xC0200000 | (nPR_node + 1 << 24) | ((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 & 0x0000FFFF)          ;
-  cmd[2] = 0xC0300001 | (nPR_node + 1 << 24)                                ;
-  cmd[3] = 0xB0000000 | (nPR_node + 1 << 24) | (in2_node + 1 << 4) | (in1_node + 1) ;
+  cmd[0] = 0xC0100000 | VCMD_SLOT(nPR_node + 1) | (((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1) >> 16)                 ;
+  cmd[1] = 0xC0200000 | VCMD_SLOT(nPR_node + 1) | (((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1) & 0x0000FFFF)          ;
+  cmd[2] = 0xC0300000 | VCMD_SLOT(nPR_node + 1) | VM->VAM_TABLE->at(nPR_index).arg;
+  cmd[3] = 0xB0000000 | VCMD_SLOT(nPR_node + 1) | vcast(VM, nPR_index) | VCMD_SRCB(in2_node + 1) | VCMD_SRCA(in1_node + 1) ;
 
   VM->VAM_TABLE->at(nPR_index).cur_cmd = cmd[3];
   VM->VAM_TABLE->at(nPR_index).tie_in1 = in1;
@@ -1158,7 +1458,7 @@ int vtieio(vam_vm_t *VM, int nPR, int in1, int size_in1, int in2, int size_in2,
     printf("[DEBUG->vtieio] Sending command : %d, 0x%x, 0x%x\r\n", (size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1, (size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 >> 16, (size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 & 0x0000FFFF);
     printf("[DEBUG->vtieio] Sending command :0x%08x, 0x%08x, 0x%08x, 0x%08x\r\n", cmd[0], cmd[1], cmd[2], cmd[3]);
   #endif
-  err = VM->pico[nPR_card]->WriteStream(cmd_stream, cmd, 16);
+  err = vcmd_write(VM, nPR_card, cmd_stream, cmd);
   if (err < 0) {
     fprintf(stderr, "WriteStream error: %s\n", PicoErrors_FullError(err, ibuf, sizeof(ibuf)));
     return -1;
@@ -1190,24 +1490,24 @@ int vtieio(vam_vm_t *VM, int nPR, int in1, int size_in1, int in2, int size_in2,
   char      ibuf[1024];
   int       err;
   int       cmd_stream;
-  // int       card  = nPR >> 4;
-  // int       node  = nPR & 0xF;
+  // int       card  = VNPR_CARD(nPR);
+  // int       node  = VNPR_NODE(nPR);
   // int       index = card * ROW + node;
 
-  int       nPR_card  = nPR >> 4;
-  int       nPR_node  = nPR & 0xF;
+  int       nPR_card  = VNPR_CARD(nPR);
+  int       nPR_node  = VNPR_NODE(nPR);
   int       nPR_index = nPR_card * ROW + nPR_node;
 
-  int       in1_card  = in1 >> 4;
-  int       in1_node  = in1 & 0xF;
+  int       in1_card  = VNPR_CARD(in1);
+  int       in1_node  = VNPR_NODE(in1);
   int       in1_index = in1_card * ROW + in1_node;
 
-  int       in2_card  = in2 >> 4;
-  int       in2_node  = in2 & 0xF;
+  int       in2_card  = VNPR_CARD(in2);
+  int       in2_node  = VNPR_NODE(in2);
   int       in2_index = in2_card * ROW + in2_node;
 
-  int       out_card  = out >> 4;
-  int       out_node  = out & 0xF;
+  int       out_card  = VNPR_CARD(out);
+  int       out_node  = VNPR_NODE(out);
   int       out_index = out_card * ROW + out_node;
 
 #ifdef VERBOSE
@@ -1231,15 +1531,16 @@ int vtieio(vam_vm_t *VM, int nPR, int in1, int size_in1, int in2, int size_in2,
   #endif
   cmd_stream = VM->pico[nPR_card]->CreateStream(50);
 
-  cmd[0] = 0xC0100000 | (nPR_node + 1 << 24) | ((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 >> 16)                 ;
-  cmd[1] = 0xC0200000 | (nPR_node + 1 << 24) | ((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 & 0x0000FFFF)          ;
-  cmd[2] = 0xC0300001 | (nPR_node + 1 << 24)                                ;
-  cmd[3] = 0xB0000F00 | (nPR_node + 1 << 24) | (in2_node + 1 << 4) | (in1_node + 1) ;
+  cmd[0] = 0xC0100000 | VCMD_SLOT(nPR_node + 1) | (((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1) >> 16)                 ;
+  cmd[1] = 0xC0200000 | VCMD_SLOT(nPR_node + 1) | (((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1) & 0x0000FFFF)          ;
+  cmd[2] = 0xC0300000 | VCMD_SLOT(nPR_node + 1) | VM->VAM_TABLE->at(nPR_index).arg;
+  cmd[3] = 0xB0000F00 | VCMD_SLOT(nPR_node + 1) | VCMD_SRCB(in2_node + 1) | VCMD_SRCA(in1_node + 1) ;
 
   VM->VAM_TABLE->at(nPR_index).cur_cmd = cmd[3];
   VM->VAM_TABLE->at(nPR_index).tie_in1 = in1;
   VM->VAM_TABLE->at(nPR_index).tie_in2 = in2;
   VM->VAM_TABLE->at(nPR_index).tie_out = out;
+  VM->VAM_TABLE->at(nPR_index).out     = NULL;
 
   VM->VAM_TABLE->at(nPR_index).size_in1 = size_in1;
   VM->VAM_TABLE->at(nPR_index).size_in2 = size_in2;
@@ -1250,7 +1551,7 @@ int vtieio(vam_vm_t *VM, int nPR, int in1, int size_in1, int in2, int size_in2,
     printf("[DEBUG->vtieio] Sending command : %d, 0x%x, 0x%x\r\n", (size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1, (size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 >> 16, (size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 & 0x0000FFFF);
     printf("[DEBUG->vtieio] Sending command :0x%08x, 0x%08x, 0x%08x, 0x%08x\r\n", cmd[0], cmd[1], cmd[2], cmd[3]);
   #endif
-  err = VM->pico[nPR_card]->WriteStream(cmd_stream, cmd, 16);
+  err = vcmd_write(VM, nPR_card, cmd_stream, cmd);
   if (err < 0) {
     fprintf(stderr, "WriteStream error: %s\n", PicoErrors_FullError(err, ibuf, sizeof(ibuf)));
     return -1;
@@ -1283,20 +1584,20 @@ int vtieio(vam_vm_t *VM, int nPR, int *in1, int size_in1, int in2, int size_in2,
   int       err;
   int       cmd_stream;
 
-  int       nPR_card  = nPR >> 4;
-  int       nPR_node  = nPR & 0xF;
+  int       nPR_card  = VNPR_CARD(nPR);
+  int       nPR_node  = VNPR_NODE(nPR);
   int       nPR_index = nPR_card * ROW + nPR_node;
 
-  // int       in1_card  = in1 >> 4;
-  // int       in1_node  = in1 & 0xF;
+  // int       in1_card  = VNPR_CARD(in1);
+  // int       in1_node  = VNPR_NODE(in1);
   // int       in1_index = in1_card * ROW + in1_node;
 
-  int       in2_card  = in2 >> 4;
-  int       in2_node  = in2 & 0xF;
+  int       in2_card  = VNPR_CARD(in2);
+  int       in2_node  = VNPR_NODE(in2);
   int       in2_index = in2_card * ROW + in2_node;
 
-  // int       out_card  = out >> 4;
-  // int       out_node  = out & 0xF;
+  // int       out_card  = VNPR_CARD(out);
+  // int       out_node  = VNPR_NODE(out);
   // int       out_index = out_card * ROW + out_node;
 
 #ifdef VERBOSE
@@ -1320,10 +1621,10 @@ int vtieio(vam_vm_t *VM, int nPR, int *in1, int size_in1, int in2, int size_in2,
   #endif
   cmd_stream = VM->pico[nPR_card]->CreateStream(50);
 
-  cmd[0] = 0xC0100000 | (nPR_node + 1 << 24) | ((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 >> 16)                 ;
-  cmd[1] = 0xC0200000 | (nPR_node + 1 << 24) | ((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 & 0x0000FFFF)          ;
-  cmd[2] = 0xC0300001 | (nPR_node + 1 << 24)                                ;
-  cmd[3] = 0xB0000000 | (nPR_node + 1 << 24) | (in2_node + 1 << 4)          ;
+  cmd[0] = 0xC0100000 | VCMD_SLOT(nPR_node + 1) | (((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1) >> 16)                 ;
+  cmd[1] = 0xC0200000 | VCMD_SLOT(nPR_node + 1) | (((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1) & 0x0000FFFF)          ;
+  cmd[2] = 0xC0300000 | VCMD_SLOT(nPR_node + 1) | VM->VAM_TABLE->at(nPR_index).arg;
+  cmd[3] = 0xB0000000 | VCMD_SLOT(nPR_node + 1) | vcast(VM, nPR_index) | VCMD_SRCB(in2_node + 1)          ;
 
   VM->VAM_TABLE->at(nPR_index).cur_cmd = cmd[3];
   VM->VAM_TABLE->at(nPR_index).in1     = in1;
@@ -1339,7 +1640,7 @@ int vtieio(vam_vm_t *VM, int nPR, int *in1, int size_in1, int in2, int size_in2,
     printf("[DEBUG->vtieio] Sending command : %d, 0x%x, 0x%x\r\n", (size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1, (size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 >> 16, (size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 & 0x0000FFFF);
     printf("[DEBUG->vtieio] Sending command :0x%08x, 0x%08x, 0x%08x, 0x%08x\r\n", cmd[0], cmd[1], cmd[2], cmd[3]);
   #endif
-  err = VM->pico[nPR_card]->WriteStream(cmd_stream, cmd, 16);
+  err = vcmd_write(VM, nPR_card, cmd_stream, cmd);
   if (err < 0) {
     fprintf(stderr, "WriteStream error: %s\n", PicoErrors_FullError(err, ibuf, sizeof(ibuf)));
     return -1;
@@ -1372,20 +1673,20 @@ int vtieio(vam_vm_t *VM, int nPR, int in1, int size_in1, int *in2, int size_in2,
   int       err;
   int       cmd_stream;
 
-  int       nPR_card  = nPR >> 4;
-  int       nPR_node  = nPR & 0xF;
+  int       nPR_card  = VNPR_CARD(nPR);
+  int       nPR_node  = VNPR_NODE(nPR);
   int       nPR_index = nPR_card * ROW + nPR_node;
 
-  int       in1_card  = in1 >> 4;
-  int       in1_node  = in1 & 0xF;
+  int       in1_card  = VNPR_CARD(in1);
+  int       in1_node  = VNPR_NODE(in1);
   int       in1_index = in1_card * ROW + in1_node;
 
-  // int       in2_card  = in2 >> 4;
-  // int       in2_node  = in2 & 0xF;
+  // int       in2_card  = VNPR_CARD(in2);
+  // int       in2_node  = VNPR_NODE(in2);
   // int       in2_index = in2_card * ROW + in2_node;
 
-  // int       out_card  = out >> 4;
-  // int       out_node  = out & 0xF;
+  // int       out_card  = VNPR_CARD(out);
+  // int       out_node  = VNPR_NODE(out);
   // int       out_index = out_card * ROW + out_node;
 
 #ifdef VERBOSE
@@ -1409,10 +1710,10 @@ int vtieio(vam_vm_t *VM, int nPR, int in1, int size_in1, int *in2, int size_in2,
   #endif
   cmd_stream = VM->pico[nPR_card]->CreateStream(50);
 
-  cmd[0] = 0xC0100000 | (nPR_node + 1 << 24) | ((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 >> 16)                 ;
-  cmd[1] = 0xC0200000 | (nPR_node + 1 << 24) | ((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 & 0x0000FFFF)          ;
-  cmd[2] = 0xC0300001 | (nPR_node + 1 << 24)                                ;
-  cmd[3] = 0xB0000000 | (nPR_node + 1 << 24) | (in1_node + 1)               ;
+  cmd[0] = 0xC0100000 | VCMD_SLOT(nPR_node + 1) | (((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1) >> 16)                 ;
+  cmd[1] = 0xC0200000 | VCMD_SLOT(nPR_node + 1) | (((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1) & 0x0000FFFF)          ;
+  cmd[2] = 0xC0300000 | VCMD_SLOT(nPR_node + 1) | VM->VAM_TABLE->at(nPR_index).arg;
+  cmd[3] = 0xB0000000 | VCMD_SLOT(nPR_node + 1) | vcast(VM, nPR_index) | VCMD_SRCA(in1_node + 1)               ;
 
   VM->VAM_TABLE->at(nPR_index).cur_cmd = cmd[3];
   VM->VAM_TABLE->at(nPR_index).tie_in1 = in1;
@@ -1428,7 +1729,7 @@ int vtieio(vam_vm_t *VM, int nPR, int in1, int size_in1, int *in2, int size_in2,
     printf("[DEBUG->vtieio] Sending command : %d, 0x%x, 0x%x\r\n", (size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1, (size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 >> 16, (size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 & 0x0000FFFF);
     printf("[DEBUG->vtieio] Sending command :0x%08x, 0x%08x, 0x%08x, 0x%08x\r\n", cmd[0], cmd[1], cmd[2], cmd[3]);
   #endif
-  err = VM->pico[nPR_card]->WriteStream(cmd_stream, cmd, 16);
+  err = vcmd_write(VM, nPR_card, cmd_stream, cmd);
   if (err < 0) {
     fprintf(stderr, "WriteStream error: %s\n", PicoErrors_FullError(err, ibuf, sizeof(ibuf)));
     return -1;
@@ -1461,20 +1762,20 @@ int vtieio(vam_vm_t *VM, int nPR, int *in1, int size_in1, int in2, int size_in2,
   int       err;
   int       cmd_stream;
 
-  int       nPR_card  = nPR >> 4;
-  int       nPR_node  = nPR & 0xF;
+  int       nPR_card  = VNPR_CARD(nPR);
+  int       nPR_node  = VNPR_NODE(nPR);
   int       nPR_index = nPR_card * ROW + nPR_node;
 
-  // int       in1_card  = in1 >> 4;
-  // int       in1_node  = in1 & 0xF;
+  // int       in1_card  = VNPR_CARD(in1);
+  // int       in1_node  = VNPR_NODE(in1);
   // int       in1_index = in1_card * ROW + in1_node;
 
-  int       in2_card  = in2 >> 4;
-  int       in2_node  = in2 & 0xF;
+  int       in2_card  = VNPR_CARD(in2);
+  int       in2_node  = VNPR_NODE(in2);
   int       in2_index = in2_card * ROW + in2_node;
 
-  int       out_card  = out >> 4;
-  int       out_node  = out & 0xF;
+  int       out_card  = VNPR_CARD(out);
+  int       out_node  = VNPR_NODE(out);
   int       out_index = out_card * ROW + out_node;
 
 #ifdef VERBOSE
@@ -1498,15 +1799,16 @@ int vtieio(vam_vm_t *VM, int nPR, int *in1, int size_in1, int in2, int size_in2,
   #endif
   cmd_stream = VM->pico[nPR_card]->CreateStream(50);
 
-  cmd[0] = 0xC0100000 | (nPR_node + 1 << 24) | ((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 >> 16)                 ;
-  cmd[1] = 0xC0200000 | (nPR_node + 1 << 24) | ((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 & 0x0000FFFF)          ;
-  cmd[2] = 0xC0300001 | (nPR_node + 1 << 24)                                ;
-  cmd[3] = 0xB0000F00 | (nPR_node + 1 << 24) | (in2_node + 1 << 4)          ;
+  cmd[0] = 0xC0100000 | VCMD_SLOT(nPR_node + 1) | (((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1) >> 16)                 ;
+  cmd[1] = 0xC0200000 | VCMD_SLOT(nPR_node + 1) | (((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1) & 0x0000FFFF)          ;
+  cmd[2] = 0xC0300000 | VCMD_SLOT(nPR_node + 1) | VM->VAM_TABLE->at(nPR_index).arg;
+  cmd[3] = 0xB0000F00 | VCMD_SLOT(nPR_node + 1) | VCMD_SRCB(in2_node + 1)          ;
 
   VM->VAM_TABLE->at(nPR_index).cur_cmd = cmd[3];
   VM->VAM_TABLE->at(nPR_index).in1     = in1;
   VM->VAM_TABLE->at(nPR_index).tie_in2 = in2;
   VM->VAM_TABLE->at(nPR_index).tie_out = out;
+  VM->VAM_TABLE->at(nPR_index).out     = NULL;
 
   VM->VAM_TABLE->at(nPR_index).size_in1 = size_in1;
   VM->VAM_TABLE->at(nPR_index).size_in2 = size_in2;
@@ -1517,7 +1819,7 @@ int vtieio(vam_vm_t *VM, int nPR, int *in1, int size_in1, int in2, int size_in2,
     printf("[DEBUG->vtieio] Sending command : %d, 0x%x, 0x%x\r\n", (size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1, (size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 >> 16, (size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 & 0x0000FFFF);
     printf("[DEBUG->vtieio] Sending command :0x%08x, 0x%08x, 0x%08x, 0x%08x\r\n", cmd[0], cmd[1], cmd[2], cmd[3]);
   #endif
-  err = VM->pico[nPR_card]->WriteStream(cmd_stream, cmd, 16);
+  err = vcmd_write(VM, nPR_card, cmd_stream, cmd);
   if (err < 0) {
     fprintf(stderr, "WriteStream error: %s\n", PicoErrors_FullError(err, ibuf, sizeof(ibuf)));
     return -1;
@@ -1550,20 +1852,20 @@ int vtieio(vam_vm_t *VM, int nPR, int in1, int size_in1, int *in2, int size_in2,
   int       err;
   int       cmd_stream;
 
-  int       nPR_card  = nPR >> 4;
-  int       nPR_node  = nPR & 0xF;
+  int       nPR_card  = VNPR_CARD(nPR);
+  int       nPR_node  = VNPR_NODE(nPR);
   int       nPR_index = nPR_card * ROW + nPR_node;
 
-  int       in1_card  = in1 >> 4;
-  int       in1_node  = in1 & 0xF;
+  int       in1_card  = VNPR_CARD(in1);
+  int       in1_node  = VNPR_NODE(in1);
   int       in1_index = in1_card * ROW + in1_node;
 
-  // int       in2_card  = in2 >> 4;
-  // int       in2_node  = in2 & 0xF;
+  // int       in2_card  = VNPR_CARD(in2);
+  // int       in2_node  = VNPR_NODE(in2);
   // int       in2_index = in2_card * ROW + in2_node;
 
-  int       out_card  = out >> 4;
-  int       out_node  = out & 0xF;
+  int       out_card  = VNPR_CARD(out);
+  int       out_node  = VNPR_NODE(out);
   int       out_index = out_card * ROW + out_node;
 
 #ifdef VERBOSE
@@ -1587,15 +1889,16 @@ int vtieio(vam_vm_t *VM, int nPR, int in1, int size_in1, int *in2, int size_in2,
   #endif
   cmd_stream = VM->pico[nPR_card]->CreateStream(50);
 
-  cmd[0] = 0xC0100000 | (nPR_node + 1 << 24) | ((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 >> 16)                 ;
-  cmd[1] = 0xC0200000 | (nPR_node + 1 << 24) | ((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 & 0x0000FFFF)          ;
-  cmd[2] = 0xC0300001 | (nPR_node + 1 << 24)                                ;
-  cmd[3] = 0xB0000F00 | (nPR_node + 1 << 24) | (in1_node + 1)               ;
+  cmd[0] = 0xC0100000 | VCMD_SLOT(nPR_node + 1) | (((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1) >> 16)                 ;
+  cmd[1] = 0xC0200000 | VCMD_SLOT(nPR_node + 1) | (((size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1) & 0x0000FFFF)          ;
+  cmd[2] = 0xC0300000 | VCMD_SLOT(nPR_node + 1) | VM->VAM_TABLE->at(nPR_index).arg;
+  cmd[3] = 0xB0000F00 | VCMD_SLOT(nPR_node + 1) | VCMD_SRCA(in1_node + 1)               ;
 
   VM->VAM_TABLE->at(nPR_index).cur_cmd = cmd[3];
   VM->VAM_TABLE->at(nPR_index).tie_in1 = in1;
   VM->VAM_TABLE->at(nPR_index).in2     = in2;
   VM->VAM_TABLE->at(nPR_index).tie_out = out;
+  VM->VAM_TABLE->at(nPR_index).out     = NULL;
 
   VM->VAM_TABLE->at(nPR_index).size_in1 = size_in1;
   VM->VAM_TABLE->at(nPR_index).size_in2 = size_in2;
@@ -1606,7 +1909,7 @@ int vtieio(vam_vm_t *VM, int nPR, int in1, int size_in1, int *in2, int size_in2,
     printf("[DEBUG->vtieio] Sending command : %d, 0x%x, 0x%x\r\n", (size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1, (size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 >> 16, (size_in1 == 0) ? ( (size_in2 == 0) ? size_out : size_in2 ) : size_in1 & 0x0000FFFF);
     printf("[DEBUG->vtieio] Sending command :0x%08x, 0x%08x, 0x%08x, 0x%08x\r\n", cmd[0], cmd[1], cmd[2], cmd[3]);
   #endif
-  err = VM->pico[nPR_card]->WriteStream(cmd_stream, cmd, 16);
+  err = vcmd_write(VM, nPR_card, cmd_stream, cmd);
   if (err < 0) {
     fprintf(stderr, "WriteStream error: %s\n", PicoErrors_FullError(err, ibuf, sizeof(ibuf)));
     return -1;
@@ -1629,6 +1932,42 @@ int vtieio(vam_vm_t *VM, int nPR, int in1, int size_in1, int *in2, int size_in2,
 //     \    / .----)   |      |  |     /  _____  \  |  |\  \----.   |  |
 //      \__/  |_______/       |__|    /__/     \__\ | _| `._____|   |__|
 //==================================================================================================
+// The DMA nodes of jit_dev.h tied for these nodes run with them: the next user of such a node, or
+// of the DRAM it touches, waits for its completion record. A reader gets its 0xB here, once every
+// node reading it in this job is tied, so that none of them misses the first words.
+int vdev_started(vam_vm_t *VM, vector<int> *nPR)
+{
+  int      i, c, k, cmd_stream, err = 0;
+  int      go[CARD][VDMA_RDS];
+  uint32_t cmd[4] = {0, 0xDEADBEEF, 0xDEADBEEF, 0xDEADBEEF};
+  pthread_mutex_lock(&VM->DEV->mutex);
+  for (c = 0; c < CARD; c++)
+    for (k = 0; k < VDMA_NODES; k++) {
+      if (k < VDMA_RDS) go[c][k] = 0;
+      for (i = 0; i < (int)nPR->size(); i++)
+        if (VM->DEV->dma[c][k].owner == nPR->at(i) && !VM->DEV->dma[c][k].run) {
+          VM->DEV->dma[c][k].run = 1;
+          if (k < VDMA_RDS) go[c][k] = 1;
+        }
+    }
+  pthread_mutex_unlock(&VM->DEV->mutex);
+
+  for (c = 0; c < CARD; c++)
+    for (k = 0; k < VDMA_RDS; k++) {
+      if (!go[c][k]) continue;
+      #ifdef VERBOSE
+        printf("[DEBUG->vdev_started] card %d DMA reader node %d started\r\n", c, NUM_ACCs + k);
+      #endif
+      pthread_mutex_lock(&VM->vm_mutex);
+      cmd_stream = VM->pico[c]->CreateStream(50);
+      cmd[0] = 0xB0000000 | VOUT_XBAR | VCMD_SLOT(NUM_ACCs + k + 1);
+      if (vcmd_write(VM, c, cmd_stream, cmd) < 0) err = -1;
+      VM->pico[c]->CloseStream(cmd_stream);
+      pthread_mutex_unlock(&VM->vm_mutex);
+    }
+  return err;
+}
+
 int vstart(vam_vm_t *VM, vector<int> *nPR)//, int size_in1, int size_in2, int size_out)
 {
 #ifdef VERBOSE
@@ -1653,6 +1992,8 @@ int vstart(vam_vm_t *VM, vector<int> *nPR)//, int size_in1, int size_in2, int si
   int         **threadsRet = NULL;
   vstart_pk_t **package    = NULL;
 
+  if (VM->DEV != NULL && vdev_started(VM, nPR) < 0) return -1;
+
   size = nPR->size();
   threads = new pthread_t* [size];    // size nodes
   for (i = 0; i < size; i++) {
@@ -1670,8 +2011,8 @@ int vstart(vam_vm_t *VM, vector<int> *nPR)//, int size_in1, int size_in2, int si
   }
 
   for (i = size -1; i > -1; i--) {
-    card  = nPR->at(i) >> 4;
-    node  = nPR->at(i) & 0xF;
+    card  = VNPR_CARD(nPR->at(i));
+    node  = VNPR_NODE(nPR->at(i));
     index = card * ROW + node;
 
 
@@ -1685,7 +2026,7 @@ int vstart(vam_vm_t *VM, vector<int> *nPR)//, int size_in1, int size_in2, int si
     //   printf("[DEBUG->vstart_TCALL] vstart thread get mutex...\r\n");
     // #endif
     // cmd_stream = VM->pico[card]->CreateStream(50);
-    // cmd[0] = 0xA0000000 | (node + 1 << 24) ; // Go Command to Acc
+    // cmd[0] = 0xA0000000 | VCMD_SLOT(node + 1) ; // Go Command to Acc
     // err = VM->pico[card]->WriteStream(cmd_stream, cmd, 16);
     // if (err < 0) {
     //   fprintf(stderr, "WriteStream error: %s\n", PicoErrors_FullError(err, ibuf, sizeof(ibuf)));
@@ -2091,8 +2432,8 @@ int vstart(vam_vm_t *VM, vector<int> *nPR)//, int size_in1, int size_in2, int si
   }
 
   for (i = 0; i < size; i++) {
-    card  = nPR->at(i) >> 4;
-    node  = nPR->at(i) & 0xF;
+    card  = VNPR_CARD(nPR->at(i));
+    node  = VNPR_NODE(nPR->at(i));
     index = card * ROW + node;
     switch (VM->VAM_TABLE->at(index).node_type) {
       //------------------------------------------------------------------------
@@ -2363,8 +2704,8 @@ int vend(vam_vm_t *VM, vector<int> *nPR, int size_out)
 
   size = nPR->size();
   for (i = 0; i < size; i++) {
-    card  = nPR->at(i) >> 4;
-    node  = nPR->at(i) & 0xF;
+    card  = VNPR_CARD(nPR->at(i));
+    node  = VNPR_NODE(nPR->at(i));
     index = card * ROW + node;
 
     switch (VM->VAM_TABLE->at(index).node_type) {
@@ -2450,8 +2791,8 @@ int vend(vam_vm_t *VM, vector<int> *nPR, int size_out)
 
 //   size = nPR->size();
 //   for (i = 0; i < size; i++) {
-//     card  = nPR->at(i) >> 4;
-//     node  = nPR->at(i) & 0xF;
+//     card  = VNPR_CARD(nPR->at(i));
+//     node  = VNPR_NODE(nPR->at(i));
 //     index = card * ROW + node;
 
 //     #ifdef VERBOSE
@@ -2567,3 +2908,4 @@ int vend(vam_vm_t *VM, vector<int> *nPR, int size_out)
   // BITSTREAM_TABLE->item[SQLAVG].BitSize[3] = (uint32_t) acc_f_avg_PR3_bit_len;
   // BITSTREAM_TABLE->item[SQLAVG].BitSize[4] = (uint32_t) acc_f_avg_PR4_bit_len;
 
+#endif
@@ -0,0 +1,114 @@
+#ifndef JIT_OP_H
+#define JIT_OP_H
+//==================================================================================================
+// Operator IDs, shared by jit_isa.h, the bitstream table and the emulated card in emu/.
+//==================================================================================================
+#define NOP             0
+#define VADD            1
+#define VSUB            2
+#define VREDUCE         3
+#define VMUL            4
+#define VADDREDUCE      5
+#define VSUBREDUCE      6
+#define ACCMM           7
+#define ACCMMM          8
+#define MERGE           9
+#define INSERTION       10
+#define SQLAVG          11
+#define SQLLESS         12
+#define SQLLARGE        13
+#define A2PB2           14
+#define VAPBB           15
+#define VAAPB           16
+#define BB              17
+
+// Packed element types of the streams, as lanes per 32-bit word. R3 of the element-wise operators
+// carries the lane count, 1 (the reset value of vdel) is plain int32.
+#define VPACK_I32       1
+#define VPACK_I16       2            // 2 x int16, element 2i in the low half of word i
+#define VPACK_I8        4            // 4 x int8,  element 4i in the low byte of word i
+
+// ACC slots per card (jit.v parameter NUM_ACCs), up to 32
+#ifndef NUM_ACCs
+#define NUM_ACCs        8
+#endif
+
+// DMA nodes of a card (firmware/jit_dma.v), after its NUM_ACCs slots: VDMA_RDS readers, crossbar
+// sources streaming card DRAM, then VDMA_WRS writers, storing their crossbar A input. R1/R2 hold
+// the words, R5/R6 the byte address, R4 the tag; bit 16 (VCMD_SHADOW) is not supported. R3 is the
+// weight of the node on the AXI master, the bursts it may issue in a row while others wait.
+#define VDMA_RDS        2
+#define VDMA_WRS        2
+#define VDMA_NODES      (VDMA_RDS + VDMA_WRS)
+#define VDMA_RD(k)      (NUM_ACCs + (k))              // node of reader k, node + 1 on stream 50
+#define VDMA_WR(k)      (NUM_ACCs + VDMA_RDS + (k))
+#define VDMA_PRIO_MAX   15
+
+// PR reader of a card (u_pcache of jit.v), after the DMA nodes: a jit_dma reader which streams the
+// R1/R2 words at DRAM byte address R5/R6 to the ICAP on its 0xB, then sends its record (R4 tag).
+#define VPR_NODE        (NUM_ACCs + VDMA_NODES)       // node, node + 1 on stream 50
+
+// Width of the data streams of the firmware (jit.v parameter DW), 128 with m505lx325w128.fwproj.
+// Every transfer on them is a whole number of beats; jit_isa.h pads and aligns the host buffers.
+#ifndef JIT_DW
+#define JIT_DW          32
+#endif
+#define JIT_BEAT_WORDS  (JIT_DW / 32)
+#define JIT_BEAT_BYTES  (JIT_DW / 8)
+
+// Performance counters of a node (firmware/jit_perf.v), in the order of the 16-word record that
+// 0xEn00000x on stream 50 returns after its 0xEn00000D header. Cycles of the 100 MHz slot clock.
+#define VPERF_CYCLES    0
+#define VPERF_ACTIVE    1            // a word crossed A, B or C
+#define VPERF_STALLA    2            // waiting on input A
+#define VPERF_STALLB    3
+#define VPERF_BLOCKC    4            // output C held by backpressure
+#define VPERF_WORDSA    5
+#define VPERF_WORDSB    6
+#define VPERF_WORDSC    7
+#define VPERF_XBARIN    8            // words of A and B that came through the crossbar
+#define VPERF_XBAROUT   9            // words of C that went to the crossbar
+#define VPERF_HWA       10           // high-water marks of the A, B, C fifos, in beats
+#define VPERF_HWB       11
+#define VPERF_HWC       12
+#define VPERF_COUNTERS  13
+#define VPERF_WORDS     16
+
+// Word 14 of the record: 0x1D00kkkk, operator k of the PR region as written with 0xEn10kkkk after
+// a load, 0 from the start of a PR or a static bitstream load on. VAM_VM_INIT reads it into PR_key.
+#define VPERF_PRID      14
+#define VPERF_PRID_TAG  0x1D000000
+
+// Record of a DMA node or the PR reader, same header, cycles and tail: the bursts it issued on the
+// AXI master and the cycles it had one waiting for AR / AW, the other counters 0.
+#define VPERF_GRANTS    1
+#define VPERF_WAITS     2
+#define VCMD_PRID       0xE0100000
+
+// Completion record of a job (firmware/jit_cq.v), 4 words on stream 50:
+// {0xBABE000n, tag (R4, 0xCn40tttt), words sent on C, status}
+#define VCQ_MAGIC       0xBABE0000
+#define VCQ_WORDS       4
+#define VCQ_XBAR        1            // status: C went to the crossbar
+#define VCQ_LOST        2            // status: an older record of the node was overwritten
+
+// Bit 16 of a 0xC0n / 0xB0 command writes the shadow set of the node (firmware/jit_dispatch.v):
+// the job queued behind the running one, loaded when that one is done
+#define VCMD_SHADOW     0x00010000
+
+// C field of a 0xB command (firmware/jit_couple.v): 0 to the host, F to the crossbar, E to both,
+// each word leaving when the host and every node reading it took it
+#define VOUT_XBAR       0x00000F00
+#define VOUT_BOTH       0x00000E00
+
+// Node n (1 .. 32) of a command (firmware/jit_dispatch.v): n[3:0] in bits 27:24 and n[5:4] in bits
+// 18:17; the A / B source of a 0xB command n[3:0] in bits 3:0 / 7:4 and n[5:4] in 13:12 / 15:14.
+// Up to node 15 the upper bits are 0.
+#define VCMD_SLOT(n)    ((uint32_t)((n) & 0xF) << 24 | (uint32_t)((n) >> 4 & 0x3) << 17)
+#define VCMD_SRCA(n)    ((uint32_t)((n) & 0xF)       | (uint32_t)((n) >> 4 & 0x3) << 12)
+#define VCMD_SRCB(n)    ((uint32_t)((n) & 0xF) << 4  | (uint32_t)((n) >> 4 & 0x3) << 14)
+#define VCMD_SLOTOF(w)  ((int)((w) >> 24 & 0xF) | (int)((w) >> 17 & 0x3) << 4)
+#define VCMD_SRCAOF(w)  ((int)((w)       & 0xF) | (int)((w) >> 12 & 0x3) << 4)
+#define VCMD_SRCBOF(w)  ((int)((w) >>  4 & 0xF) | (int)((w) >> 14 & 0x3) << 4)
+
+#endif
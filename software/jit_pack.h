@@ -0,0 +1,96 @@
+#ifndef JIT_PACK_H
+#define JIT_PACK_H
+//==================================================================================================
+// Element-wise operators over int16 / int8 vectors, 2 or 4 elements per stream word.
+//
+// vpack_run takes the vectors already in lanes (int16_t / int8_t arrays). Their full words are cut
+// in one slice per node and streamed as they are, every node told the lane count through R3
+// (vsettype), so each word on the link carries 2 or 4 elements and the 0xC01/0xC02 sizes count
+// vwords() words. The last n % lanes elements, short vectors and overlays whose bitstream does not
+// take the type run on the packed SIMD kernels of jit_cpu.h.
+//
+// vpack_run32 does the same for int32 vectors whose values fit the lanes: A and B are packed on the
+// host, C is unpacked (sign extended) after, with the SIMD converters of jit_cpu.h.
+//
+//   err = vpack_run  (VM, VADD, VPACK_I16, A16, B16, C16, n, 8);   // int16_t arrays
+//   err = vpack_run32(VM, VMUL, VPACK_I8,  A,   B,   C,   n, 8);   // int arrays, |values| < 128
+//==================================================================================================
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+#include "jit_isa.h"
+#include "jit_split.h"
+
+#define VPACK_MIN       (1024 * 16)  // words, shorter vectors stay on the CPU
+
+//==================================================================================================
+ int   vpack_op                   (int op);
+ int   vpack_run                  (vam_vm_t *VM, int op, int type, const void *A, const void *B, void *C, int n, int nodes);
+ int   vpack_run32                (vam_vm_t *VM, int op, int type, const int *A, const int *B, int *C, int n, int nodes);
+//==================================================================================================
+int vpack_op(int op)
+{
+  return op == VADD || op == VSUB || op == VMUL || op == A2PB2 || op == VAPBB || op == VAAPB;
+}
+
+int vpack_run(vam_vm_t *VM, int op, int type, const void *A, const void *B, void *C, int n, int nodes)
+{
+  vector<int> nPR;
+  int        *a = (int *)A, *b = (int *)B, *c = (int *)C;
+  int         words, tail, got = 0, i, lo, hi, err;
+
+  if (!vpack_op(op) || (type != VPACK_I32 && type != VPACK_I16 && type != VPACK_I8)) return -1;
+  words = n / type;
+  tail  = n - words * type;
+
+  if (words >= VPACK_MIN && vhaspack(VM, op, type))
+    got = vsplit_claim(VM, op, &nPR, std::min(nodes, words / VSPLIT_ALIGN));
+  #ifdef VERBOSE
+    printf("[DEBUG->vpack_run] op:%d lanes:%d n:%d words:%d nodes:%d\r\n", op, type, n, words, got);
+  #endif
+
+  if (got > 0) {
+    for (i = 0; i < got; i++) {
+      lo  = (int)((int64_t)words * i / got)       / VSPLIT_ALIGN * VSPLIT_ALIGN;
+      hi  = (i == got - 1) ? words : (int)((int64_t)words * (i + 1) / got) / VSPLIT_ALIGN * VSPLIT_ALIGN;
+      err = vlpr(VM, nPR[i], op);                                                                   errCheck(err, FUN_VLPR);
+      err = vsettype(VM, nPR[i], type);                                                             errCheck(err, FUN_VTIEIO);
+      err = vtieio(VM, nPR[i], a + lo, hi - lo, b + lo, hi - lo, c + lo, hi - lo);                  errCheck(err, FUN_VTIEIO);
+    }
+    err = vstart(VM, &nPR);                                                                         errCheck(err, FUN_VSTART);
+    err =   vdel(VM, &nPR);                                                                         errCheck(err, FUN_VDEL);
+  } else if (words > 0) {
+    vcpu_run(op, a, b, c, words, type, (words < VCPU_MT_MIN) ? 1 : vcpu_threads());
+  }
+
+  // the elements of a partial last word, in a zero filled one
+  if (tail > 0) {
+    int ta = 0, tb = 0, tc = 0, bytes = tail * 4 / type;
+    memcpy(&ta, a + words, bytes);
+    memcpy(&tb, b + words, bytes);
+    vcpu_run(op, &ta, &tb, &tc, 1, type, 1);
+    memcpy(c + words, &tc, bytes);
+  }
+  return 0;
+}
+
+int vpack_run32(vam_vm_t *VM, int op, int type, const int *A, const int *B, int *C, int n, int nodes)
+{
+  int *P, words, err;
+
+  if (type == VPACK_I32) return vpack_run(VM, op, type, A, B, C, n, nodes);
+  if (type != VPACK_I16 && type != VPACK_I8) return -1;
+
+  words = vwords(type, n);
+  P     = new int[(size_t)words * 3];
+  vcpu_pack(type, A, n, P);
+  vcpu_pack(type, B, n, P + words);
+  err = vpack_run(VM, op, type, P, P + words, P + 2 * words, words * type, nodes);
+  if (err == 0) vcpu_unpack(type, P + 2 * words, n, C);
+  delete[] P;
+  return err;
+}
+
+#endif
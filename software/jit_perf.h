@@ -0,0 +1,113 @@
+#ifndef JIT_PERF_H
+#define JIT_PERF_H
+//==================================================================================================
+// Per-node counters of the overlay (firmware/jit_perf.v, modelled by emu/jit_emu.h).
+//
+// 0xEn00000x on stream 50 snapshots the counters of node n, bit 0 also clears them, and the node
+// answers with a 16-word record on stream 50: cycles, cycles active / stalled on A / stalled on B /
+// blocked on C, words on A/B/C, words through the crossbar and the A/B/C fifo high-water marks.
+// Word VPERF_PRID of the record holds the region ID vlpr writes, which VAM_VM_INIT reads back.
+// Clearing before a run and reading after it gives the counters of that run:
+//
+//   vperf_clear(VM, &nPR);
+//   vstart(VM, &nPR);
+//   vperf_read (VM, &nPR, &perf);          // one vperf_t per node, cleared again
+//   vperf_show (&perf);                    // utilization and stall breakdown per node
+//
+// Completion records waiting on stream 50 in front of the counters go to the queue of jit_cq.h
+// when it is open, they are dropped otherwise.
+//==================================================================================================
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+#include "jit_isa.h"
+#include "jit_cq.h"
+
+typedef struct {
+  int       nPR;
+  uint32_t  cnt[VPERF_COUNTERS];     // VPERF_* of jit_op.h
+}vperf_t;
+
+//==================================================================================================
+ int   vperf_node                 (vam_vm_t *VM, int nPR, int clear, vperf_t *p);
+ int   vperf_clear                (vam_vm_t *VM, vector<int> *nPR);
+ int   vperf_read                 (vam_vm_t *VM, vector<int> *nPR, vector<vperf_t> *perf);
+double vperf_pct                  (const vperf_t *p, int counter);
+void   vperf_show                 (vector<vperf_t> *perf);
+//==================================================================================================
+int vperf_node(vam_vm_t *VM, int nPR, int clear, vperf_t *p)
+{
+  uint32_t  cmd[4] = {0, 0xDEADBEEF, 0xDEADBEEF, 0xDEADBEEF};
+  uint32_t  rec[VPERF_WORDS];
+  int       card   = VNPR_CARD(nPR);
+  int       node   = VNPR_NODE(nPR);
+  int       cmd_stream, err, i, tries;
+
+  if (card >= CARD || node > VPR_NODE) return -1;
+  cmd[0] = 0xE0000000 | VCMD_SLOT(node + 1) | (clear ? 1 : 0);
+
+  pthread_mutex_lock(&VM->vm_mutex);
+  cmd_stream = VM->pico[card]->CreateStream(50);
+  err = VM->pico[card]->WriteStream(cmd_stream, cmd, 16);
+  // completion records nobody read yet come first
+  for (tries = 0; err >= 0 && tries < VCQ_DEPTH; tries++) {
+    err = VM->pico[card]->ReadStream(cmd_stream, rec, VCQ_WORDS * 4);
+    if (err >= 0 && (rec[0] & 0xFF060000) == (0xE0000000 | VCMD_SLOT(node + 1))) break;
+    if (err >= 0 && VM->CQ != NULL && (rec[0] & 0xFFFF0000) == VCQ_MAGIC) vcq_post(VM->CQ, card, rec);
+  }
+  if (err >= 0 && tries < VCQ_DEPTH) err = VM->pico[card]->ReadStream(cmd_stream, rec + VCQ_WORDS, (VPERF_WORDS - VCQ_WORDS) * 4);
+  VM->pico[card]->CloseStream(cmd_stream);
+  pthread_mutex_unlock(&VM->vm_mutex);
+
+  #ifdef VERBOSE
+    printf("[DEBUG->vperf_node] nPR:0x%02x cmd:0x%08x header:0x%08x\r\n", nPR, cmd[0], rec[0]);
+  #endif
+  if (err < 0 || tries == VCQ_DEPTH) return -1;
+  p->nPR = nPR;
+  for (i = 0; i < VPERF_COUNTERS; i++) p->cnt[i] = rec[i + 1];
+  return 0;
+}
+
+int vperf_clear(vam_vm_t *VM, vector<int> *nPR)
+{
+  vperf_t p;
+  int     i;
+  for (i = 0; i < (int)nPR->size(); i++)
+    if (vperf_node(VM, nPR->at(i), 1, &p) < 0) return -1;
+  return 0;
+}
+
+int vperf_read(vam_vm_t *VM, vector<int> *nPR, vector<vperf_t> *perf)
+{
+  vperf_t p;
+  int     i;
+  perf->clear();
+  for (i = 0; i < (int)nPR->size(); i++) {
+    if (vperf_node(VM, nPR->at(i), 1, &p) < 0) return -1;
+    perf->push_back(p);
+  }
+  return 0;
+}
+
+// Share of the cycles of a run spent in one of the VPERF_ACTIVE..VPERF_BLOCKC classes
+double vperf_pct(const vperf_t *p, int counter)
+{
+  return (p->cnt[VPERF_CYCLES] == 0) ? 0.0 : 100.0 * p->cnt[counter] / p->cnt[VPERF_CYCLES];
+}
+
+void vperf_show(vector<vperf_t> *perf)
+{
+  int i;
+  printf("%-6s %12s %7s %7s %7s %7s %7s %11s %11s %11s %11s %11s %6s %6s %6s\r\n", "node", "cycles", "active", "stallA",
+         "stallB", "blockC", "idle", "wordsA", "wordsB", "wordsC", "xbar in", "xbar out", "hwA", "hwB", "hwC");
+  for (i = 0; i < (int)perf->size(); i++) {
+    vperf_t *p    = &perf->at(i);
+    double   idle = 100.0 - vperf_pct(p, VPERF_ACTIVE) - vperf_pct(p, VPERF_STALLA) - vperf_pct(p, VPERF_STALLB) - vperf_pct(p, VPERF_BLOCKC);
+    printf("0x%02x   %12u %6.1f%% %6.1f%% %6.1f%% %6.1f%% %6.1f%% %11u %11u %11u %11u %11u %6u %6u %6u\r\n", p->nPR,
+           p->cnt[VPERF_CYCLES], vperf_pct(p, VPERF_ACTIVE), vperf_pct(p, VPERF_STALLA), vperf_pct(p, VPERF_STALLB),
+           vperf_pct(p, VPERF_BLOCKC), std::max(idle, 0.0), p->cnt[VPERF_WORDSA], p->cnt[VPERF_WORDSB], p->cnt[VPERF_WORDSC],
+           p->cnt[VPERF_XBARIN], p->cnt[VPERF_XBAROUT], p->cnt[VPERF_HWA], p->cnt[VPERF_HWB], p->cnt[VPERF_HWC]);
+  }
+}
+
+#endif
@@ -0,0 +1,431 @@
+#ifndef JIT_PLAN_H
+#define JIT_PLAN_H
+//==================================================================================================
+// Offload planner. Keeps an online cost model of the overlay and of the CPU kernels of jit_cpu.h
+// and sends every job to the side that is predicted to finish first:
+//
+//   FPGA  = PR + cmd * packets + fixed + word * (words streamed in + out)
+//   CPU   = fixed + word * words read, per operator
+//   SPLIT = element-wise ops only, head of the vectors on a node and tail on the CPU (jit_split.h),
+//           the first ratio picked so that both sides end together
+//
+// cmd is one 16-byte packet on stream 50, PR is the ICAP load of one bitstream (per operator), the
+// fixed/word pairs are decayed least-squares fits over the vstart runs and over the CPU kernel runs.
+// Every measurement updates the model. JIT_PLAN_LOG=<file> (or - for stderr) logs each decision with its prediction error.
+//
+//   vam_plan_t PLAN;
+//   VPLAN_INIT(&PLAN);
+//   err = vplan_run(VM, &PLAN, VADD, A, B, C, size, 0);   // single operator, host buffers
+//   VPLAN_CLEAN(&PLAN);
+//
+// Hand-built graphs describe their nodes as vplan_node_t, ask vplan_graph() where to run and hand
+// the measured time back through vplan_observe_graph().
+//==================================================================================================
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/time.h>
+#include <pthread.h>
+#include <vector>
+#include "jit_isa.h"
+#include "jit_split.h"
+
+#define VPLAN_CPU       0
+#define VPLAN_FPGA      1
+#define VPLAN_SPLIT     2
+
+#define VPLAN_DECAY     0.9      // weight of the history in the stream fit
+#define VPLAN_ALPHA     0.25     // weight of a new sample in the moving averages
+#define VPLAN_EXPLORE   4.0      // try an uncalibrated target once if within this factor
+#define VPLAN_SPLIT_MIN 0.05     // smaller shares are not worth a split
+
+// Priors, only used until the first measurement of each term
+#define VPLAN_CMD_US    5.0
+#define VPLAN_FIXED_US  200.0
+#define VPLAN_WORD_US   0.004    // ~1 GB/s per direction
+#define VPLAN_PR_US     2000.0
+#define VPLAN_CPU_US    20.0
+#define VPLAN_CPU_WORD  0.002
+
+typedef struct {
+  double     S0, Sx, Sy, Sxx, Sxy;   // decayed sums
+  double     fixed;
+  double     word;
+  int        n;
+}vplan_fit_t;
+
+typedef struct {
+  int        op;
+  int        size;      // elements per input stream of the node
+  int        host_in;   // inputs streamed from host buffers, 0..2
+  int        host_out;  // 1 if the output goes back to a host buffer
+}vplan_node_t;
+
+typedef struct {
+  pthread_mutex_t  mutex;
+  FILE            *log;
+
+  double           cmd_us;
+  double           pr_us[MAX_NUM_MODULES];
+  int              n_cmd;
+  int              n_pr[MAX_NUM_MODULES];
+  vplan_fit_t      stream;
+  vplan_fit_t      cpu[MAX_NUM_MODULES];
+  vam_split_t      split;
+
+  long             decisions[3];
+  long             explored;
+  long             samples;
+  double           abs_err;
+}vam_plan_t;
+
+//==================================================================================================
+void   VPLAN_INIT                 (vam_plan_t *PLAN);
+void   VPLAN_CLEAN                (vam_plan_t *PLAN);
+ int   vplan_free                 (vam_vm_t *VM, int op, int *resident);
+double vplan_predict              (vam_plan_t *PLAN, vector<vplan_node_t> *graph, int free, int resident, int target, double *ratio);
+ int   vplan_graph                (vam_vm_t *VM, vam_plan_t *PLAN, vector<vplan_node_t> *graph, double *pred, double *ratio);
+void   vplan_observe_cmd          (vam_plan_t *PLAN, int packets, double us);
+void   vplan_observe_pr           (vam_plan_t *PLAN, int op, double us);
+void   vplan_observe_stream       (vam_plan_t *PLAN, double words, double us);
+void   vplan_observe_cpu          (vam_plan_t *PLAN, int op, double words, double us);
+void   vplan_observe_graph        (vam_plan_t *PLAN, vector<vplan_node_t> *graph, int target, double pred, double us);
+ int   vplan_run                  (vam_vm_t *VM, vam_plan_t *PLAN, int op, int *A, int *B, int *C, int size, int arg);
+//==================================================================================================
+static inline void vplan_fit_init(vplan_fit_t *f, double fixed, double word)
+{
+  f->S0 = f->Sx = f->Sy = f->Sxx = f->Sxy = 0.0;
+  f->fixed = fixed;
+  f->word  = word;
+  f->n     = 0;
+}
+
+static inline double vplan_fit(vplan_fit_t *f, double words)
+{
+  return f->fixed + f->word * words;
+}
+
+static inline double vplan_us(void)
+{
+  struct timeval t;
+  gettimeofday(&t, NULL);
+  return 1000000.0 * t.tv_sec + t.tv_usec;
+}
+
+static inline const char *vplan_name(int target)
+{
+  return (target == VPLAN_FPGA) ? "FPGA" : (target == VPLAN_SPLIT) ? "SPLIT" : "CPU";
+}
+
+void VPLAN_INIT(vam_plan_t *PLAN)
+{
+  int i;
+  const char *env = getenv("JIT_PLAN_LOG");
+
+  pthread_mutex_init(&PLAN->mutex, NULL);
+  PLAN->log      = (env == NULL) ? NULL : (strcmp(env, "-") == 0) ? stderr : fopen(env, "a");
+  PLAN->cmd_us   = VPLAN_CMD_US;
+  PLAN->n_cmd    = 0;
+  vplan_fit_init(&PLAN->stream, VPLAN_FIXED_US, VPLAN_WORD_US);
+  for (i = 0; i < MAX_NUM_MODULES; i++) {
+    PLAN->pr_us[i] = VPLAN_PR_US;
+    PLAN->n_pr[i]  = 0;
+    vplan_fit_init(&PLAN->cpu[i], VPLAN_CPU_US, VPLAN_CPU_WORD);
+  }
+  VSPLIT_INIT(&PLAN->split);
+  PLAN->decisions[VPLAN_CPU] = PLAN->decisions[VPLAN_FPGA] = PLAN->decisions[VPLAN_SPLIT] = 0;
+  PLAN->explored  = 0;
+  PLAN->samples   = 0;
+  PLAN->abs_err   = 0.0;
+  #ifdef VERBOSE
+    printf("[DEBUG->VPLAN_INIT] log:%s\r\n", (env == NULL) ? "off" : env);
+  #endif
+}
+
+// The summary goes to the JIT_PLAN_LOG file, or to stdout with VERBOSE
+void VPLAN_CLEAN(vam_plan_t *PLAN)
+{
+  FILE *out = PLAN->log;
+
+  #ifdef VERBOSE
+    if (out == NULL) out = stdout;
+  #endif
+  if (out != NULL) {
+    fprintf(out, "vplan: %ld CPU, %ld FPGA, %ld SPLIT (%ld explored), mean |err| %.1f%% over %ld jobs\n",
+            PLAN->decisions[VPLAN_CPU], PLAN->decisions[VPLAN_FPGA], PLAN->decisions[VPLAN_SPLIT], PLAN->explored,
+            (PLAN->samples > 0) ? 100.0 * PLAN->abs_err / PLAN->samples : 0.0, PLAN->samples);
+    fprintf(out, "vplan: cmd %.2f us/packet, stream %.1f us + %.5f us/word\n", PLAN->cmd_us, PLAN->stream.fixed, PLAN->stream.word);
+  }
+  if (PLAN->log != NULL && PLAN->log != stderr)
+    fclose(PLAN->log);
+  VSPLIT_CLEAN(&PLAN->split);
+  pthread_mutex_destroy(&PLAN->mutex);
+}
+//==================================================================================================
+// Free nodes, and how many of them already hold the bitstream of op
+int vplan_free(vam_vm_t *VM, int op, int *resident)
+{
+  int free = 0;
+  *resident = 0;
+
+  pthread_mutex_lock(&VM->vm_mutex);
+  vector<vam_node_t>::iterator v = VM->VAM_TABLE->begin();
+  for (; v != VM->VAM_TABLE->end(); v++) {
+    if (v->status == PRFREE) {
+      free++;
+      if (v->PR_key == op) (*resident)++;
+    }
+  }
+  pthread_mutex_unlock(&VM->vm_mutex);
+  return free;
+}
+
+//==================================================================================================
+//  ,------.                   ,--.,--.        ,--.
+//  |  .--. ',--.--. ,---.  ,-|  |`--' ,---.,-'  '-.
+//  |  '--' ||  .--'| .-. :' .-. |,--.| .--''-.  .-'
+//  |  | --' |  |   \   --.\ `-' ||  |\ `--.  |  |
+//  `--'     `--'    `----' `---' `--' `---'  `--'
+//==================================================================================================
+// Predicted time of the graph on one target, called with PLAN->mutex held. ratio returns the share
+// of the elements given to the card for VPLAN_SPLIT. Returns HUGE_VAL when the target cannot run it.
+double vplan_predict(vam_plan_t *PLAN, vector<vplan_node_t> *graph, int free, int resident, int target, double *ratio)
+{
+  double cpu = 0.0, words = 0.0, pr = 0.0, stream;
+  int    nodes = graph->size();
+  int    reuse = resident;
+  int    i;
+
+  for (i = 0; i < nodes; i++) {
+    vplan_node_t *n = &graph->at(i);
+    cpu   += vplan_fit(&PLAN->cpu[n->op], (double)n->size * vcpu_inputs(n->op));
+    words += (double)n->size * n->host_in + (double)vcpu_out_size(n->op, n->size) * n->host_out;
+    if (reuse > 0) reuse--;
+    else           pr += PLAN->pr_us[n->op];
+  }
+  // vlpr sends two framing packets, vtieio one
+  double setup = pr + 3.0 * nodes * PLAN->cmd_us + PLAN->stream.fixed;
+  double fpga  = setup + words * PLAN->stream.word;
+
+  switch (target) {
+    case VPLAN_CPU:  return cpu;
+    case VPLAN_FPGA: return (nodes <= free) ? fpga : HUGE_VAL;
+    default: {
+      if (nodes != 1 || free < 1 || !vsplit_op(graph->at(0).op)) return HUGE_VAL;
+      // setup + f * stream = cpu.fixed + (1 - f) * cpu.word * words
+      vplan_fit_t *c = &PLAN->cpu[graph->at(0).op];
+      double       w = (double)graph->at(0).size * vcpu_inputs(graph->at(0).op);
+      stream = words * PLAN->stream.word;
+      double f = (c->fixed + c->word * w - setup) / (stream + c->word * w);
+      if (f < VPLAN_SPLIT_MIN || f > 1.0 - VPLAN_SPLIT_MIN) return HUGE_VAL;
+      if (ratio != NULL) *ratio = f;
+      return setup + f * stream;
+    }
+  }
+}
+
+int vplan_graph(vam_vm_t *VM, vam_plan_t *PLAN, vector<vplan_node_t> *graph, double *pred, double *ratio)
+{
+  double cost[3];
+  int    resident = 0, free = 0;
+  int    target, alt, i;
+
+  for (i = 0; i < (int)graph->size(); i++)
+    if (!vhasbit(VM, graph->at(i).op)) break;
+  if (i == (int)graph->size())
+    free = vplan_free(VM, graph->at(0).op, &resident);
+
+  pthread_mutex_lock(&PLAN->mutex);
+  for (i = 0; i < 3; i++)
+    cost[i] = vplan_predict(PLAN, graph, free, resident, i, ratio);
+
+  target = VPLAN_CPU;
+  if (cost[VPLAN_FPGA]  < cost[target]) target = VPLAN_FPGA;
+  if (cost[VPLAN_SPLIT] < cost[target]) target = VPLAN_SPLIT;
+
+  // Nothing measured yet on the losing side: the priors may be far off, give it one try.
+  alt = (target == VPLAN_CPU) ? VPLAN_FPGA : VPLAN_CPU;
+  if (cost[alt] != HUGE_VAL && cost[alt] < VPLAN_EXPLORE * cost[target] &&
+      ((alt == VPLAN_FPGA && PLAN->stream.n == 0) || (alt == VPLAN_CPU && PLAN->cpu[graph->at(0).op].n == 0))) {
+    target = alt;
+    PLAN->explored++;
+  }
+  PLAN->decisions[target]++;
+  pthread_mutex_unlock(&PLAN->mutex);
+
+  #ifdef VERBOSE
+    printf("[DEBUG->vplan] nodes:%d free:%d resident:%d CPU:%.1fus FPGA:%.1fus SPLIT:%.1fus -> %s\r\n",
+           (int)graph->size(), free, resident, cost[VPLAN_CPU], cost[VPLAN_FPGA], cost[VPLAN_SPLIT], vplan_name(target));
+  #endif
+  if (pred != NULL) *pred = cost[target];
+  return target;
+}
+//==================================================================================================
+//   ,-----.       ,--.,--.,--.                        ,--.
+//  '  .--./ ,--,--.|  |`--'|  |-.  ,--.--. ,--,--.,-'  '-. ,---.
+//  |  |    ' ,-.  ||  |,--.| .-. ' |  .--'' ,-.  |'-.  .-'| .-. :
+//  '  '--'\ '-'  ||  ||  || `-' | |  |   \ '-'  |  |  |  \   --.
+//   `-----' `--`--'`--'`--' `---'  `--'    `--`--'  `--'   `----'
+//==================================================================================================
+static inline void vplan_ema(double *v, double sample, int *n)
+{
+  *v = (*n == 0) ? sample : (1.0 - VPLAN_ALPHA) * *v + VPLAN_ALPHA * sample;
+  (*n)++;
+}
+
+void vplan_observe_cmd(vam_plan_t *PLAN, int packets, double us)
+{
+  if (packets <= 0) return;
+  pthread_mutex_lock(&PLAN->mutex);
+  vplan_ema(&PLAN->cmd_us, us / packets, &PLAN->n_cmd);
+  pthread_mutex_unlock(&PLAN->mutex);
+}
+
+void vplan_observe_pr(vam_plan_t *PLAN, int op, double us)
+{
+  pthread_mutex_lock(&PLAN->mutex);
+  vplan_ema(&PLAN->pr_us[op], us, &PLAN->n_pr[op]);
+  pthread_mutex_unlock(&PLAN->mutex);
+}
+
+// t = fixed + word * words, least squares with older runs decaying away. Runs of one size only pin
+// the intercept, the slope we have is kept until the sizes spread.
+static void vplan_fit_add(vplan_fit_t *f, double words, double us)
+{
+  f->S0  = VPLAN_DECAY * f->S0  + 1.0;
+  f->Sx  = VPLAN_DECAY * f->Sx  + words;
+  f->Sy  = VPLAN_DECAY * f->Sy  + us;
+  f->Sxx = VPLAN_DECAY * f->Sxx + words * words;
+  f->Sxy = VPLAN_DECAY * f->Sxy + words * us;
+  f->n++;
+
+  double det = f->S0 * f->Sxx - f->Sx * f->Sx;
+  if (det > 1e-6 * f->Sxx * f->S0) {
+    double slope = (f->S0 * f->Sxy - f->Sx * f->Sy) / det;
+    if (slope > 0.0) f->word = slope;
+  }
+  f->fixed = std::max(0.0, (f->Sy - f->word * f->Sx) / f->S0);
+}
+
+void vplan_observe_stream(vam_plan_t *PLAN, double words, double us)
+{
+  pthread_mutex_lock(&PLAN->mutex);
+  vplan_fit_add(&PLAN->stream, words, us);
+  pthread_mutex_unlock(&PLAN->mutex);
+}
+
+void vplan_observe_cpu(vam_plan_t *PLAN, int op, double words, double us)
+{
+  pthread_mutex_lock(&PLAN->mutex);
+  vplan_fit_add(&PLAN->cpu[op], words, us);
+  pthread_mutex_unlock(&PLAN->mutex);
+}
+
+void vplan_observe_graph(vam_plan_t *PLAN, vector<vplan_node_t> *graph, int target, double pred, double us)
+{
+  double err = (us > 0.0) ? (pred - us) / us : 0.0;
+  double words = 0.0;
+  int    i;
+
+  for (i = 0; i < (int)graph->size(); i++)
+    words += (double)graph->at(i).size * vcpu_inputs(graph->at(i).op);
+
+  pthread_mutex_lock(&PLAN->mutex);
+  PLAN->samples++;
+  PLAN->abs_err += fabs(err);
+  if (PLAN->log != NULL)
+    fprintf(PLAN->log, "vplan op:%d nodes:%d words:%.0f target:%s pred:%.1fus actual:%.1fus err:%+.1f%%\n",
+            graph->at(0).op, (int)graph->size(), words, vplan_name(target), pred, us, 100.0 * err);
+  pthread_mutex_unlock(&PLAN->mutex);
+  #ifdef VERBOSE
+    printf("[DEBUG->vplan] %s pred:%.1fus actual:%.1fus err:%+.1f%%\r\n", vplan_name(target), pred, us, 100.0 * err);
+  #endif
+}
+//==================================================================================================
+//  ,------.
+//  |  .--. ',--.,--.,--,--,
+//  |  '--'.'|  ||  ||      \
+//  |  |\  \ '  ''  '|  ||  |
+//  `--' '--' `----' `--''--'
+//==================================================================================================
+// One operator on one claimed node, host buffers on all ports, timed phase by phase.
+static int vplan_fpga(vam_vm_t *VM, vam_plan_t *PLAN, int nPR, int op, int *A, int *B, int *C, int size)
+{
+  vector<int> node(1, nPR);
+  int    index = VNPR_INDEX(nPR);
+  int    in2   = (vcpu_inputs(op) == 2);
+  int    out   = vcpu_out_size(op, size);
+  int    reload, err;
+  double t0, t1;
+
+  reload = (VM->VAM_TABLE->at(index).PR_key != op);
+  t0  = vplan_us();
+  err = vlpr(VM, nPR, op);                                                                        errCheck(err, FUN_VLPR);
+  t1  = vplan_us();
+  if (reload) vplan_observe_pr(PLAN, op, t1 - t0);
+  else        vplan_observe_cmd(PLAN, 2, t1 - t0);
+
+  t0  = vplan_us();
+  // reductions return one beat, the scalar in word 0
+  int  beat[4];
+  int *dst = (out < 4) ? beat : C;
+  err = vtieio(VM, nPR, A, size, in2 ? B : NULL, in2 ? size : 0, dst, std::max(out, 4));           errCheck(err, FUN_VTIEIO);
+  t1  = vplan_us();
+  vplan_observe_cmd(PLAN, 1, t1 - t0);
+
+  t0  = vplan_us();
+  err = vstart(VM, &node);                                                                        errCheck(err, FUN_VSTART);
+  t1  = vplan_us();
+  vplan_observe_stream(PLAN, (double)size * (1 + in2) + out, t1 - t0);
+
+  err = vdel(VM, &node);                                                                          errCheck(err, FUN_VDEL);
+  if (dst == beat) memcpy(C, beat, out * 4);
+  return 0;
+}
+
+int vplan_run(vam_vm_t *VM, vam_plan_t *PLAN, int op, int *A, int *B, int *C, int size, int arg)
+{
+  vector<vplan_node_t> graph(1);
+  double pred, ratio = 0.0, t0, t1;
+  int    target;
+  vector<int> node;
+
+  graph[0].op       = op;
+  graph[0].size     = size;
+  graph[0].host_in  = vcpu_inputs(op);
+  graph[0].host_out = 1;
+
+  target = vplan_graph(VM, PLAN, &graph, &pred, &ratio);
+  if (target == VPLAN_FPGA && vsplit_claim(VM, op, &node, 1) < 1) target = VPLAN_CPU;
+
+  t0 = vplan_us();
+  switch (target) {
+    case VPLAN_FPGA: {
+      vsetarg(VM, node[0], arg);
+      vplan_fpga(VM, PLAN, node[0], op, A, B, C, size);
+    }break;
+
+    case VPLAN_SPLIT: {
+      vsplit_stat_t st;
+
+      pthread_mutex_lock(&PLAN->split.mutex);
+      if (PLAN->split.runs[op] == 0) PLAN->split.ratio[op] = ratio;
+      pthread_mutex_unlock(&PLAN->split.mutex);
+      vsplit(VM, &PLAN->split, op, A, B, C, size, 1, &st);
+      if (st.nodes > 0)
+        vplan_observe_stream(PLAN, (double)st.fpga_size * (1 + (B != NULL)) + st.fpga_size, st.stream_us);
+      vplan_observe_cpu(PLAN, op, (double)st.cpu_size * vcpu_inputs(op), st.cpu_us);
+    }break;
+
+    default: {
+      vcpu(op, A, B, C, size, arg);
+      vplan_observe_cpu(PLAN, op, (double)size * vcpu_inputs(op), vplan_us() - t0);
+    }break;
+  }
+  t1 = vplan_us();
+  vplan_observe_graph(PLAN, &graph, target, pred, t1 - t0);
+  return 0;
+}
+
+#endif
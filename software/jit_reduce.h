@@ -0,0 +1,227 @@
+#ifndef JIT_REDUCE_H
+#define JIT_REDUCE_H
+//==================================================================================================
+// Reductions with a scalar result: VREDUCE (sum A), VADDREDUCE (sum A+B), VSUBREDUCE (sum A-B) and
+// the dot product (sum A*B), all mod 2^32 like jit_cpu.h.
+//
+// The input is cut in one slice per leaf over all claimed nodes. A leaf is the reducer alone when
+// the overlay has a bitstream for the operator, else the element-wise operator streaming into an
+// acc_vredu node through the crossbar. The partial of every leaf is one 128-bit beat, the sum in
+// word 0, and the beats are added pairwise by VADD nodes on the card, so each card sends a single
+// beat back. The host adds the partials of the cards.
+//
+//   per card, 8 nodes:   VREDUCE  4 leaves + 3 VADD          VMUL->VREDUCE  3 leaves + 2 VADD
+//
+// Sizes below VREDUCE_MIN and overlays without the needed bitstreams run on the CPU kernels.
+//
+//   int sum;
+//   err = vreduce(VM, VREDUCE, A, NULL, size, 8, &sum);
+//   err = vdot   (VM, A, B, size, 8, &sum);
+//==================================================================================================
+#include <stdio.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <vector>
+#include <algorithm>
+#include "jit_isa.h"
+#include "jit_split.h"
+
+#define VREDUCE_BEAT    4            // words of a partial, one stream beat, sum in word 0
+#define VREDUCE_MIN     4096         // smaller inputs stay on the CPU
+#define VREDUCE_CHUNK   (1024 * 256) // words of A*B kept at once by the CPU dot product
+#define VREDUCE_HOST    -1           // vreduce_node_t: port fed from / returning to the host
+
+typedef struct {
+  int   nPR;
+  int   op;
+  int   in1, in2;   // producer node or VREDUCE_HOST
+  int   out;        // consumer node or VREDUCE_HOST
+  int  *A, *B;      // host inputs
+  int   size;       // words on in1
+}vreduce_node_t;
+
+//==================================================================================================
+ int   vreduce                    (vam_vm_t *VM, int op, int *A, int *B, int size, int nodes, int *result);
+ int   vdot                       (vam_vm_t *VM, int *A, int *B, int size, int nodes, int *result);
+ int   vreduce_cpu                (int op, int *A, int *B, int size, int *result);
+ int   vreduce_tree               (vam_vm_t *VM, int op, int pre, int *A, int *B, int size, vector<int> *nPR, int *result);
+//==================================================================================================
+// op is VREDUCE/VADDREDUCE/VSUBREDUCE, or VMUL for the dot product
+int vreduce_cpu(int op, int *A, int *B, int size, int *result)
+{
+  int threads = (size < VCPU_MT_MIN) ? 1 : vcpu_threads();
+
+  if (op != VMUL) return vcpu_run(op, A, B, result, size, 0, threads) < 0 ? -1 : 0;
+
+  int     *T = new int[std::min(size, VREDUCE_CHUNK)];
+  uint32_t s = 0;
+  int      i, n, part;
+  for (i = 0; i < size; i += n) {
+    n = std::min(size - i, VREDUCE_CHUNK);
+    vcpu_run(VMUL, A + i, B + i, T, n, 0, threads);
+    vcpu_run(VREDUCE, T, NULL, &part, n, 0, threads);
+    s += (uint32_t)part;
+  }
+  delete[] T;
+  *result = (int)s;
+  return 0;
+}
+
+// Lays out the trees over the claimed nodes, card by card, then ties and starts them all at once.
+// pre is the element-wise operator in front of acc_vredu, NOP when the leaves run op themselves.
+int vreduce_tree(vam_vm_t *VM, int op, int pre, int *A, int *B, int size, vector<int> *nPR, int *result)
+{
+  vector<vreduce_node_t> node;
+  vector<int>            used, spare, cards;
+  int      per  = (pre == NOP) ? 1 : 2;   // nodes per leaf
+  int      in2  = (B != NULL);
+  int      wide = vhasbit(VM, VADD);        // partials can be added on the card
+  int      leaves = 0, leaf = 0, c, i, err;
+
+  // leaves per card: per * l + (l - 1) nodes
+  for (i = 0; i < (int)nPR->size(); i++)
+    if (std::find(cards.begin(), cards.end(), VNPR_CARD(nPR->at(i))) == cards.end()) cards.push_back(VNPR_CARD(nPR->at(i)));
+  vector<int> nleaf(cards.size());
+  for (c = 0; c < (int)cards.size(); c++) {
+    int m = 0;
+    for (i = 0; i < (int)nPR->size(); i++) m += VNPR_CARD(nPR->at(i)) == cards[c];
+    nleaf[c] = wide ? (m + 1) / (per + 1) : std::min(1, m / per);
+    leaves  += nleaf[c];
+  }
+  if (leaves == 0) {
+    vdel(VM, nPR);
+    return vreduce_cpu(op, A, B, size, result);
+  }
+
+  vector<int>       root(cards.size(), -1);
+  vector<int>       beat(cards.size() * VREDUCE_BEAT);
+  for (c = 0; c < (int)cards.size(); c++) {
+    vector<int> ids, q;
+    int         k = 0, h = 0;
+    for (i = 0; i < (int)nPR->size(); i++)
+      if (VNPR_CARD(nPR->at(i)) == cards[c]) ids.push_back(nPR->at(i));
+    if (nleaf[c] == 0) { spare.insert(spare.end(), ids.begin(), ids.end()); continue; }
+
+    for (i = 0; i < nleaf[c]; i++, leaf++) {
+      int lo = (int)((int64_t)size * leaf / leaves)       / VSPLIT_ALIGN * VSPLIT_ALIGN;
+      int hi = (leaf == leaves - 1) ? size : (int)((int64_t)size * (leaf + 1) / leaves) / VSPLIT_ALIGN * VSPLIT_ALIGN;
+      vreduce_node_t n;
+      n.in1 = n.in2 = n.out = VREDUCE_HOST;
+      n.A   = A + lo;
+      n.B   = in2 ? B + lo : NULL;
+      n.size = hi - lo;
+      if (pre != NOP) {
+        n.nPR = ids[k++];
+        n.op  = pre;
+        n.out = (int)node.size() + 1;
+        node.push_back(n);
+        n.in1 = (int)node.size() - 1;
+        n.A   = n.B = NULL;
+        n.out = VREDUCE_HOST;
+      }
+      n.nPR = ids[k++];
+      n.op  = (pre != NOP) ? VREDUCE : op;
+      q.push_back((int)node.size());
+      node.push_back(n);
+    }
+    // pairwise VADD of the partials, the last one left is the root of the card
+    while ((int)q.size() - h > 1) {
+      vreduce_node_t n;
+      n.nPR = ids[k++];
+      n.op  = VADD;
+      n.in1 = q[h];
+      n.in2 = q[h + 1];
+      n.out = VREDUCE_HOST;
+      n.A   = n.B = NULL;
+      n.size = VREDUCE_BEAT;
+      node[q[h]].out = node[q[h + 1]].out = (int)node.size();
+      h += 2;
+      q.push_back((int)node.size());
+      node.push_back(n);
+    }
+    root[c] = q[h];
+    spare.insert(spare.end(), ids.begin() + k, ids.end());
+  }
+  if (!spare.empty()) {
+    err = vdel(VM, &spare);                                                                         errCheck(err, FUN_VDEL);
+  }
+
+  #ifdef VERBOSE
+    printf("[DEBUG->vreduce_tree] op:%d pre:%d size:%d cards:%d leaves:%d nodes:%d\r\n", op, pre, size, (int)cards.size(), leaves, (int)node.size());
+  #endif
+  for (i = 0; i < (int)node.size(); i++) {
+    err = vlpr(VM, node[i].nPR, node[i].op);                                                        errCheck(err, FUN_VLPR);
+  }
+  // the routing of the tree in one burst per card
+  vburst_begin(VM);
+  for (i = 0; i < (int)node.size(); i++) {
+    vreduce_node_t *n = &node[i];
+    int            *dst = NULL;
+    used.push_back(n->nPR);
+    for (c = 0; c < (int)cards.size(); c++)
+      if (root[c] == i) dst = &beat[c * VREDUCE_BEAT];
+
+    if (n->in1 == VREDUCE_HOST) {
+      int two = in2 && n->op != VREDUCE;
+      if (n->out == VREDUCE_HOST)
+        err = vtieio(VM, n->nPR, n->A, n->size, two ? n->B : (int*)NULL, two ? n->size : 0, dst, VREDUCE_BEAT);
+      else
+        err = vtieio(VM, n->nPR, n->A, n->size, two ? n->B : (int*)NULL, two ? n->size : 0, node[n->out].nPR, (n->op == pre) ? n->size : VREDUCE_BEAT);
+    } else if (n->in2 == VREDUCE_HOST) {
+      if (n->out == VREDUCE_HOST)
+        err = vtieio(VM, n->nPR, node[n->in1].nPR, n->size, (int*)NULL, 0, dst, VREDUCE_BEAT);
+      else
+        err = vtieio(VM, n->nPR, node[n->in1].nPR, n->size, (int*)NULL, 0, node[n->out].nPR, VREDUCE_BEAT);
+    } else {
+      if (n->out == VREDUCE_HOST)
+        err = vtieio(VM, n->nPR, node[n->in1].nPR, n->size, node[n->in2].nPR, n->size, dst, VREDUCE_BEAT);
+      else
+        err = vtieio(VM, n->nPR, node[n->in1].nPR, n->size, node[n->in2].nPR, n->size, node[n->out].nPR, VREDUCE_BEAT);
+    }
+                                                                                                    errCheck(err, FUN_VTIEIO);
+  }
+  err = vburst_end(VM);                                                                             errCheck(err, FUN_VTIEIO);
+  err = vstart(VM, &used);                                                                          errCheck(err, FUN_VSTART);
+  err =   vdel(VM, &used);                                                                          errCheck(err, FUN_VDEL);
+
+  // partials of the cards
+  uint32_t s = 0;
+  for (c = 0; c < (int)cards.size(); c++)
+    if (root[c] >= 0) s += (uint32_t)beat[c * VREDUCE_BEAT];
+  *result = (int)s;
+  return 0;
+}
+//==================================================================================================
+int vreduce(vam_vm_t *VM, int op, int *A, int *B, int size, int nodes, int *result)
+{
+  vector<int> nPR;
+  int         pre, per, card;
+
+  switch (op) {
+    case VREDUCE:    pre = NOP;  break;
+    case VADDREDUCE: pre = VADD; break;
+    case VSUBREDUCE: pre = VSUB; break;
+    case VMUL:       pre = VMUL; break;   // vdot
+    default:         return -1;
+  }
+  if (op != VREDUCE && B == NULL) return -1;
+  if (op != VMUL && vhasbit(VM, op)) pre = NOP;   // the overlay reduces op in one node
+  per  = (pre == NOP) ? 1 : 2;
+  card = (pre == NOP) ? vhasbit(VM, op) : vhasbit(VM, VREDUCE) && vhasbit(VM, pre);
+
+  if (card && size >= VREDUCE_MIN && vsplit_claim(VM, (pre == NOP) ? op : VREDUCE, &nPR, nodes) >= per)
+    return vreduce_tree(VM, op, pre, A, B, size, &nPR, result);
+  if (!nPR.empty()) vdel(VM, &nPR);
+
+  #ifdef VERBOSE
+    printf("[DEBUG->vreduce] op:%d size:%d on the CPU\r\n", op, size);
+  #endif
+  return vreduce_cpu(op, A, B, size, result);
+}
+
+int vdot(vam_vm_t *VM, int *A, int *B, int size, int nodes, int *result)
+{
+  return vreduce(VM, VMUL, A, B, size, nodes, result);
+}
+
+#endif
@@ -0,0 +1,468 @@
+#ifndef JIT_SORT_H
+#define JIT_SORT_H
+//==================================================================================================
+// Sort of any length on the INSERTION/MERGE operators, the tree of NewJit05 made generic.
+//
+// The free nodes are arranged as the deepest full tree that fits: 2^d INSERTION leaves each sort
+// VSORT_RUN words, the d levels of MERGE nodes above them merge on the card through the crossbar,
+// and the root streams one sorted run of VSORT_RUN * 2^d words back to the host. With 8 nodes this
+// is the 4 + 2 + 1 tree of NewJit05. Runs are made in waves that are issued back to back, one
+// chunk each, while the CPU workers sort chunks from the other end of the input; the two meet in
+// the middle. The sorted runs are then combined
+//
+//   VSORT_HOST   by a parallel k-way merge on the host (loser trees, one output slice per thread)
+//   VSORT_CARD   by passes of MERGE over the claimed nodes, run length doubling every pass
+//
+// Inputs below VSORT_MIN and overlays without INSERTION/MERGE bitstreams are sorted on the CPU
+// only. Inputs holding VCPU_PADDING (the sorters use it as filler and push it to the tail) never
+// go to the card nor to the INSERTION kernel: they get std::sort per slice and the host merge.
+//
+//   err = vsort(VM, A, size, VSORT_HOST);   // A sorted ascending in place
+//==================================================================================================
+#include <stdio.h>
+#include <stdint.h>
+#include <limits.h>
+#include <pthread.h>
+#include <vector>
+#include <algorithm>
+#include "jit_isa.h"
+#include "jit_split.h"
+
+#define VSORT_HOST      0
+#define VSORT_CARD      1
+
+#define VSORT_RUN       8192         // words one InsertionUnit sorts per job, JIT_SORT_RUN overrides
+#define VSORT_MIN       (1024 * 64)  // smaller inputs stay on the CPU
+#define VSORT_MAX_DEPTH 4            // 31 nodes
+
+typedef struct {
+  const int *p;
+  const int *end;
+}vsort_run_t;
+
+// Loser tree over k runs. tree[0] is the winner, tree[1..k-1] the losers of each match.
+typedef struct {
+  int          k;
+  int         *tree;
+  vsort_run_t *run;
+}vsort_ltree_t;
+
+typedef struct {
+  vam_vm_t        *VM;
+  vector<int>     *nPR;
+  int              depth;
+  int              workers;     // CPU threads sorting chunks
+  const int       *A;
+  int             *T;           // nchunk * chunk words, one run per chunk
+  int              size;
+  int              chunk;
+  int              nchunk;
+  int              front;       // next chunk for the card
+  int              back;        // one past the next chunk for the CPU
+  int              card_chunks;
+  pthread_mutex_t  mutex;
+}vsort_pk_t;
+
+typedef struct {
+  vsort_run_t *run;
+  int          k;
+  int         *C;
+  int64_t      lo, hi;          // output ranks of this slice
+}vsort_merge_pk_t;
+
+//==================================================================================================
+ int   vsort_run_size             (void);
+void   vsort_ltree_init           (vsort_ltree_t *lt, vsort_run_t *run, int k);
+void   vsort_ltree_replay         (vsort_ltree_t *lt, int w);
+void   vsort_ltree_clean          (vsort_ltree_t *lt);
+void   vsort_split                (vsort_run_t *run, int k, int64_t d, int64_t *pos);
+void   vsort_kmerge               (vsort_run_t *run, int k, int *C, int threads);
+void * vsort_merge_Threads_Call   (void *pk);
+void * vsort_card_Threads_Call    (void *pk);
+void * vsort_cpu_Threads_Call     (void *pk);
+void * vsort_std_Threads_Call     (void *pk);
+void   vsort_std                  (int *A, int size, int threads);
+ int   vsort                      (vam_vm_t *VM, int *A, int size, int mode);
+//==================================================================================================
+int vsort_run_size(void)
+{
+  static int run = 0;
+  if (run > 0) return run;
+
+  const char *env = getenv("JIT_SORT_RUN");
+  run = (env != NULL) ? atoi(env) : VSORT_RUN;
+  run = std::max(16, run);
+  return run;
+}
+//==================================================================================================
+//  ,--.                                  ,--.
+//  |  |    ,---.  ,---.  ,---. ,--.--. ,-'  '-.,--.--. ,---.  ,---.
+//  |  |   | .-. |(  .-' | .-. :|  .--' '-.  .-'|  .--'| .-. :| .-. :
+//  |  '--.' '-' '.-'  `)\   --.|  |      |  |  |  |   \   --.\   --.
+//  `-----' `---' `----'  `----'`--'      `--'  `--'    `----' `----'
+//==================================================================================================
+static inline int vsort_ltree_less(vsort_ltree_t *lt, int a, int b)
+{
+  int ea = (lt->run[a].p == lt->run[a].end);
+  int eb = (lt->run[b].p == lt->run[b].end);
+  if (ea || eb) return !ea || (eb && a < b);
+  return *lt->run[a].p < *lt->run[b].p || (*lt->run[a].p == *lt->run[b].p && a < b);
+}
+
+static int vsort_ltree_build(vsort_ltree_t *lt, int node)
+{
+  if (node >= lt->k) return node - lt->k;
+  int a = vsort_ltree_build(lt, 2 * node);
+  int b = vsort_ltree_build(lt, 2 * node + 1);
+  if (vsort_ltree_less(lt, b, a)) { lt->tree[node] = a; return b; }
+  lt->tree[node] = b;
+  return a;
+}
+
+void vsort_ltree_init(vsort_ltree_t *lt, vsort_run_t *run, int k)
+{
+  lt->k    = k;
+  lt->run  = run;
+  lt->tree = new int[std::max(k, 1)];
+  lt->tree[0] = (k > 1) ? vsort_ltree_build(lt, 1) : 0;
+}
+
+// The winner w has moved on (or was refilled), play its path up to the root again.
+void vsort_ltree_replay(vsort_ltree_t *lt, int w)
+{
+  int node;
+  for (node = (w + lt->k) / 2; node >= 1; node /= 2) {
+    if (vsort_ltree_less(lt, lt->tree[node], w)) std::swap(lt->tree[node], w);
+  }
+  lt->tree[0] = w;
+}
+
+void vsort_ltree_clean(vsort_ltree_t *lt)
+{
+  delete[] lt->tree;
+}
+//==================================================================================================
+//  ,--.    ,--.                                            ,--.
+//  |   `.'   | ,---. ,--.--. ,---.  ,---.
+//  |  |'.'|  || .-. :|  .--'| .-. || .-. :
+//  |  |   |  |\   --.|  |   ' '-' '\   --.
+//  `--'   `--' `----'`--'   .`-  /  `----'
+//                           `---'
+//==================================================================================================
+// Cut point of output rank d in every run: sum(pos) = d and all that comes before is <= all after.
+void vsort_split(vsort_run_t *run, int k, int64_t d, int64_t *pos)
+{
+  int64_t lo = INT_MIN, hi = INT_MAX, less = 0, cnt;
+  int     j;
+
+  // smallest v with more than d words <= v
+  while (lo < hi) {
+    int64_t v = lo + (hi - lo) / 2;
+    for (cnt = 0, j = 0; j < k; j++)
+      cnt += std::upper_bound(run[j].p, run[j].end, (int)v) - run[j].p;
+    if (cnt > d) hi = v;
+    else         lo = v + 1;
+  }
+  for (j = 0; j < k; j++) {
+    pos[j] = std::lower_bound(run[j].p, run[j].end, (int)lo) - run[j].p;
+    less  += pos[j];
+  }
+  // the ties with v go to the first runs
+  for (j = 0; j < k && less < d; j++) {
+    int64_t eq = (std::upper_bound(run[j].p, run[j].end, (int)lo) - run[j].p) - pos[j];
+    int64_t t  = std::min(eq, d - less);
+    pos[j] += t;
+    less   += t;
+  }
+}
+
+void * vsort_merge_Threads_Call(void *pk)
+{
+  vsort_merge_pk_t *p = (vsort_merge_pk_t *) pk;
+  vsort_ltree_t lt;
+  int64_t i;
+
+  vsort_ltree_init(&lt, p->run, p->k);
+  for (i = p->lo; i < p->hi; i++) {
+    int w = lt.tree[0];
+    p->C[i] = *p->run[w].p++;
+    vsort_ltree_replay(&lt, w);
+  }
+  vsort_ltree_clean(&lt);
+  return NULL;
+}
+
+// Merges k sorted runs into C, every thread takes one slice of the output.
+void vsort_kmerge(vsort_run_t *run, int k, int *C, int threads)
+{
+  int64_t n = 0;
+  int     i, j;
+
+  for (j = 0; j < k; j++) n += run[j].end - run[j].p;
+  if (n < VCPU_MT_MIN) threads = 1;
+  threads = std::max(1, std::min(threads, VCPU_MAX_THREADS));
+
+  vector<int64_t>          pos((threads + 1) * k);
+  vector<vsort_run_t>      sub(threads * k);
+  vector<vsort_merge_pk_t> pk(threads);
+  vector<pthread_t>        thread(threads);
+
+  for (i = 0; i <= threads; i++)
+    vsort_split(run, k, n * i / threads, &pos[i * k]);
+  for (i = 0; i < threads; i++) {
+    for (j = 0; j < k; j++) {
+      sub[i * k + j].p   = run[j].p + pos[i * k + j];
+      sub[i * k + j].end = run[j].p + pos[(i + 1) * k + j];
+    }
+    pk[i].run = &sub[i * k];
+    pk[i].k   = k;
+    pk[i].C   = C;
+    pk[i].lo  = n * i / threads;
+    pk[i].hi  = n * (i + 1) / threads;
+    if (i > 0) pthread_create(&thread[i], NULL, vsort_merge_Threads_Call, (void*) &pk[i]);
+  }
+  vsort_merge_Threads_Call(&pk[0]);
+  for (i = 1; i < threads; i++) pthread_join(thread[i], NULL);
+}
+//==================================================================================================
+//  ,------.
+//  |  .--. ',--.,--.,--,--,  ,---.
+//  |  '--'.'|  ||  ||      \(  .-'
+//  |  |\  \ '  ''  '|  ||  |.-'  `)
+//  `--' '--' `----' `--''--'`----'
+//==================================================================================================
+// Node i of the tree in heap order: 0 is the root, 2^d - 1 .. 2^(d+1) - 2 are the leaves.
+static void vsort_wave(vsort_pk_t *p, const int *src, int *dst)
+{
+  vector<int> *nPR  = p->nPR;
+  int          run  = vsort_run_size();
+  int          leaf = (1 << p->depth) - 1;
+  int          i, err, size;
+
+  // leaves first, like the tree of NewJit05
+  for (i = (int)nPR->size() - 1; i >= 0; i--) {
+    if (i >= leaf) {
+      int *in = (int*)src + (i - leaf) * run;
+      if (i == 0) err = vtieio(p->VM, nPR->at(i), in, run, (int*)NULL, 0, dst, run);
+      else        err = vtieio(p->VM, nPR->at(i), in, run, (int*)NULL, 0, nPR->at((i - 1) / 2), run);
+    } else {
+      size = run << (p->depth - 1 - (31 - __builtin_clz(i + 1)));  // per input at this level
+      if (i == 0) err = vtieio(p->VM, nPR->at(i), nPR->at(1), size, nPR->at(2), size, dst, 2 * size);
+      else        err = vtieio(p->VM, nPR->at(i), nPR->at(2 * i + 1), size, nPR->at(2 * i + 2), size, nPR->at((i - 1) / 2), 2 * size);
+    }
+    errCheck(err, FUN_VTIEIO);
+  }
+  err = vstart(p->VM, nPR);                                                                         errCheck(err, FUN_VSTART);
+}
+
+void * vsort_card_Threads_Call(void *pk)
+{
+  vsort_pk_t *p   = (vsort_pk_t *) pk;
+  int        *pad = NULL;
+  int         c, n;
+
+  for (;;) {
+    pthread_mutex_lock(&p->mutex);
+    c = (p->front < p->back) ? p->front++ : -1;
+    pthread_mutex_unlock(&p->mutex);
+    if (c < 0) break;
+
+    n = std::min(p->chunk, p->size - c * p->chunk);
+    #ifdef VERBOSE
+      printf("[DEBUG->vsort_card_TCALL] wave chunk:%d words:%d\r\n", c, n);
+    #endif
+    if (n == p->chunk) {
+      vsort_wave(p, p->A + (int64_t)c * p->chunk, p->T + (int64_t)c * p->chunk);
+    } else {
+      if (pad == NULL) pad = new int[p->chunk];
+      memcpy(pad, p->A + (int64_t)c * p->chunk, (size_t)n * 4);
+      std::fill(pad + n, pad + p->chunk, VCPU_PADDING);
+      vsort_wave(p, pad, p->T + (int64_t)c * p->chunk);
+    }
+    p->card_chunks++;
+  }
+  delete[] pad;
+  return NULL;
+}
+
+void * vsort_cpu_Threads_Call(void *pk)
+{
+  vsort_pk_t *p = (vsort_pk_t *) pk;
+  int         c, n;
+
+  for (;;) {
+    pthread_mutex_lock(&p->mutex);
+    c = (p->front < p->back) ? --p->back : -1;
+    pthread_mutex_unlock(&p->mutex);
+    if (c < 0) break;
+
+    int64_t off = (int64_t)c * p->chunk;
+    n = std::min(p->chunk, p->size - c * p->chunk);
+    memcpy(p->T + off, p->A + off, (size_t)n * 4);
+    std::sort(p->T + off, p->T + off + n);
+    std::fill(p->T + off + n, p->T + off + p->chunk, VCPU_PADDING);
+  }
+  return NULL;
+}
+
+// MERGE passes over the claimed nodes until one run is left, ping-pong between T and U.
+static int * vsort_card_merge(vsort_pk_t *p, int *U)
+{
+  vector<int> *nPR = p->nPR;
+  int64_t      len = p->chunk;
+  int          runs = p->nchunk;
+  int         *src = p->T, *dst = U;
+  int         *pad = NULL;
+  int          i, j, err;
+
+  for (i = 0; i < (int)nPR->size(); i++) {
+    err = vlpr(p->VM, nPR->at(i), MERGE);                                                           errCheck(err, FUN_VLPR);
+  }
+  while (runs > 1) {
+    if (runs % 2) {
+      delete[] pad;
+      pad = new int[len];
+      std::fill(pad, pad + len, VCPU_PADDING);
+    }
+    for (i = 0; i < runs; i += 2 * (int)nPR->size()) {
+      vector<int> batch;
+      for (j = 0; j < (int)nPR->size() && i + 2 * j < runs; j++) {
+        int64_t a = (int64_t)(i + 2 * j) * len;
+        int    *b = (i + 2 * j + 1 < runs) ? src + a + len : pad;
+        err = vtieio(p->VM, nPR->at(j), src + a, (int)len, b, (int)len, dst + a, (int)(2 * len));  errCheck(err, FUN_VTIEIO);
+        batch.push_back(nPR->at(j));
+      }
+      err = vstart(p->VM, &batch);                                                                  errCheck(err, FUN_VSTART);
+    }
+    runs = (runs + 1) / 2;
+    len *= 2;
+    std::swap(src, dst);
+  }
+  delete[] pad;
+  return src;
+}
+
+// One slice of vsort_std
+void * vsort_std_Threads_Call(void *pk)
+{
+  vsort_run_t *r = (vsort_run_t *) pk;
+  std::sort((int *) r->p, (int *) r->end);
+  return NULL;
+}
+
+// CPU sort with plain int order, VCPU_PADDING included: std::sort per slice, loser tree merge
+void vsort_std(int *A, int size, int threads)
+{
+  if (size < VSORT_MIN || threads < 2) {
+    std::sort(A, A + size);
+    return;
+  }
+  vector<vsort_run_t> run(threads);
+  vector<pthread_t>   thread(threads);
+  int i;
+
+  for (i = 0; i < threads; i++) {
+    run[i].p   = A + (int64_t)size * i / threads;
+    run[i].end = A + (int64_t)size * (i + 1) / threads;
+    pthread_create(&thread[i], NULL, vsort_std_Threads_Call, (void*) &run[i]);
+  }
+  for (i = 0; i < threads; i++) pthread_join(thread[i], NULL);
+
+  int *T = new int[size];
+  vsort_kmerge(run.data(), threads, T, threads);
+  memcpy(A, T, (size_t)size * 4);
+  delete[] T;
+}
+
+int vsort(vam_vm_t *VM, int *A, int size, int mode)
+{
+  vector<int> nPR;
+  vsort_pk_t  pk;
+  int64_t     cap;
+  int         depth, got, i;
+
+  if (size < 2) return 0;
+
+  if (std::find(A, A + size, VCPU_PADDING) != A + size) {
+    #ifdef VERBOSE
+      printf("[DEBUG->vsort] padding value in input, std::sort, size:%d\r\n", size);
+    #endif
+    vsort_std(A, size, vcpu_threads());
+    return 0;
+  }
+
+  got = 0;
+  if (size >= VSORT_MIN && vhasbit(VM, INSERTION) && vhasbit(VM, MERGE))
+    got = vsplit_claim(VM, INSERTION, &nPR, (2 << VSORT_MAX_DEPTH) - 1);
+
+  if (got == 0) {
+    #ifdef VERBOSE
+      printf("[DEBUG->vsort] CPU only, size:%d\r\n", size);
+    #endif
+    vcpu_run(INSERTION, A, NULL, A, size, 0, vcpu_threads());
+    return 0;
+  }
+
+  // deepest full tree in the claimed nodes, the rest go back
+  for (depth = 0; (2 << (depth + 1)) - 1 <= got; depth++);
+  vector<int> spare(nPR.begin() + (2 << depth) - 1, nPR.end());
+  nPR.resize((2 << depth) - 1);
+  if (!spare.empty()) vdel(VM, &spare);
+
+  int leaf = (1 << depth) - 1;
+  for (i = 0; i < (int)nPR.size(); i++) {
+    int err = vlpr(VM, nPR.at(i), (i >= leaf) ? INSERTION : MERGE);                                 errCheck(err, FUN_VLPR);
+  }
+
+  pk.VM          = VM;
+  pk.nPR         = &nPR;
+  pk.depth       = depth;
+  pk.workers     = std::max(1, vcpu_threads() - 1);
+  pk.A           = A;
+  pk.size        = size;
+  pk.chunk       = vsort_run_size() << depth;
+  pk.nchunk      = (size + pk.chunk - 1) / pk.chunk;
+  pk.front       = 0;
+  pk.back        = pk.nchunk;
+  pk.card_chunks = 0;
+  // MERGE passes pad odd run counts, the buffers then grow up to the next power of two of runs
+  for (cap = 1; mode == VSORT_CARD && cap < pk.nchunk; cap *= 2);
+  cap = std::max(cap, (int64_t)pk.nchunk) * pk.chunk;
+  pk.T           = new int[cap];
+  pthread_mutex_init(&pk.mutex, NULL);
+  #ifdef VERBOSE
+    printf("[DEBUG->vsort] size:%d nodes:%d depth:%d chunk:%d chunks:%d workers:%d\r\n",
+           size, (int)nPR.size(), depth, pk.chunk, pk.nchunk, pk.workers);
+  #endif
+
+  pthread_t         card;
+  vector<pthread_t> cpu(pk.workers);
+  pthread_create(&card, NULL, vsort_card_Threads_Call, (void*) &pk);
+  for (i = 0; i < pk.workers; i++) pthread_create(&cpu[i], NULL, vsort_cpu_Threads_Call, (void*) &pk);
+  pthread_join(card, NULL);
+  for (i = 0; i < pk.workers; i++) pthread_join(cpu[i], NULL);
+  #ifdef VERBOSE
+    printf("[DEBUG->vsort] runs: %d on the card, %d on the CPU\r\n", pk.card_chunks, pk.nchunk - pk.card_chunks);
+  #endif
+
+  if (mode == VSORT_CARD && pk.nchunk > 1) {
+    int *U   = new int[cap];
+    int *out = vsort_card_merge(&pk, U);
+    memcpy(A, out, (size_t)size * 4);
+    delete[] U;
+  } else {
+    vector<vsort_run_t> run(pk.nchunk);
+    for (i = 0; i < pk.nchunk; i++) {
+      run[i].p   = pk.T + (int64_t)i * pk.chunk;
+      run[i].end = run[i].p + std::min(pk.chunk, size - i * pk.chunk);
+    }
+    vsort_kmerge(run.data(), pk.nchunk, A, vcpu_threads());
+  }
+
+  vdel(VM, &nPR);
+  pthread_mutex_destroy(&pk.mutex);
+  delete[] pk.T;
+  return 0;
+}
+
+#endif
@@ -0,0 +1,199 @@
+#ifndef JIT_SPLIT_H
+#define JIT_SPLIT_H
+//==================================================================================================
+// Hybrid execution of the element-wise operators (VADD, VSUB, VMUL). The head of the vectors is
+// cut in one slice per free node and streamed straight from A/B into C, while the tail runs on the
+// SIMD kernels of jit_cpu.h over the remaining cores. Both sides write their part of the same C,
+// nothing is copied.
+//
+// The share of the card is kept per operator and moves after every call towards the ratio of the
+// measured throughputs, so that the nodes and the CPU workers finish together.
+//
+//   vam_split_t SPLIT;
+//   VSPLIT_INIT(&SPLIT);
+//   err = vsplit(VM, &SPLIT, VADD, A, B, C, size, 4, NULL);   // up to 4 nodes + CPU
+//   VSPLIT_CLEAN(&SPLIT);
+//==================================================================================================
+#include <stdio.h>
+#include <sys/time.h>
+#include <pthread.h>
+#include <vector>
+#include "jit_isa.h"
+
+#define VSPLIT_RATIO    0.5      // first guess for the share of the card
+#define VSPLIT_MIN      0.02     // both sides keep some work so they stay measured
+#define VSPLIT_ALPHA    0.5      // weight of the last run in the ratio
+#define VSPLIT_ALIGN    16       // slice boundaries in words, one 64-byte line
+
+typedef struct {
+  pthread_mutex_t  mutex;
+  double           ratio[MAX_NUM_MODULES];
+  int              runs[MAX_NUM_MODULES];
+}vam_split_t;
+
+typedef struct {
+  int        nodes;      // nodes actually used
+  int        fpga_size;  // elements done on the card
+  int        cpu_size;   // elements done on the CPU
+  double     fpga_us;    // vlpr + vtieio + vstart
+  double     stream_us;  // vstart only
+  double     cpu_us;
+  double     ratio;      // share used for this run
+}vsplit_stat_t;
+
+typedef struct {
+  vam_vm_t     *VM;
+  vector<int>  *nPR;
+  int           op;
+  int          *A, *B, *C;
+  int           size;
+  double        fpga_us;
+  double        stream_us;
+}vsplit_pk_t;
+
+//==================================================================================================
+void   VSPLIT_INIT                (vam_split_t *SPLIT);
+void   VSPLIT_CLEAN               (vam_split_t *SPLIT);
+ int   vsplit_op                  (int op);
+ int   vsplit_claim               (vam_vm_t *VM, int op, vector<int> *nPR, int max);
+ int   vsplit                     (vam_vm_t *VM, vam_split_t *SPLIT, int op, int *A, int *B, int *C, int size, int nodes, vsplit_stat_t *stat);
+void * vsplit_Threads_Call        (void *pk);
+//==================================================================================================
+static inline double vsplit_us(void)
+{
+  struct timeval t;
+  gettimeofday(&t, NULL);
+  return 1000000.0 * t.tv_sec + t.tv_usec;
+}
+
+void VSPLIT_INIT(vam_split_t *SPLIT)
+{
+  int i;
+  pthread_mutex_init(&SPLIT->mutex, NULL);
+  for (i = 0; i < MAX_NUM_MODULES; i++) {
+    SPLIT->ratio[i] = VSPLIT_RATIO;
+    SPLIT->runs[i]  = 0;
+  }
+}
+
+void VSPLIT_CLEAN(vam_split_t *SPLIT)
+{
+  pthread_mutex_destroy(&SPLIT->mutex);
+}
+
+int vsplit_op(int op)
+{
+  return op == VADD || op == VSUB || op == VMUL;
+}
+
+// Takes up to max free nodes without waiting, the ones already holding op first. Returns how many.
+int vsplit_claim(vam_vm_t *VM, int op, vector<int> *nPR, int max)
+{
+  int pass;
+
+  pthread_mutex_lock(&VM->vm_mutex);
+  for (pass = 0; pass < 2; pass++) {
+    vector<vam_node_t>::iterator v = VM->VAM_TABLE->begin();
+    for (; v != VM->VAM_TABLE->end() && (int)nPR->size() < max; v++) {
+      if (v->status != PRFREE || (pass == 0 && v->PR_key != op)) continue;
+      v->status = PRBUSY;
+      nPR->push_back(VNPR(v->card_key, v->node_key));
+    }
+  }
+  pthread_mutex_unlock(&VM->vm_mutex);
+  return nPR->size();
+}
+
+// Card side of a split: one slice per node, all nodes streaming at once.
+void * vsplit_Threads_Call(void *pk)
+{
+  vsplit_pk_t *p = (vsplit_pk_t *) pk;
+  int    n   = p->nPR->size();
+  int    in2 = (p->B != NULL);
+  int    i, lo, hi, err;
+  double t0  = vsplit_us(), t1;
+
+  for (i = 0; i < n; i++) {
+    lo = (int)((int64_t)p->size * i / n)       / VSPLIT_ALIGN * VSPLIT_ALIGN;
+    hi = (i == n - 1) ? p->size : (int)((int64_t)p->size * (i + 1) / n) / VSPLIT_ALIGN * VSPLIT_ALIGN;
+    #ifdef VERBOSE
+      printf("[DEBUG->vsplit_TCALL] nPR:0x%08x [%d, %d)\r\n", p->nPR->at(i), lo, hi);
+    #endif
+    err =   vlpr(p->VM, p->nPR->at(i), p->op);                                                      errCheck(err, FUN_VLPR);
+    err = vtieio(p->VM, p->nPR->at(i), p->A + lo, hi - lo, in2 ? p->B + lo : NULL, in2 ? hi - lo : 0, p->C + lo, hi - lo);
+                                                                                                    errCheck(err, FUN_VTIEIO);
+  }
+  t1  = vsplit_us();
+  err = vstart(p->VM, p->nPR);                                                                      errCheck(err, FUN_VSTART);
+  p->stream_us = vsplit_us() - t1;
+  err =   vdel(p->VM, p->nPR);                                                                      errCheck(err, FUN_VDEL);
+  p->fpga_us   = vsplit_us() - t0;
+  return NULL;
+}
+
+int vsplit(vam_vm_t *VM, vam_split_t *SPLIT, int op, int *A, int *B, int *C, int size, int nodes, vsplit_stat_t *stat)
+{
+  vector<int> nPR;
+  pthread_t   thread;
+  vsplit_pk_t pk;
+  double      ratio, t0, cpu_us, rf, rc;
+  int         head = 0, got, threads;
+
+  if (!vsplit_op(op)) return -1;
+
+  pthread_mutex_lock(&SPLIT->mutex);
+  ratio = SPLIT->ratio[op];
+  pthread_mutex_unlock(&SPLIT->mutex);
+
+  got = vhasbit(VM, op) ? vsplit_claim(VM, op, &nPR, nodes) : 0;
+  if (got > 0)
+    head = (int)(ratio * size) / VSPLIT_ALIGN * VSPLIT_ALIGN;
+  if (got > 0 && head < VSPLIT_ALIGN * got) {  // too small to be worth the nodes
+    vdel(VM, &nPR);
+    nPR.clear();
+    got  = 0;
+    head = 0;
+  }
+  #ifdef VERBOSE
+    printf("[DEBUG->vsplit] op:%d size:%d nodes:%d ratio:%.3f head:%d\r\n", op, size, got, ratio, head);
+  #endif
+
+  pk.VM = VM; pk.nPR = &nPR; pk.op = op; pk.size = head;
+  pk.A  = A;  pk.B   = B;    pk.C  = C;
+  pk.fpga_us = pk.stream_us = 0.0;
+  if (got > 0)
+    pthread_create(&thread, NULL, vsplit_Threads_Call, (void*) &pk);
+
+  // The streaming threads mostly sleep in the driver, leave one core per node for them anyway
+  threads = std::max(1, vcpu_threads() - got);
+  t0 = vsplit_us();
+  vcpu_run(op, A + head, (B != NULL) ? B + head : NULL, C + head, size - head, 0, threads);
+  cpu_us = vsplit_us() - t0;
+
+  if (got > 0) {
+    pthread_join(thread, NULL);
+    rf = head / std::max(pk.fpga_us, 1.0);
+    rc = (size - head) / std::max(cpu_us, 1.0);
+    pthread_mutex_lock(&SPLIT->mutex);
+    SPLIT->ratio[op] = (1.0 - VSPLIT_ALPHA) * SPLIT->ratio[op] + VSPLIT_ALPHA * rf / (rf + rc);
+    SPLIT->ratio[op] = std::max(VSPLIT_MIN, std::min(1.0 - VSPLIT_MIN, SPLIT->ratio[op]));
+    SPLIT->runs[op]++;
+    pthread_mutex_unlock(&SPLIT->mutex);
+    #ifdef VERBOSE
+      printf("[DEBUG->vsplit] card:%.1fus cpu:%.1fus next ratio:%.3f\r\n", pk.fpga_us, cpu_us, SPLIT->ratio[op]);
+    #endif
+  }
+
+  if (stat != NULL) {
+    stat->nodes     = got;
+    stat->fpga_size = head;
+    stat->cpu_size  = size - head;
+    stat->fpga_us   = pk.fpga_us;
+    stat->stream_us = pk.stream_us;
+    stat->cpu_us    = cpu_us;
+    stat->ratio     = ratio;
+  }
+  return 0;
+}
+
+#endif
@@ -0,0 +1,239 @@
+#ifndef JIT_SQL_H
+#define JIT_SQL_H
+//==================================================================================================
+// Columnar scan operators over int32 columns on SQLLESS / SQLLARGE / SQLAVG.
+//
+//   filter      SQLLESS/SQLLARGE keep the rows below/above K and put VCPU_NULL in the others. The
+//               column goes through in waves of one VSQL_CHUNK per node; while the card filters
+//               wave w+1 the host compacts wave w into the values and/or the row ids (selection
+//               vector) of the rows kept.
+//   aggregate   SQLAVG returns {avg, count, sum low, sum high} of the non null rows of a chunk in
+//               one beat. With a filter in front, every chunk streams A -> filter -> SQLAVG through
+//               the crossbar and only the beat comes back; the host adds the beats of the chunks.
+//
+// K travels in R3 (vsetarg) and is a signed 16 bit constant. VCPU_NULL (INT_MIN) is the null of the
+// column, it never passes a filter. Short columns and overlays without the bitstreams run on the
+// SIMD kernels of jit_cpu.h, chunk by chunk as well.
+//
+//   int n;
+//   err = vsql_filter   (VM, SQLLESS, A, size, 100, C, sel, &n, 8);   // C or sel may be NULL
+//   vsql_agg_t agg;
+//   err = vsql_aggregate(VM, SQLLARGE, A, size, -5, &agg, 8);         // NOP: no filter
+//==================================================================================================
+#include <stdio.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <vector>
+#include <algorithm>
+#include "jit_isa.h"
+#include "jit_split.h"
+
+#define VSQL_CHUNK      (1024 * 1024)  // words per node job
+#define VSQL_MIN        (1024 * 64)    // shorter columns stay on the CPU
+
+typedef struct {
+  int        avg;
+  int64_t    count;
+  int64_t    sum;
+}vsql_agg_t;
+
+typedef struct {
+  vam_vm_t     *VM;
+  vector<int>  *nPR;
+  int           op;
+  int          *A;
+  int          *T;
+  int           size;
+}vsql_pk_t;
+
+//==================================================================================================
+ int   vsql_filter                (vam_vm_t *VM, int op, int *A, int size, int k, int *C, int *sel, int *count, int nodes);
+ int   vsql_aggregate             (vam_vm_t *VM, int op, int *A, int size, int k, vsql_agg_t *agg, int nodes);
+ int   vsql_avg                   (vam_vm_t *VM, int *A, int size, vsql_agg_t *agg, int nodes);
+ int   vsql_compact               (const int *T, int n, int base, int *C, int *sel);
+void * vsql_filter_Threads_Call   (void *pk);
+//==================================================================================================
+// Keeps the non null words of T, their values in C and their row ids (base + i) in sel.
+int vsql_compact(const int *T, int n, int base, int *C, int *sel)
+{
+  int i, c = 0;
+
+  if (C != NULL && sel != NULL) {
+    for (i = 0; i < n; i++) { C[c] = T[i]; sel[c] = base + i; c += (T[i] != (int)VCPU_NULL); }
+  } else if (C != NULL) {
+    for (i = 0; i < n; i++) { C[c] = T[i];                    c += (T[i] != (int)VCPU_NULL); }
+  } else if (sel != NULL) {
+    for (i = 0; i < n; i++) {                sel[c] = base + i; c += (T[i] != (int)VCPU_NULL); }
+  } else {
+    for (i = 0; i < n; i++)                                   c += (T[i] != (int)VCPU_NULL);
+  }
+  return c;
+}
+
+// One wave of the filter: a slice of A per node, masked words into T. A short last wave leaves
+// some nodes without a slice, only the ones tied are started.
+void * vsql_filter_Threads_Call(void *pk)
+{
+  vsql_pk_t  *p = (vsql_pk_t *) pk;
+  vector<int> tied;
+  int n = p->nPR->size();
+  int i, lo, hi, err;
+
+  for (i = 0; i < n; i++) {
+    lo  = (int)((int64_t)p->size * i / n)       / VSPLIT_ALIGN * VSPLIT_ALIGN;
+    hi  = (i == n - 1) ? p->size : (int)((int64_t)p->size * (i + 1) / n) / VSPLIT_ALIGN * VSPLIT_ALIGN;
+    if (hi == lo) continue;
+    err = vtieio(p->VM, p->nPR->at(i), p->A + lo, hi - lo, (int*)NULL, 0, p->T + lo, hi - lo);     errCheck(err, FUN_VTIEIO);
+    tied.push_back(p->nPR->at(i));
+  }
+  err = vstart(p->VM, &tied);                                                                       errCheck(err, FUN_VSTART);
+  return NULL;
+}
+
+int vsql_filter(vam_vm_t *VM, int op, int *A, int size, int k, int *C, int *sel, int *count, int nodes)
+{
+  vector<int> nPR;
+  int         got = 0, wave, done, c = 0, i, err;
+
+  if ((op != SQLLESS && op != SQLLARGE) || k < -32768 || k > 32767) return -1;
+
+  if (size >= VSQL_MIN && vhasbit(VM, op))
+    got = vsplit_claim(VM, op, &nPR, std::min(nodes, (size + VSQL_CHUNK - 1) / VSQL_CHUNK));
+  #ifdef VERBOSE
+    printf("[DEBUG->vsql_filter] op:%d size:%d k:%d nodes:%d\r\n", op, size, k, got);
+  #endif
+
+  // CPU: SIMD filter and compaction, chunk by chunk
+  if (got == 0) {
+    int  threads = (size < VCPU_MT_MIN) ? 1 : vcpu_threads();
+    int *T       = new int[std::min(size, VSQL_CHUNK)];
+    for (i = 0; i < size; i += VSQL_CHUNK) {
+      int n = std::min(size - i, VSQL_CHUNK);
+      vcpu_run(op, A + i, NULL, T, n, k, threads);
+      c += vsql_compact(T, n, i, (C != NULL) ? C + c : NULL, (sel != NULL) ? sel + c : NULL);
+    }
+    delete[] T;
+    *count = c;
+    return 0;
+  }
+
+  // Card: filter wave w+1 while the host compacts wave w
+  int       *T[2];
+  vsql_pk_t  pk;
+  pthread_t  thread;
+
+  wave = got * VSQL_CHUNK;
+  T[0] = new int[std::min(size, wave)];
+  T[1] = new int[std::min(size, wave)];
+  for (i = 0; i < got; i++) {
+    err = vlpr(VM, nPR[i], op);                                                                     errCheck(err, FUN_VLPR);
+    vsetarg(VM, nPR[i], k);
+  }
+  pk.VM = VM; pk.nPR = &nPR; pk.op = op;
+  for (done = 0, i = 0; done < size; done += wave, i++) {
+    pk.A    = A + done;
+    pk.T    = T[i & 1];
+    pk.size = std::min(size - done, wave);
+    pthread_create(&thread, NULL, vsql_filter_Threads_Call, (void*) &pk);
+    if (i > 0) {
+      int n = wave;   // the previous wave was a full one
+      c += vsql_compact(T[(i - 1) & 1], n, done - wave, (C != NULL) ? C + c : NULL, (sel != NULL) ? sel + c : NULL);
+    }
+    pthread_join(thread, NULL);
+  }
+  c += vsql_compact(T[(i - 1) & 1], size - (done - wave), done - wave, (C != NULL) ? C + c : NULL, (sel != NULL) ? sel + c : NULL);
+
+  err = vdel(VM, &nPR);                                                                             errCheck(err, FUN_VDEL);
+  delete[] T[0];
+  delete[] T[1];
+  *count = c;
+  return 0;
+}
+//==================================================================================================
+static void vsql_agg_add(vsql_agg_t *agg, const int *beat)
+{
+  agg->count += (uint32_t)beat[1];
+  agg->sum   += (int64_t)((uint64_t)(uint32_t)beat[2] | (uint64_t)(uint32_t)beat[3] << 32);
+}
+
+// op is SQLLESS/SQLLARGE for a filter in front of SQLAVG, NOP for none.
+int vsql_aggregate(vam_vm_t *VM, int op, int *A, int size, int k, vsql_agg_t *agg, int nodes)
+{
+  vector<int> nPR;
+  int         per = (op == NOP) ? 1 : 2;
+  int         lanes = 0, done, i, err;
+  int         beat[4];
+
+  if ((op != NOP && op != SQLLESS && op != SQLLARGE) || k < -32768 || k > 32767) return -1;
+  agg->count = 0;
+  agg->sum   = 0;
+
+  if (size >= VSQL_MIN && vhasbit(VM, SQLAVG) && (op == NOP || vhasbit(VM, op))) {
+    lanes = std::min(nodes / per, (size + VSQL_CHUNK - 1) / VSQL_CHUNK);
+    lanes = (lanes > 0) ? vsplit_claim(VM, SQLAVG, &nPR, lanes * per) / per : 0;
+    if (lanes == 0 && !nPR.empty()) {
+      vdel(VM, &nPR);
+      nPR.clear();
+    }
+  }
+  #ifdef VERBOSE
+    printf("[DEBUG->vsql_aggregate] op:%d size:%d k:%d lanes:%d\r\n", op, size, k, lanes);
+  #endif
+
+  if (lanes == 0) {
+    int  threads = (size < VCPU_MT_MIN) ? 1 : vcpu_threads();
+    int *T       = (op == NOP) ? NULL : new int[std::min(size, VSQL_CHUNK)];
+    for (i = 0; i < size; i += VSQL_CHUNK) {
+      int n = std::min(size - i, VSQL_CHUNK);
+      if (op != NOP) vcpu_run(op, A + i, NULL, T, n, k, threads);
+      vcpu_run(SQLAVG, (op != NOP) ? T : A + i, NULL, beat, n, 0, threads);
+      vsql_agg_add(agg, beat);
+    }
+    delete[] T;
+  } else {
+    // lane j: nPR[j] runs SQLAVG, nPR[lanes + j] the filter in front of it
+    vector<int> used(nPR.begin(), nPR.begin() + lanes * per);
+    vector<int> beats(lanes * 4);
+    if ((int)nPR.size() > lanes * per) {
+      vector<int> spare(nPR.begin() + lanes * per, nPR.end());
+      vdel(VM, &spare);
+    }
+    for (i = 0; i < lanes; i++) {
+      err = vlpr(VM, used[i], SQLAVG);                                                              errCheck(err, FUN_VLPR);
+      if (op != NOP) {
+        err = vlpr(VM, used[lanes + i], op);                                                        errCheck(err, FUN_VLPR);
+        vsetarg(VM, used[lanes + i], k);
+      }
+    }
+    for (done = 0; done < size; ) {
+      int n = 0, j;
+      for (j = 0; j < lanes && done < size; j++, done += n) {
+        n = std::min(size - done, VSQL_CHUNK);
+        if (op == NOP) {
+          err = vtieio(VM, used[j], A + done, n, (int*)NULL, 0, &beats[j * 4], 4);                  errCheck(err, FUN_VTIEIO);
+        } else {
+          err = vtieio(VM, used[lanes + j], A + done, n, (int*)NULL, 0, used[j], n);                errCheck(err, FUN_VTIEIO);
+          err = vtieio(VM, used[j], used[lanes + j], n, (int*)NULL, 0, &beats[j * 4], 4);           errCheck(err, FUN_VTIEIO);
+        }
+      }
+      vector<int> wave;
+      for (i = 0; i < j; i++) {
+        wave.push_back(used[i]);
+        if (op != NOP) wave.push_back(used[lanes + i]);
+      }
+      err = vstart(VM, &wave);                                                                      errCheck(err, FUN_VSTART);
+      for (i = 0; i < j; i++) vsql_agg_add(agg, &beats[i * 4]);
+    }
+    err = vdel(VM, &used);                                                                          errCheck(err, FUN_VDEL);
+  }
+
+  agg->avg = (agg->count != 0) ? (int)(agg->sum / agg->count) : 0;
+  return 0;
+}
+
+int vsql_avg(vam_vm_t *VM, int *A, int size, vsql_agg_t *agg, int nodes)
+{
+  return vsql_aggregate(VM, NOP, A, size, 0, agg, nodes);
+}
+
+#endif
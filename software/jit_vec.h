@@ -0,0 +1,184 @@
+#ifndef JIT_VEC_H
+#define JIT_VEC_H
+//==================================================================================================
+// jit::vec<int32_t>, an int32 vector whose +, - and * are lazy.
+//
+// An operator only records its operands in an expression template; nothing runs until the
+// expression is materialized by an assignment, eval() or sum(). Then the whole expression becomes
+// one vexpr_t graph (jit_expr.h) and runs as one set of chained nodes, the intermediate results
+// stay on the card unless the graph has to be cut. Vectors shorter than VEXPR_MIN, and every
+// vector when no VM is bound, run on the SIMD kernels of jit_cpu.h.
+//
+//   jit::vec_bind(VM, 8);                 // VM and nodes used by the materializations
+//   jit::vec<int32_t> a(A, size), b(B, size), c(size);
+//   c  = (a + b) * (a + b) + a * a;       // one graph, a+b computed once
+//   c += b;
+//   int s = jit::sum(a * b);              // dot product on VMUL->VREDUCE, no vector comes back
+//
+// An expression holds references to its vectors and to nothing else, so it must be materialized
+// in the statement that builds it.
+//==================================================================================================
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "jit_isa.h"
+#include "jit_expr.h"
+#include "jit_reduce.h"
+
+namespace jit {
+
+typedef struct {
+  vam_vm_t     *VM;
+  int           nodes;
+  vexpr_stat_t  stat;       // of the last materialization
+}vec_ctx_t;
+
+template <typename T> class vec;
+
+//==================================================================================================
+inline vec_ctx_t *  vec_ctx          ();
+inline void         vec_bind         (vam_vm_t *VM, int nodes);
+inline int          vec_run          (vexpr_t *E, int root, int32_t *out, int size);
+inline int32_t      vec_reduce       (int op, const vec<int32_t> &a, const vec<int32_t> *b);
+//==================================================================================================
+inline vec_ctx_t * vec_ctx()
+{
+  static vec_ctx_t ctx = {NULL, 0};
+  return &ctx;
+}
+
+// VM NULL keeps every materialization on the CPU
+inline void vec_bind(vam_vm_t *VM, int nodes)
+{
+  vec_ctx()->VM    = VM;
+  vec_ctx()->nodes = (VM == NULL) ? 0 : nodes;
+}
+
+// Runs a built graph into out, through a temporary when out is also one of its inputs.
+inline int vec_run(vexpr_t *E, int root, int32_t *out, int size)
+{
+  vec_ctx_t *ctx = vec_ctx();
+  int32_t   *dst = out;
+  int        i, err;
+
+  for (i = 0; i < (int)E->node.size(); i++)
+    if (E->node[i].op == NOP && E->node[i].buf == out && i != root) dst = new int32_t[size];
+  err = vexpr_run(ctx->VM, E, root, dst, size, ctx->nodes, &ctx->stat);
+  if (dst != out) {
+    memcpy(out, dst, (size_t)size * 4);
+    delete[] dst;
+  }
+  return err;
+}
+//==================================================================================================
+//   ___                        _
+//  | __|_ ___ __ _ _ ___ _____(_)___ _ _  ___
+//  | _|\ \ / '_ \ '_/ -_|_-<_-< / _ \ ' \(_-<
+//  |___/_\_\ .__/_| \___/__/__/_\___/_||_/__/
+//          |_|
+//==================================================================================================
+// Base of every expression, D is the expression itself.
+template <class D> struct vexp {
+  const D & self() const { return static_cast<const D &>(*this); }
+};
+
+// Operands are kept by reference when they are vectors, by value when they are expressions.
+template <class X> struct vref                  { typedef const X   type; };
+template <class X> struct vref< vec<X> >        { typedef const vec<X> & type; };
+
+template <int OP, class L, class R> struct vbin : public vexp< vbin<OP, L, R> > {
+  typename vref<L>::type  l;
+  typename vref<R>::type  r;
+
+  vbin(const L &a, const R &b) : l(a), r(b) {}
+  int size() const { return l.size(); }
+  int match(int n) const { return l.match(n) && r.match(n); }
+  int build(vexpr_t *E) const { return vexpr_op(E, OP, l.build(E), r.build(E)); }
+};
+
+template <class L, class R> inline vbin<VADD, L, R> operator+ (const vexp<L> &a, const vexp<R> &b)
+{ return vbin<VADD, L, R>(a.self(), b.self()); }
+template <class L, class R> inline vbin<VSUB, L, R> operator- (const vexp<L> &a, const vexp<R> &b)
+{ return vbin<VSUB, L, R>(a.self(), b.self()); }
+template <class L, class R> inline vbin<VMUL, L, R> operator* (const vexp<L> &a, const vexp<R> &b)
+{ return vbin<VMUL, L, R>(a.self(), b.self()); }
+//==================================================================================================
+//  __   __
+//  \ \ / /__ __
+//   \ V / -_) _|
+//    \_/\___\__|
+//==================================================================================================
+template <> class vec<int32_t> : public vexp< vec<int32_t> > {
+  std::vector<int32_t>  v;
+
+ public:
+  vec() {}
+  explicit vec(int size) : v(size, 0) {}
+  vec(const int32_t *src, int size) : v(src, src + size) {}
+  template <class D> vec(const vexp<D> &e) : v(e.self().size()) { assign(e); }
+
+  vec & operator= (const vec &b) { v = b.v; return *this; }
+  template <class D> vec & operator=  (const vexp<D> &e) { assign(e); return *this; }
+  template <class D> vec & operator+= (const vexp<D> &e) { assign(*this + e); return *this; }
+  template <class D> vec & operator-= (const vexp<D> &e) { assign(*this - e); return *this; }
+  template <class D> vec & operator*= (const vexp<D> &e) { assign(*this * e); return *this; }
+
+  // -1 when the vectors of e are not all as long as this one
+  template <class D> int assign(const vexp<D> &e)
+  {
+    vexpr_t E;
+    int     err;
+    if (!e.self().match(size())) {
+      printf("[jit::vec] size mismatch, %d words expected\r\n", size());
+      return -1;
+    }
+    VEXPR_INIT(&E);
+    err = vec_run(&E, e.self().build(&E), data(), size());
+    VEXPR_CLEAN(&E);
+    return err;
+  }
+
+  int             size() const                { return v.size(); }
+  int             match(int n) const          { return size() == n; }
+  int             build(vexpr_t *E) const     { return vexpr_leaf(E, (int *)&v[0]); }
+  int32_t *       data()                      { return v.empty() ? NULL : &v[0]; }
+  const int32_t * data() const                { return v.empty() ? NULL : &v[0]; }
+  int32_t &       operator[] (int i)          { return v[i]; }
+  int32_t         operator[] (int i) const    { return v[i]; }
+};
+//==================================================================================================
+//   ___        _         _   _
+//  | _ \___ __| |_  _ __| |_(_)___ _ _  ___
+//  |   / -_) _` | || / _|  _| / _ \ ' \(_-<
+//  |_|_\___\__,_|\_,_\__|\__|_\___/_||_/__/
+//==================================================================================================
+inline int32_t vec_reduce(int op, const vec<int32_t> &a, const vec<int32_t> *b)
+{
+  vec_ctx_t *ctx = vec_ctx();
+  int        s   = 0;
+  int       *A   = (int *)a.data(), *B = (b != NULL) ? (int *)b->data() : NULL;
+
+  if (b != NULL && b->size() != a.size()) {
+    printf("[jit::vec] size mismatch, %d words expected\r\n", a.size());
+    return 0;
+  }
+  if (ctx->VM == NULL || ctx->nodes == 0) vreduce_cpu(op, A, B, a.size(), &s);
+  else                                    vreduce(ctx->VM, op, A, B, a.size(), ctx->nodes, &s);
+  return s;
+}
+
+// Sums of one operator over two vectors go to the reducers that take it in front
+inline int32_t sum(const vec<int32_t> &a)                                        { return vec_reduce(VREDUCE,    a, NULL);  }
+inline int32_t sum(const vbin<VADD, vec<int32_t>, vec<int32_t> > &e)             { return vec_reduce(VADDREDUCE, e.l, &e.r); }
+inline int32_t sum(const vbin<VSUB, vec<int32_t>, vec<int32_t> > &e)             { return vec_reduce(VSUBREDUCE, e.l, &e.r); }
+inline int32_t sum(const vbin<VMUL, vec<int32_t>, vec<int32_t> > &e)             { return vec_reduce(VMUL,       e.l, &e.r); }
+inline int32_t dot(const vec<int32_t> &a, const vec<int32_t> &b)                 { return vec_reduce(VMUL,       a,   &b);   }
+
+// Other expressions are materialized first
+template <class D> inline vec<int32_t> eval(const vexp<D> &e) { return vec<int32_t>(e); }
+template <class D> inline int32_t      sum (const vexp<D> &e) { return sum(eval(e)); }
+
+}  // namespace jit
+
+#endif
@@ -0,0 +1,310 @@
+#ifndef JIT_XSORT_H
+#define JIT_XSORT_H
+//==================================================================================================
+// External sort of a file of int32 words that does not fit in memory.
+//
+//   runs    the input is mmap'ed and cut in runs of a third of the memory budget. While run k is
+//           sorted by vsort (card tree + CPU workers), run k+1 is copied in from the mapping and
+//           run k-1 is spilled to <out>.runs, both by their own thread, in VXSORT_IO writes.
+//   merge   the spill file is mmap'ed and cut by multi-sequence selection in one output slice per
+//           thread. Every thread merges its slice of all runs with a loser tree, asks the kernel
+//           for the next window of a run before the cursor gets there, drops the windows behind
+//           it, and writes its output with pwrite in VXSORT_IO blocks.
+//
+//   err = vxsort(VM, "in.bin", "out.bin", 0);   // budget from JIT_XSORT_MEM_MB, 1 GB default
+//==================================================================================================
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <pthread.h>
+#include <string>
+#include <vector>
+#include "jit_isa.h"
+#include "jit_sort.h"
+
+#define VXSORT_MEM_MB   1024
+#define VXSORT_IO       (8 << 20)             // bytes per read/write call
+#define VXSORT_WINDOW   (1 << 20)             // bytes of a run asked ahead during the merge
+#define VXSORT_MAX_RUN  (1 << 30)             // words, vsort takes an int size
+
+typedef struct {
+  int          fd;
+  int         *buf;
+  const int   *src;       // read: mapping of the run
+  int64_t      words;
+  int64_t      off;       // write: byte offset in the file
+  int          err;       // write: -1 when the spill failed
+}vxsort_io_pk_t;
+
+typedef struct {
+  vsort_run_t *run;
+  int          k;
+  int          fd;
+  int64_t      lo, hi;    // output ranks of this slice
+  int          err;
+}vxsort_merge_pk_t;
+
+//==================================================================================================
+ int   vxsort                     (vam_vm_t *VM, const char *in, const char *out, int64_t mem_bytes);
+ int   vxsort_write               (int fd, const void *buf, int64_t bytes, int64_t off);
+void * vxsort_read_Threads_Call   (void *pk);
+void * vxsort_write_Threads_Call  (void *pk);
+void * vxsort_merge_Threads_Call  (void *pk);
+//==================================================================================================
+int vxsort_write(int fd, const void *buf, int64_t bytes, int64_t off)
+{
+  const char *p = (const char *) buf;
+  while (bytes > 0) {
+    ssize_t n = pwrite(fd, p, (size_t)std::min(bytes, (int64_t)VXSORT_IO), off);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return -1;
+    p += n; off += n; bytes -= n;
+  }
+  return 0;
+}
+
+// madvise on the whole pages inside [p, end) for DONTNEED, on the pages touching it otherwise
+static void vxsort_advise(const int *p, const int *end, int advice)
+{
+  uintptr_t a = (uintptr_t)p, b = (uintptr_t)end, page = 4095;
+  if (advice == MADV_DONTNEED) { a = (a + page) & ~page; b &= ~page; }
+  else                         { a &= ~page; }
+  if (a < b) madvise((void*)a, b - a, advice);
+}
+
+// Read ahead: page the next run in from the mapping, then let the pages go.
+void * vxsort_read_Threads_Call(void *pk)
+{
+  vxsort_io_pk_t *p = (vxsort_io_pk_t *) pk;
+  int64_t step = VXSORT_IO / 4, i;
+
+  for (i = 0; i < p->words; i += step) {
+    int64_t n = std::min(step, p->words - i);
+    memcpy(p->buf + i, p->src + i, (size_t)n * 4);
+  }
+  vxsort_advise(p->src, p->src + p->words, MADV_DONTNEED);
+  return NULL;
+}
+
+void * vxsort_write_Threads_Call(void *pk)
+{
+  vxsort_io_pk_t *p = (vxsort_io_pk_t *) pk;
+  p->err = vxsort_write(p->fd, p->buf, p->words * 4, p->off);
+  return NULL;
+}
+//==================================================================================================
+// One output slice: loser tree over the slice of every run, prefetch ahead, pwrite in blocks.
+void * vxsort_merge_Threads_Call(void *pk)
+{
+  vxsort_merge_pk_t *p = (vxsort_merge_pk_t *) pk;
+  const int64_t  win  = VXSORT_WINDOW / 4;
+  int64_t        blk  = VXSORT_IO / 4, fill = 0, i, off = p->lo * 4;
+  int           *out  = new int[blk];
+  vector<const int *> base(p->k), ahead(p->k);   // ahead: end of what was asked for so far
+  vsort_ltree_t  lt;
+  int            j;
+
+  for (j = 0; j < p->k; j++) {
+    base[j]  = p->run[j].p;
+    ahead[j] = std::min(p->run[j].p + win, p->run[j].end);
+    vxsort_advise(base[j], ahead[j], MADV_WILLNEED);
+  }
+  vsort_ltree_init(&lt, p->run, p->k);
+  for (i = p->lo; i < p->hi; i++) {
+    int w = lt.tree[0];
+    out[fill++] = *p->run[w].p++;
+
+    // entered the last window asked for: ask for the next one, drop the ones fully behind
+    if (p->run[w].p >= ahead[w] - win && ahead[w] < p->run[w].end) {
+      const int *next = std::min(ahead[w] + win, p->run[w].end);
+      vxsort_advise(ahead[w], next, MADV_WILLNEED);
+      if (ahead[w] - base[w] > 2 * win)
+        vxsort_advise(base[w] + std::max((int64_t)0, ahead[w] - base[w] - 3 * win), ahead[w] - 2 * win, MADV_DONTNEED);
+      ahead[w] = next;
+    }
+    __builtin_prefetch(p->run[w].p + 16);
+    vsort_ltree_replay(&lt, w);
+
+    if (fill == blk) {
+      if (vxsort_write(p->fd, out, fill * 4, off) < 0) { p->err = -1; break; }
+      off += fill * 4;
+      fill = 0;
+    }
+  }
+  if (fill > 0 && p->err == 0 && vxsort_write(p->fd, out, fill * 4, off) < 0) p->err = -1;
+
+  vsort_ltree_clean(&lt);
+  delete[] out;
+  return NULL;
+}
+//==================================================================================================
+int vxsort(vam_vm_t *VM, const char *in, const char *out, int64_t mem_bytes)
+{
+  struct stat st;
+  const char *env = getenv("JIT_XSORT_MEM_MB");
+  string      spill = string(out) + ".runs";
+  int         ifd, ofd, sfd, k, i, err = 0;
+  int64_t     n, run, nrun;
+
+  if (mem_bytes <= 0) mem_bytes = (int64_t)((env != NULL) ? atoi(env) : VXSORT_MEM_MB) << 20;
+
+  if ((ifd = open(in, O_RDONLY)) < 0 || fstat(ifd, &st) < 0) {
+    perror("[vxsort] input");
+    return -1;
+  }
+  if (st.st_size % 4 != 0) {
+    printf("[ERROR->vxsort] %s: %lld bytes is not a whole number of int32 words\r\n", in, (long long)st.st_size);
+    close(ifd);
+    return -1;
+  }
+  n   = st.st_size / 4;
+  run = std::max((int64_t)1, std::min((int64_t)VXSORT_MAX_RUN, mem_bytes / 3 / 4));
+  nrun = (n + run - 1) / run;
+  #ifdef VERBOSE
+    printf("[DEBUG->vxsort] %s: %lld words, %lld runs of %lld words\r\n", in, (long long)n, (long long)nrun, (long long)run);
+  #endif
+
+  if ((ofd = open(out, O_RDWR | O_CREAT | O_TRUNC, 0644)) < 0) {
+    perror("[vxsort] output");
+    close(ifd);
+    return -1;
+  }
+  if (n == 0) { close(ifd); close(ofd); return 0; }
+
+  const int *A = (const int *) mmap(NULL, (size_t)n * 4, PROT_READ, MAP_SHARED, ifd, 0);
+  if (A == MAP_FAILED) {
+    perror("[vxsort] mmap input");
+    close(ifd); close(ofd);
+    return -1;
+  }
+  madvise((void*)A, (size_t)n * 4, MADV_SEQUENTIAL);
+
+  // a single run is sorted and written straight to the output
+  sfd = (nrun == 1) ? ofd : open(spill.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (sfd < 0) {
+    perror("[vxsort] spill file");
+    munmap((void*)A, (size_t)n * 4); close(ifd); close(ofd);
+    return -1;
+  }
+  //------------------------------------------------------------------------------------------------
+  // Runs: read k+1 || sort k || spill k-1, three buffers in rotation
+  //------------------------------------------------------------------------------------------------
+  int            *buf[3];
+  vxsort_io_pk_t  rd, wr;
+  pthread_t       rt, wt;
+
+  for (i = 0; i < 3; i++) buf[i] = new int[(nrun > i) ? run : 1];
+
+  rd.buf = buf[0]; rd.src = A; rd.words = std::min(run, n);
+  vxsort_read_Threads_Call(&rd);
+  for (k = 0; k < nrun; k++) {
+    int64_t words = std::min(run, n - k * run);
+    int     reading = (k + 1 < nrun), writing = (k > 0);
+
+    if (reading) {
+      rd.buf   = buf[(k + 1) % 3];
+      rd.src   = A + (k + 1) * run;
+      rd.words = std::min(run, n - (k + 1) * run);
+      pthread_create(&rt, NULL, vxsort_read_Threads_Call, (void*) &rd);
+    }
+    if (writing) {
+      wr.fd    = sfd;
+      wr.buf   = buf[(k - 1) % 3];
+      wr.words = run;
+      wr.off   = (k - 1) * run * 4;
+      wr.err   = 0;
+      pthread_create(&wt, NULL, vxsort_write_Threads_Call, (void*) &wr);
+    }
+    if (vsort(VM, buf[k % 3], (int)words, VSORT_HOST) < 0) {
+      printf("[ERROR->vxsort] vsort of run %d failed\r\n", k);
+      err = -1;
+    }
+    #ifdef VERBOSE
+      printf("[DEBUG->vxsort] run %d sorted, %lld words\r\n", k, (long long)words);
+    #endif
+    if (reading) pthread_join(rt, NULL);
+    if (writing) pthread_join(wt, NULL);
+    if (writing && wr.err < 0) { perror("[vxsort] spill"); err = -1; }
+    if (err < 0) break;
+  }
+  if (err == 0 && vxsort_write(sfd, buf[(nrun - 1) % 3], (n - (nrun - 1) * run) * 4, (nrun - 1) * run * 4) < 0) {
+    perror("[vxsort] spill");
+    err = -1;
+  }
+  for (i = 0; i < 3; i++) delete[] buf[i];
+  munmap((void*)A, (size_t)n * 4);
+  close(ifd);
+
+  if (nrun == 1) {
+    close(ofd);
+    return err;
+  }
+  if (err < 0) {
+    close(sfd); close(ofd);
+    unlink(spill.c_str());
+    return -1;
+  }
+  //------------------------------------------------------------------------------------------------
+  // Merge: one loser tree per output slice over the mapped spill file
+  //------------------------------------------------------------------------------------------------
+  const int *S = (const int *) mmap(NULL, (size_t)n * 4, PROT_READ, MAP_SHARED, sfd, 0);
+  if (S == MAP_FAILED) {
+    perror("[vxsort] mmap runs");
+    close(sfd); close(ofd);
+    unlink(spill.c_str());
+    return -1;
+  }
+  if (ftruncate(ofd, n * 4) < 0) {
+    perror("[vxsort] output size");
+    munmap((void*)S, (size_t)n * 4);
+    close(sfd); close(ofd);
+    unlink(spill.c_str());
+    return -1;
+  }
+
+  int threads = vcpu_threads();
+  if (n < VCPU_MT_MIN) threads = 1;
+  vector<vsort_run_t>       runs(nrun);
+  vector<int64_t>           pos((threads + 1) * nrun);
+  vector<vsort_run_t>       sub(threads * nrun);
+  vector<vxsort_merge_pk_t> pk(threads);
+  vector<pthread_t>         thread(threads);
+
+  for (k = 0; k < nrun; k++) {
+    runs[k].p   = S + k * run;
+    runs[k].end = S + std::min(n, (k + 1) * run);
+  }
+  for (i = 0; i <= threads; i++)
+    vsort_split(runs.data(), nrun, n * i / threads, &pos[i * nrun]);
+  for (i = 0; i < threads; i++) {
+    for (k = 0; k < nrun; k++) {
+      sub[i * nrun + k].p   = runs[k].p + pos[i * nrun + k];
+      sub[i * nrun + k].end = runs[k].p + pos[(i + 1) * nrun + k];
+    }
+    pk[i].run = &sub[i * nrun];
+    pk[i].k   = nrun;
+    pk[i].fd  = ofd;
+    pk[i].lo  = n * i / threads;
+    pk[i].hi  = n * (i + 1) / threads;
+    pk[i].err = 0;
+    pthread_create(&thread[i], NULL, vxsort_merge_Threads_Call, (void*) &pk[i]);
+  }
+  for (i = 0; i < threads; i++) {
+    pthread_join(thread[i], NULL);
+    err |= pk[i].err;
+  }
+  if (err < 0) perror("[vxsort] output");
+
+  munmap((void*)S, (size_t)n * 4);
+  close(sfd);
+  unlink(spill.c_str());
+  close(ofd);
+  return err;
+}
+
+#endif